@@ -0,0 +1,618 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/Include.h"
+#include "Misc/Platform.h"
+#include "Memory/Allocator.h"
+#include "Memory/PoolAllocator.h"
+#include "Memory/ListAllocator.h"
+#include "Memory/StackAllocator.h"
+#include "Memory/LinearAllocator.h"
+#include "Memory/ProxyAllocator.h"
+#include "Memory/ConcurrentPoolAllocator.h"
+
+#if !PLATFORM_WINDOWS
+    #include <unistd.h>
+    #include <sys/resource.h>
+#endif
+
+/**
+ * Allocators benchmark
+ *
+ * Measures engine allocators against system malloc on synthetic patterns
+ * (LIFO, FIFO, random sizes, producer / consumer across threads) and on
+ * allocation traces, recorded by ProxyAllocator::setTraceFile().
+ * Prints one result per line (JSON or CSV) with ns/op, throughput and RSS.
+ *
+ * Usage: BerserkAllocatorBenchmark [--csv] [--operations N] [--iterations N]
+ *                                  [--size N] [--min N] [--max N]
+ *                                  [--allocator name] [--pattern name]
+ *                                  [--trace file] [--record file]
+ */
+
+using namespace Berserk;
+
+/** System heap as engine allocator (baseline) */
+class MallocAllocator final : public IAllocator
+{
+public:
+
+    void* allocate(uint32 size) override { return ::malloc(size); }
+
+    void free(void* pointer) override { ::free(pointer); }
+
+};
+
+enum class Pattern
+{
+    LIFO,
+    FIFO,
+    Random,
+    ProducerConsumer,
+    Trace
+};
+
+struct Config
+{
+    uint32 operations = 200000;     // Allocate and free calls in one run
+    uint32 iterations = 5;          // Runs of each benchmark (median is reported)
+    uint32 blocks = 1024;           // Live blocks in LIFO / FIFO rounds and slots in random pattern
+    uint32 size = 64;               // Block size of fixed size patterns
+    uint32 minSize = 16;            // Min size of random pattern
+    uint32 maxSize = 1024;          // Max size of random pattern
+    const char* allocator = nullptr;
+    const char* pattern = nullptr;
+    const char* trace = nullptr;
+    const char* record = nullptr;
+    bool csv = false;
+};
+
+struct TraceOp
+{
+    uint32 slot;                    // Index of live block
+    uint32 size;                    // Size to allocate [or 0 for free]
+};
+
+/** Allocators with GEN_NEW_DELETE are constructed in place */
+template <typename T, typename ... TArgs>
+static IAllocator* create(TArgs ... args)
+{
+    return new (::malloc(sizeof(T))) T(args...);
+}
+
+static void destroy(IAllocator* allocator)
+{
+    allocator->~IAllocator();
+    ::free(allocator);
+}
+
+struct Trace
+{
+    std::vector<TraceOp> ops;
+    uint32 slots = 0;               // Max number of live blocks
+    uint32 maxSize = 0;             // Max allocation size
+    uint64 totalSize = 0;           // Sum of all allocations
+};
+
+/** Benchmark subject: creates fresh allocator for each run */
+struct Subject
+{
+    const char* name;
+    bool threadSafe;
+    IAllocator* (*create)(Pattern pattern, const Config& config, const Trace& trace);
+    void (*reset)(IAllocator* allocator);
+};
+
+static const char* getPatternName(Pattern pattern)
+{
+    switch (pattern)
+    {
+        case Pattern::LIFO:             return "lifo";
+        case Pattern::FIFO:             return "fifo";
+        case Pattern::Random:           return "random";
+        case Pattern::ProducerConsumer: return "producer-consumer";
+        case Pattern::Trace:            return "trace";
+    }
+
+    return "unknown";
+}
+
+/** @return Max allocation size of pattern */
+static uint32 getMaxSize(Pattern pattern, const Config& config, const Trace& trace)
+{
+    if (pattern == Pattern::Random) return config.maxSize;
+    if (pattern == Pattern::Trace) return trace.maxSize;
+    return config.size;
+}
+
+/** @return Upper bound of allocated bytes in one run (for allocators which do not reuse memory) */
+static uint64 getTotalSize(Pattern pattern, const Config& config, const Trace& trace)
+{
+    const uint64 overhead = Buffers::SIZE_32;
+
+    if (pattern == Pattern::Random) return (uint64)config.operations * (config.maxSize + overhead);
+    if (pattern == Pattern::Trace) return trace.totalSize + trace.ops.size() * overhead;
+    return (uint64)config.blocks * (config.size + overhead);
+}
+
+static const Subject SUBJECTS[] =
+{
+    {
+        "malloc", true,
+        [](Pattern, const Config&, const Trace&) -> IAllocator* { return create<MallocAllocator>(); },
+        nullptr
+    },
+    {
+        "Allocator", true,
+        [](Pattern, const Config&, const Trace&) -> IAllocator* { return &Allocator::getSingleton(); },
+        nullptr
+    },
+    {
+        "PoolAllocator", false,
+        [](Pattern pattern, const Config& config, const Trace& trace) -> IAllocator*
+        {
+            if (pattern == Pattern::ProducerConsumer) return nullptr;
+            auto chunkSize = std::max(getMaxSize(pattern, config, trace), (uint32)PoolAllocator::MIN_CHUNK_SIZE);
+            return create<PoolAllocator>(chunkSize, (uint32)PoolAllocator::INITIAL_CHUNK_COUNT);
+        },
+        nullptr
+    },
+    {
+        "ConcurrentPoolAllocator", true,
+        [](Pattern pattern, const Config& config, const Trace& trace) -> IAllocator*
+        {
+            auto chunkSize = std::max(getMaxSize(pattern, config, trace), (uint32)PoolAllocator::MIN_CHUNK_SIZE);
+            return create<ConcurrentPoolAllocator>(chunkSize, (uint32)PoolAllocator::INITIAL_CHUNK_COUNT);
+        },
+        nullptr
+    },
+    {
+        "ListAllocator", false,
+        [](Pattern pattern, const Config& config, const Trace& trace) -> IAllocator*
+        {
+            if (pattern == Pattern::ProducerConsumer) return nullptr;
+            auto bufferSize = std::max(getMaxSize(pattern, config, trace) * 4, (uint32)Buffers::MiB);
+            return create<ListAllocator>(bufferSize);
+        },
+        nullptr
+    },
+    {
+        "LinearAllocator", false,
+        [](Pattern pattern, const Config& config, const Trace& trace) -> IAllocator*
+        {
+            if (pattern == Pattern::ProducerConsumer) return nullptr;
+            auto size = getTotalSize(pattern, config, trace);
+            if (size > 0xffffffffu) return nullptr;
+            return create<LinearAllocator>(std::max((uint32)size, (uint32)LinearAllocator::MIN_BUFFER_SIZE));
+        },
+        [](IAllocator* allocator) { ((LinearAllocator*)allocator)->clear(); }
+    },
+    {
+        "StackAllocator", false,
+        [](Pattern pattern, const Config& config, const Trace& trace) -> IAllocator*
+        {
+            if (pattern != Pattern::LIFO) return nullptr;
+            return create<StackAllocator>((uint32)getTotalSize(pattern, config, trace));
+        },
+        nullptr
+    },
+    {
+        "ProxyAllocator", false,
+        [](Pattern pattern, const Config&, const Trace&) -> IAllocator*
+        {
+            if (pattern == Pattern::ProducerConsumer) return nullptr;
+            return create<ProxyAllocator>((IAllocator*)&Allocator::getSingleton());
+        },
+        nullptr
+    }
+};
+
+/** Allocates blocks and frees them in reverse (LIFO) or the same (FIFO) order */
+static uint64 runRounds(const Subject& subject, IAllocator& allocator, const Config& config, bool lifo)
+{
+    std::vector<void*> blocks(config.blocks);
+    uint32 rounds = std::max(1u, config.operations / (2 * config.blocks));
+
+    for (uint32 round = 0; round < rounds; round++)
+    {
+        for (uint32 i = 0; i < config.blocks; i++)
+        {
+            blocks[i] = allocator.allocate(config.size);
+            *(uint8*)blocks[i] = (uint8)i;
+        }
+
+        if (lifo)
+        {
+            for (uint32 i = config.blocks; i > 0; i--) allocator.free(blocks[i - 1]);
+        }
+        else
+        {
+            for (uint32 i = 0; i < config.blocks; i++) allocator.free(blocks[i]);
+        }
+
+        if (subject.reset) subject.reset(&allocator);
+    }
+
+    return (uint64)rounds * config.blocks * 2;
+}
+
+/** Allocates and frees blocks of pseudo random sizes in random slots */
+static uint64 runRandom(IAllocator& allocator, const Config& config)
+{
+    std::vector<void*> slots(config.blocks, nullptr);
+    uint32 seed = 0x9e3779b9;
+
+    for (uint32 i = 0; i < config.operations; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        uint32 slot = (seed >> 8) % config.blocks;
+
+        if (slots[slot])
+        {
+            allocator.free(slots[slot]);
+            slots[slot] = nullptr;
+        }
+        else
+        {
+            seed = seed * 1664525 + 1013904223;
+            uint32 size = config.minSize + (seed >> 8) % (config.maxSize - config.minSize + 1);
+            slots[slot] = allocator.allocate(size);
+            *(uint8*)slots[slot] = (uint8)i;
+        }
+    }
+
+    uint64 operations = config.operations;
+
+    for (auto block : slots)
+    {
+        if (block)
+        {
+            allocator.free(block);
+            operations += 1;
+        }
+    }
+
+    return operations;
+}
+
+/** Producer thread allocates blocks, consumer thread frees them (memory crosses threads) */
+static uint64 runProducerConsumer(IAllocator& allocator, const Config& config)
+{
+    const uint32 BATCH = Buffers::SIZE_64;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::vector<void*>> queue;
+    bool done = false;
+
+    uint32 count = config.operations / 2;
+
+    std::thread consumer([&]()
+    {
+        std::vector<void*> batch;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&]() { return !queue.empty() || done; });
+
+                if (queue.empty()) return;
+
+                batch.swap(queue.back());
+                queue.pop_back();
+            }
+
+            condition.notify_one();
+
+            for (auto block : batch) allocator.free(block);
+            batch.clear();
+        }
+    });
+
+    std::vector<void*> batch;
+    batch.reserve(BATCH);
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        auto block = allocator.allocate(config.size);
+        *(uint8*)block = (uint8)i;
+        batch.push_back(block);
+
+        if (batch.size() == BATCH || i + 1 == count)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            // Bounded queue: producer does not run far ahead of consumer
+            condition.wait(lock, [&]() { return queue.size() < 16; });
+
+            queue.emplace_back();
+            queue.back().swap(batch);
+            batch.reserve(BATCH);
+
+            condition.notify_one();
+        }
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done = true;
+    }
+
+    condition.notify_all();
+    consumer.join();
+
+    return (uint64)count * 2;
+}
+
+/** Replays recorded trace */
+static uint64 runTrace(IAllocator& allocator, const Trace& trace)
+{
+    std::vector<void*> slots(trace.slots, nullptr);
+
+    for (auto& op : trace.ops)
+    {
+        if (op.size)
+        {
+            slots[op.slot] = allocator.allocate(op.size);
+            *(uint8*)slots[op.slot] = 0;
+        }
+        else
+        {
+            allocator.free(slots[op.slot]);
+            slots[op.slot] = nullptr;
+        }
+    }
+
+    uint64 operations = trace.ops.size();
+
+    for (auto block : slots)
+    {
+        if (block)
+        {
+            allocator.free(block);
+            operations += 1;
+        }
+    }
+
+    return operations;
+}
+
+/** Loads trace, recorded by ProxyAllocator, and maps pointers on slots */
+static bool loadTrace(const char* filename, Trace& trace)
+{
+    FILE* file = fopen(filename, "r");
+    if (file == nullptr) return false;
+
+    std::unordered_map<uint64, uint32> live;
+    std::vector<uint32> freeSlots;
+
+    char type;
+    uint64 pointer;
+    uint32 size;
+
+    while (fscanf(file, " %c %lx", &type, &pointer) == 2)
+    {
+        if (type == 'a')
+        {
+            if (fscanf(file, " %u", &size) != 1) break;
+
+            uint32 slot;
+            if (!freeSlots.empty()) { slot = freeSlots.back(); freeSlots.pop_back(); }
+            else slot = trace.slots++;
+
+            live[pointer] = slot;
+            trace.ops.push_back({ slot, std::max(size, 1u) });
+            trace.maxSize = std::max(trace.maxSize, size);
+            trace.totalSize += size;
+        }
+        else if (type == 'f')
+        {
+            // Frees of blocks, allocated before recording start, are skipped
+
+            auto found = live.find(pointer);
+            if (found == live.end()) continue;
+
+            trace.ops.push_back({ found->second, 0 });
+            freeSlots.push_back(found->second);
+            live.erase(found);
+        }
+    }
+
+    fclose(file);
+    return !trace.ops.empty();
+}
+
+/** Records trace of random pattern through ProxyAllocator (example of engine trace) */
+static void recordTrace(const char* filename, const Config& config)
+{
+    FILE* file = fopen(filename, "w");
+    if (file == nullptr) return;
+
+    ProxyAllocator proxy(&Allocator::getSingleton());
+    proxy.setTraceFile(file);
+    runRandom(proxy, config);
+    proxy.setTraceFile(nullptr);
+
+    fclose(file);
+}
+
+/** @return Resident set size of process [in KiB] */
+static uint64 getResidentSize()
+{
+#if PLATFORM_WINDOWS
+    return 0;
+#else
+    uint64 pages = 0, resident = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+
+    if (file)
+    {
+        if (fscanf(file, "%lu %lu", &pages, &resident) != 2) resident = 0;
+        fclose(file);
+        return resident * (uint64)sysconf(_SC_PAGESIZE) / Buffers::KiB;
+    }
+
+    return 0;
+#endif
+}
+
+/** @return Peak resident set size of process [in KiB] */
+static uint64 getPeakResidentSize()
+{
+#if PLATFORM_WINDOWS
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    // Units of ru_maxrss differ: bytes on macOS, kilobytes on Linux
+    #if defined(__APPLE__)
+        return (uint64)usage.ru_maxrss / Buffers::KiB;
+    #else
+        return (uint64)usage.ru_maxrss;
+    #endif
+#endif
+}
+
+static void runBenchmark(const Subject& subject, Pattern pattern, const Config& config, const Trace& trace)
+{
+    if (pattern == Pattern::ProducerConsumer && !subject.threadSafe) return;
+
+    std::vector<double> times;
+    uint64 operations = 0;
+
+    for (uint32 iteration = 0; iteration < config.iterations; iteration++)
+    {
+        auto allocator = subject.create(pattern, config, trace);
+        if (allocator == nullptr) return;
+
+        auto start = std::chrono::steady_clock::now();
+
+        switch (pattern)
+        {
+            case Pattern::LIFO:             operations = runRounds(subject, *allocator, config, true);  break;
+            case Pattern::FIFO:             operations = runRounds(subject, *allocator, config, false); break;
+            case Pattern::Random:           operations = runRandom(*allocator, config);                 break;
+            case Pattern::ProducerConsumer: operations = runProducerConsumer(*allocator, config);       break;
+            case Pattern::Trace:            operations = runTrace(*allocator, trace);                   break;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(end - start).count());
+
+        if (allocator != &Allocator::getSingleton()) destroy(allocator);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    double median = times[times.size() / 2];
+    double best = times.front();
+    double nsPerOp = median * 1e9 / operations;
+    double nsPerOpMin = best * 1e9 / operations;
+    double mopsPerSec = operations / median / 1e6;
+
+    if (config.csv)
+    {
+        printf("%s,%s,%lu,%.3f,%.3f,%.3f,%lu,%lu\n",
+               subject.name, getPatternName(pattern), operations, nsPerOp, nsPerOpMin, mopsPerSec,
+               getResidentSize(), getPeakResidentSize());
+    }
+    else
+    {
+        printf("{\"allocator\": \"%s\", \"pattern\": \"%s\", \"operations\": %lu, \"ns_per_op\": %.3f, "
+               "\"ns_per_op_min\": %.3f, \"mops_per_sec\": %.3f, \"rss_kib\": %lu, \"peak_rss_kib\": %lu}\n",
+               subject.name, getPatternName(pattern), operations, nsPerOp, nsPerOpMin, mopsPerSec,
+               getResidentSize(), getPeakResidentSize());
+    }
+
+    fflush(stdout);
+}
+
+static bool parseArguments(int argc, char** argv, Config& config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc ? argv[i + 1] : nullptr);
+
+        if (strcmp(arg, "--csv") == 0) { config.csv = true; continue; }
+        if (value == nullptr) return false;
+
+        if      (strcmp(arg, "--operations") == 0) config.operations = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--iterations") == 0) config.iterations = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--blocks") == 0)     config.blocks = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--size") == 0)       config.size = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--min") == 0)        config.minSize = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--max") == 0)        config.maxSize = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--allocator") == 0)  config.allocator = value;
+        else if (strcmp(arg, "--pattern") == 0)    config.pattern = value;
+        else if (strcmp(arg, "--trace") == 0)      config.trace = value;
+        else if (strcmp(arg, "--record") == 0)     config.record = value;
+        else return false;
+
+        i += 1;
+    }
+
+    return config.operations > 0 && config.iterations > 0 && config.blocks > 0 &&
+           config.size > 0 && config.minSize > 0 && config.minSize <= config.maxSize;
+}
+
+int main(int argc, char** argv)
+{
+    Config config;
+
+    if (!parseArguments(argc, argv, config))
+    {
+        fprintf(stderr, "Usage: %s [--csv] [--operations N] [--iterations N] [--blocks N] [--size N] [--min N] [--max N]\n"
+                        "          [--allocator name] [--pattern lifo|fifo|random|producer-consumer|trace]\n"
+                        "          [--trace file] [--record file]\n", argv[0]);
+        return 1;
+    }
+
+    if (config.record)
+    {
+        recordTrace(config.record, config);
+        return 0;
+    }
+
+    Trace trace;
+
+    if (config.trace && !loadTrace(config.trace, trace))
+    {
+        fprintf(stderr, "Cannot load trace '%s'\n", config.trace);
+        return 1;
+    }
+
+    if (config.csv)
+    {
+        printf("allocator,pattern,operations,ns_per_op,ns_per_op_min,mops_per_sec,rss_kib,peak_rss_kib\n");
+    }
+
+    const Pattern patterns[] = { Pattern::LIFO, Pattern::FIFO, Pattern::Random, Pattern::ProducerConsumer, Pattern::Trace };
+
+    for (auto pattern : patterns)
+    {
+        if (pattern == Pattern::Trace && config.trace == nullptr) continue;
+        if (config.pattern && strcmp(config.pattern, getPatternName(pattern)) != 0) continue;
+
+        for (auto& subject : SUBJECTS)
+        {
+            if (config.allocator && strcmp(config.allocator, subject.name) != 0) continue;
+            runBenchmark(subject, pattern, config, trace);
+        }
+    }
+
+    return 0;
+}
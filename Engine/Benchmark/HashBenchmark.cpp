@@ -0,0 +1,287 @@
+//
+// Created by Egor Orachyov on 01.03.2019.
+//
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "Misc/Hash.h"
+#include "Misc/Crc32.h"
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/Include.h"
+#include "Strings/StaticString.h"
+#include "Containers/OpenHashMap.h"
+
+/**
+ * Hashing benchmark
+ *
+ * Measures fast hashers (Hash, HashTraits) against Crc32 on raw bytes of
+ * different lengths, on integer ids and on lookups in OpenHashMap
+ * with names and ids as keys. Bytes are also hashed with byte-wise
+ * table CRC-32 (previous engine version), CRC-32C in software and
+ * hardware (if supported). Prints one result per line (JSON or CSV)
+ * with ns per hash (or lookup) and throughput.
+ *
+ * Usage: BerserkHashBenchmark [--csv] [--operations N] [--iterations N]
+ *                             [--hasher name] [--input name]
+ */
+
+using namespace Berserk;
+
+struct Config
+{
+    uint32 operations = 1000000;    // Hashes (or lookups) in one run
+    uint32 iterations = 5;          // Runs of each benchmark (median is reported)
+    const char* hasher = nullptr;
+    const char* input = nullptr;
+    bool csv = false;
+};
+
+/** Prevents elimination of hashing results */
+static volatile uint64 SINK = 0;
+
+/** Lengths of hashed byte buffers */
+static const uint32 LENGTHS[] = { 4, 8, 16, 32, 64, 256, 1024, 4096 };
+
+/** Max number of keys in maps */
+static const uint32 KEYS_COUNT = 4096;
+
+/** Byte-wise table CRC-32 (baseline of sliced version) */
+static uint32 crc32Bytewise(const char* buffer, uint32 len)
+{
+    static uint32 table[256];
+
+    if (table[1] == 0)
+    {
+        for (uint32 i = 0; i < 256; i++)
+        {
+            uint32 crc = i;
+            for (uint32 j = 0; j < 8; j++) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+            table[i] = crc;
+        }
+    }
+
+    uint32 crc = 0xFFFFFFFF;
+    while (len--) crc = (crc >> 8) ^ table[(crc ^ (uint8)*buffer++) & 0xFF];
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+/** @return Pseudo random byte buffer */
+static std::vector<uint8> createBuffer(uint32 size)
+{
+    std::vector<uint8> buffer(size);
+    uint32 seed = 0x9e3779b9;
+
+    for (auto& byte : buffer)
+    {
+        seed = seed * 1664525 + 1013904223;
+        byte = (uint8)(seed >> 24);
+    }
+
+    return buffer;
+}
+
+static void printResult(const Config& config, const char* hasher, const char* input, uint32 bytes, uint64 operations,
+                        const std::vector<double>& times)
+{
+    double median = times[times.size() / 2];
+    double best = times.front();
+    double nsPerOp = median * 1e9 / operations;
+    double nsPerOpMin = best * 1e9 / operations;
+    double gibPerSec = (double)bytes * operations / median / (double)Buffers::GiB;
+
+    if (config.csv)
+    {
+        printf("%s,%s,%u,%lu,%.3f,%.3f,%.3f\n", hasher, input, bytes, operations, nsPerOp, nsPerOpMin, gibPerSec);
+    }
+    else
+    {
+        printf("{\"hasher\": \"%s\", \"input\": \"%s\", \"bytes\": %u, \"operations\": %lu, \"ns_per_op\": %.3f, "
+               "\"ns_per_op_min\": %.3f, \"gib_per_sec\": %.3f}\n",
+               hasher, input, bytes, operations, nsPerOp, nsPerOpMin, gibPerSec);
+    }
+
+    fflush(stdout);
+}
+
+/** Runs function iterations times and prints median time per operation */
+template <typename Function>
+static void measure(const Config& config, const char* hasher, const char* input, uint32 bytes, uint64 operations,
+                    Function function)
+{
+    if (config.hasher && strcmp(config.hasher, hasher) != 0) return;
+    if (config.input && strcmp(config.input, input) != 0) return;
+
+    std::vector<double> times;
+
+    for (uint32 iteration = 0; iteration < config.iterations; iteration++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        SINK += function();
+        auto end = std::chrono::steady_clock::now();
+
+        times.push_back(std::chrono::duration<double>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+    printResult(config, hasher, input, bytes, operations, times);
+}
+
+/** Hashing of byte buffers (each hash depends on previous one: latency, not only throughput) */
+static void runBytes(const Config& config)
+{
+    auto buffer = createBuffer(LENGTHS[sizeof(LENGTHS) / sizeof(LENGTHS[0]) - 1] + sizeof(uint32));
+
+    for (auto length : LENGTHS)
+    {
+        // Long buffers are hashed fewer times to keep runs short
+
+        uint64 operations = std::max(1000u, (uint32)((uint64)config.operations * 16 / length));
+        auto data = (char*) buffer.data();
+
+        measure(config, "crc32-bytewise", "bytes", length, operations, [&]()
+        {
+            uint32 h = 0;
+            for (uint64 i = 0; i < operations; i++) h ^= crc32Bytewise(data + (h & 3), length);
+            return (uint64)h;
+        });
+
+        measure(config, "crc32", "bytes", length, operations, [&]()
+        {
+            uint32 h = 0;
+            for (uint64 i = 0; i < operations; i++) h ^= Crc32::hash(data + (h & 3), length);
+            return (uint64)h;
+        });
+
+        measure(config, "crc32c-software", "bytes", length, operations, [&]()
+        {
+            uint32 h = 0;
+            for (uint64 i = 0; i < operations; i++) h ^= Crc32::hashCastagnoliSoftware(data + (h & 3), length);
+            return (uint64)h;
+        });
+
+        if (Crc32::isHardwareCastagnoli())
+        {
+            measure(config, "crc32c-hardware", "bytes", length, operations, [&]()
+            {
+                uint32 h = 0;
+                for (uint64 i = 0; i < operations; i++) h ^= Crc32::hashCastagnoli(data + (h & 3), length);
+                return (uint64)h;
+            });
+        }
+
+        measure(config, "hash", "bytes", length, operations, [&]()
+        {
+            uint32 h = 0;
+            for (uint64 i = 0; i < operations; i++) h ^= Hash::hash(data + (h & 3), length);
+            return (uint64)h;
+        });
+    }
+}
+
+/** Hashing of sequential integer ids */
+static void runIds(const Config& config)
+{
+    uint64 operations = config.operations;
+
+    measure(config, "crc32", "ids", sizeof(uint32), operations, [&]()
+    {
+        uint32 h = 0;
+        for (uint32 i = 0; i < operations; i++) h += Crc32::hash((int32)i);
+        return (uint64)h;
+    });
+
+    measure(config, "hash", "ids", sizeof(uint32), operations, [&]()
+    {
+        uint32 h = 0;
+        for (uint32 i = 0; i < operations; i++) h += HashTraits<uint32>::hash(i);
+        return (uint64)h;
+    });
+}
+
+/** Lookups of existing keys in map */
+template <typename K>
+static void runLookups(const Config& config, const char* hasher, const char* input, Crc32::Hashing hashing,
+                       const std::vector<K>& keys)
+{
+    OpenHashMap<K, uint32> map(hashing, KEYS_COUNT * 2);
+    for (uint32 i = 0; i < keys.size(); i++) map.add(keys[i], i);
+
+    uint64 operations = config.operations;
+
+    measure(config, hasher, input, sizeof(K), operations, [&]()
+    {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < operations; i++) sum += *map[keys[(i * 2654435761u) % keys.size()]];
+        return sum;
+    });
+}
+
+static void runMaps(const Config& config)
+{
+    std::vector<CName> names;
+    std::vector<uint32> ids;
+
+    char name[Buffers::SIZE_64];
+
+    for (uint32 i = 0; i < KEYS_COUNT; i++)
+    {
+        sprintf(name, "Material%u/Texture%u", i / 8, i % 8);
+        names.emplace_back(name);
+        ids.push_back(i * 64);
+    }
+
+    runLookups<CName>(config, "crc32", "map-names", CName::Hashing, names);
+    runLookups<CName>(config, "hash", "map-names", HashTraits<CName>::hashing, names);
+
+    runLookups<uint32>(config, "crc32", "map-ids", [](const void* key) { return Crc32::hash(*(const int32*)key); }, ids);
+    runLookups<uint32>(config, "hash", "map-ids", HashTraits<uint32>::hashing, ids);
+}
+
+static bool parseArguments(int argc, char** argv, Config& config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc ? argv[i + 1] : nullptr);
+
+        if (strcmp(arg, "--csv") == 0) { config.csv = true; continue; }
+        if (value == nullptr) return false;
+
+        if      (strcmp(arg, "--operations") == 0) config.operations = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--iterations") == 0) config.iterations = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--hasher") == 0)     config.hasher = value;
+        else if (strcmp(arg, "--input") == 0)      config.input = value;
+        else return false;
+
+        i += 1;
+    }
+
+    return config.operations > 0 && config.iterations > 0;
+}
+
+int main(int argc, char** argv)
+{
+    Config config;
+
+    if (!parseArguments(argc, argv, config))
+    {
+        fprintf(stderr, "Usage: %s [--csv] [--operations N] [--iterations N] [--hasher name]\n"
+                        "          [--input bytes|ids|map-names|map-ids]\n", argv[0]);
+        return 1;
+    }
+
+    if (config.csv)
+    {
+        printf("hasher,input,bytes,operations,ns_per_op,ns_per_op_min,gib_per_sec\n");
+    }
+
+    runBytes(config);
+    runIds(config);
+    runMaps(config);
+
+    return 0;
+}
@@ -0,0 +1,249 @@
+//
+// Created by Egor Orachyov on 05.03.2019.
+//
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "Misc/Types.h"
+#include "Misc/Include.h"
+#include "Logging/LogManager.h"
+#include "Threading/MPMCQueue.h"
+#include "Threading/ConcurrentLinkedQueue.h"
+
+/**
+ * Concurrent queues benchmark
+ *
+ * Measures throughput of mutex based ConcurrentLinkedQueue and lock-free
+ * MPMCQueue (single and batched operations) under contention: for each
+ * pair of producers and consumers counts in [1..threads] producers push
+ * all the operations, consumers pop them until all are consumed. Checks
+ * that the sum of popped values is equal to the sum of pushed ones.
+ * Prints one result per line (JSON or CSV) with ns per element.
+ *
+ * Usage: BerserkQueueBenchmark [--csv] [--operations N] [--iterations N]
+ *                              [--threads N] [--queue name]
+ */
+
+using namespace Berserk;
+
+struct Config
+{
+    uint32 operations = 1000000;    // Elements pushed (and popped) in one run
+    uint32 iterations = 5;          // Runs of each benchmark (median is reported)
+    uint32 threads = 4;             // Max number of producers (and consumers)
+    const char* queue = nullptr;
+    bool csv = false;
+};
+
+/** Capacity of bounded queues */
+static const uint32 QUEUE_CAPACITY = 4096;
+
+/** Number of elements in one batch */
+static const uint32 BATCH_SIZE = 16;
+
+/** Adapter for mutex based queue */
+struct LinkedQueue
+{
+    static const char* name() { return "linked-mutex"; }
+
+    bool push(uint64 value) { queue.push(value); return true; }
+
+    bool pop(uint64& value) { bool notEmpty; queue.pop(&value, &notEmpty); return notEmpty; }
+
+    uint32 pushBatch(const uint64* values, uint32 count) { for (uint32 i = 0; i < count; i++) queue.push(values[i]); return count; }
+
+    uint32 popBatch(uint64* values, uint32 count) { return (count > 0 && pop(values[0])) ? 1 : 0; }
+
+    ConcurrentLinkedQueue<uint64> queue;
+};
+
+/** Adapter for lock-free queue (single operations) */
+struct RingQueue
+{
+    static const char* name() { return "mpmc"; }
+
+    RingQueue() : queue(QUEUE_CAPACITY) { }
+
+    bool push(uint64 value) { return queue.tryPush(value); }
+
+    bool pop(uint64& value) { return queue.tryPop(value); }
+
+    uint32 pushBatch(const uint64* values, uint32 count) { return (count > 0 && push(values[0])) ? 1 : 0; }
+
+    uint32 popBatch(uint64* values, uint32 count) { return (count > 0 && pop(values[0])) ? 1 : 0; }
+
+    MPMCQueue<uint64> queue;
+};
+
+/** Adapter for lock-free queue (batched operations) */
+struct RingBatchQueue : public RingQueue
+{
+    static const char* name() { return "mpmc-batch"; }
+
+    uint32 pushBatch(const uint64* values, uint32 count) { return queue.tryPushBatch(values, count); }
+
+    uint32 popBatch(uint64* values, uint32 count) { return queue.tryPopBatch(values, count); }
+};
+
+/** Runs producers and consumers once @return Time of run in seconds (or negative if results are invalid) */
+template <typename Queue>
+static double run(uint32 operations, uint32 producers, uint32 consumers)
+{
+    Queue queue;
+
+    std::atomic<uint32> started(0);
+    std::atomic<uint64> popped(0);
+    std::atomic<uint64> sum(0);
+    std::vector<std::thread> threads;
+
+    uint32 total = producers + consumers;
+
+    for (uint32 p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+        {
+            uint64 begin = (uint64) operations * p / producers;
+            uint64 end = (uint64) operations * (p + 1) / producers;
+            uint64 values[BATCH_SIZE];
+
+            started.fetch_add(1);
+            while (started.load() < total) { }
+
+            for (uint64 i = begin; i < end; )
+            {
+                uint32 count = (uint32) std::min<uint64>(BATCH_SIZE, end - i);
+                for (uint32 j = 0; j < count; j++) values[j] = i + j + 1;
+
+                uint32 pushed = queue.pushBatch(values, count);
+                if (pushed == 0) std::this_thread::yield();
+                i += pushed;
+            }
+        });
+    }
+
+    for (uint32 c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&]()
+        {
+            uint64 values[BATCH_SIZE];
+            uint64 local = 0;
+
+            started.fetch_add(1);
+            while (started.load() < total) { }
+
+            while (popped.load(std::memory_order_relaxed) < operations)
+            {
+                uint32 count = queue.popBatch(values, BATCH_SIZE);
+                if (count == 0) { std::this_thread::yield(); continue; }
+
+                for (uint32 j = 0; j < count; j++) local += values[j];
+                popped.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            sum.fetch_add(local);
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& thread : threads) thread.join();
+    auto end = std::chrono::steady_clock::now();
+
+    uint64 expected = (uint64) operations * (operations + 1) / 2;
+    if (sum.load() != expected || popped.load() != operations) return -1.0;
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+template <typename Queue>
+static void measure(const Config& config, uint32 producers, uint32 consumers)
+{
+    if (config.queue && strcmp(config.queue, Queue::name()) != 0) return;
+
+    std::vector<double> times;
+    bool valid = true;
+
+    for (uint32 iteration = 0; iteration < config.iterations; iteration++)
+    {
+        double time = run<Queue>(config.operations, producers, consumers);
+        valid = valid && (time >= 0.0);
+        times.push_back(time);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    double median = times[times.size() / 2];
+    double nsPerOp = median * 1e9 / config.operations;
+    double mopsPerSec = config.operations / median / 1e6;
+
+    if (config.csv)
+    {
+        printf("%s,%u,%u,%u,%.3f,%.3f,%i\n", Queue::name(), producers, consumers, config.operations,
+               nsPerOp, mopsPerSec, valid);
+    }
+    else
+    {
+        printf("{\"queue\": \"%s\", \"producers\": %u, \"consumers\": %u, \"operations\": %u, "
+               "\"ns_per_op\": %.3f, \"mops_per_sec\": %.3f, \"valid\": %s}\n",
+               Queue::name(), producers, consumers, config.operations, nsPerOp, mopsPerSec, (valid ? "true" : "false"));
+    }
+
+    fflush(stdout);
+}
+
+static bool parseArguments(int argc, char** argv, Config& config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc ? argv[i + 1] : nullptr);
+
+        if (strcmp(arg, "--csv") == 0) { config.csv = true; continue; }
+        if (value == nullptr) return false;
+
+        if      (strcmp(arg, "--operations") == 0) config.operations = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--iterations") == 0) config.iterations = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--threads") == 0)    config.threads = (uint32) strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--queue") == 0)      config.queue = value;
+        else return false;
+
+        i += 1;
+    }
+
+    return config.operations > 0 && config.iterations > 0 && config.threads > 0;
+}
+
+int main(int argc, char** argv)
+{
+    Config config;
+
+    if (!parseArguments(argc, argv, config))
+    {
+        fprintf(stderr, "Usage: %s [--csv] [--operations N] [--iterations N] [--threads N]\n"
+                        "          [--queue linked-mutex|mpmc|mpmc-batch]\n", argv[0]);
+        return 1;
+    }
+
+    // Queues report their destruction: keep output machine readable
+    LogManager::getSingleton().setVerbosity(LogVerbosity::Warning);
+
+    if (config.csv)
+    {
+        printf("queue,producers,consumers,operations,ns_per_op,mops_per_sec,valid\n");
+    }
+
+    for (uint32 producers = 1; producers <= config.threads; producers++)
+    {
+        for (uint32 consumers = 1; consumers <= config.threads; consumers++)
+        {
+            measure<LinkedQueue>(config, producers, consumers);
+            measure<RingQueue>(config, producers, consumers);
+            measure<RingBatchQueue>(config, producers, consumers);
+        }
+    }
+
+    return 0;
+}
@@ -12,13 +12,25 @@
 #include "Misc/Assert.h"
 #include "Misc/Include.h"
 #include "Misc/Alignment.h"
+#include "Misc/Hash.h"
+#include "Misc/Crc32.h"
 
 #include "Memory/Allocator.h"
 #include "Memory/ListAllocator.h"
 #include "Memory/PoolAllocator.h"
+#include "Memory/ConcurrentPoolAllocator.h"
+#include "Memory/SmallObjectAllocator.h"
 #include "Memory/StackAllocator.h"
 #include "Memory/LinearAllocator.h"
 #include "Memory/ProxyAllocator.h"
+#include "Memory/TLSFAllocator.h"
+#include "Memory/VirtualArenaAllocator.h"
+#include "Memory/FrameAllocator.h"
+#include "Memory/TaggedHeap.h"
+#include "Memory/TaggedAllocator.h"
+#include "Memory/RelocatableHeap.h"
+
+#include "Profiling/FrameAllocationCheck.h"
 
 #include "Strings/String.h"
 #include "Strings/StaticString.h"
@@ -32,14 +44,24 @@
 #include "XMLDocument.h"
 
 #include "Containers/HashMap.h"
+#include "Containers/OpenHashMap.h"
 #include "Containers/ArrayList.h"
+#include "Containers/InlineArrayList.h"
 #include "Containers/SharedList.h"
 #include "Containers/LinkedList.h"
+#include "Containers/AlignedArray.h"
+#include "Containers/SoAArray.h"
+#include "Containers/SlotMap.h"
 
 #include "Math/MathInclude.h"
 
 #include "Threading/Thread.h"
 #include "Threading/ThreadPool.h"
+#include "Threading/MPMCQueue.h"
+#include "Threading/SPSCRingBuffer.h"
+#include "Threading/ConcurrentHashMap.h"
+#include "JobSystem/JobSystem.h"
+#include "Threading/ConcurrentLinkedQueue.h"
 
 void LogTest()
 {
@@ -248,6 +270,478 @@ void ProxyAllocatorTest()
            proxy2.getAllocateCalls(), proxy2.getFreeCalls(), proxy2.getTotalMemoryUsage());
 }
 
+void BudgetedProxyAllocatorTest()
+{
+    using namespace Berserk;
+
+    struct Cache
+    {
+        ProxyAllocator* allocator;
+        void* blocks[64];
+        uint32 count;
+    };
+
+    // Cache evicts its blocks, when subsystem comes under pressure
+
+    auto onPressure = [](ProxyAllocator& allocator, ProxyAllocator::PressureLevel level, void* data)
+    {
+        auto cache = (Cache*) data;
+        uint32 evicted = 0;
+
+        if (level == ProxyAllocator::ePL_Soft) evicted = cache->count / 2;
+        if (level == ProxyAllocator::ePL_Hard) evicted = cache->count;
+
+        for (uint32 i = 0; i < evicted; i++)
+        {
+            cache->count -= 1;
+            allocator.free(cache->blocks[cache->count]);
+        }
+
+        printf("Pressure: level: %u | evicted: %u | live: %lu \n", level, evicted, allocator.getLiveUsage());
+    };
+
+    ProxyAllocator proxy(&Allocator::getSingleton(), "TestSubsystem", Buffers::KiB * 16, Buffers::KiB * 32);
+
+    Cache cache = {};
+    cache.allocator = &proxy;
+    proxy.addPressureListener(onPressure, &cache);
+
+    for (uint32 i = 0; i < 48; i++)
+    {
+        // Listener could evict blocks inside allocate() call
+
+        auto block = proxy.allocate(Buffers::KiB, (i % 4 == 0 ? 64 : 16));
+        cache.blocks[cache.count] = block;
+        cache.count += 1;
+    }
+
+    printf("Budget: live: %lu | peak: %lu | soft: %u | hard: %u | blocks: %u \n",
+           proxy.getLiveUsage(), proxy.getPeakUsage(), proxy.getSoftPressureCount(), proxy.getHardPressureCount(), cache.count);
+
+    // Over hard limit: listener must free memory, otherwise allocation fails
+
+    proxy.setLimits(0, Buffers::KiB * 8);
+
+    auto block = proxy.allocate(Buffers::KiB * 4);
+    cache.blocks[cache.count] = block;
+    cache.count += 1;
+
+    printf("Budget: live: %lu | peak: %lu | soft: %u | hard: %u | blocks: %u \n",
+           proxy.getLiveUsage(), proxy.getPeakUsage(), proxy.getSoftPressureCount(), proxy.getHardPressureCount(), cache.count);
+
+    // Listener has nothing to free: allocation fails without crash
+
+    auto overflow = proxy.allocate(Buffers::KiB * 16);
+    proxy.free(overflow);
+    printf("Budget: overflow failed: %i (expected: 1) | hard: %u \n", overflow == nullptr, proxy.getHardPressureCount());
+
+    while (cache.count > 0)
+    {
+        cache.count -= 1;
+        proxy.free(cache.blocks[cache.count]);
+    }
+
+    printf("Budget: live: %lu | peak: %lu | level: %u \n",
+           proxy.getLiveUsage(), proxy.getPeakUsage(), proxy.getPressureLevel());
+}
+
+void TaggedHeapTest()
+{
+    using namespace Berserk;
+
+    printf("\nTagged heap\n");
+
+    TaggedHeap heap(16);
+
+    for (uint64 frame = 0; frame < 4; frame++)
+    {
+        TaggedAllocator allocator(&heap, frame);
+
+        for (uint32 i = 0; i < 1024; i++)
+        {
+            allocator.allocate(Buffers::KiB * 3);
+        }
+
+        auto stat = heap.getTagStat(frame);
+        printf("Frame: %lu | blocks: %u | peak: %u | usage: %lu | free blocks: %u \n",
+               frame, stat.blocks, stat.peak, allocator.getUsage(), heap.getFreeBlocksCount());
+
+        if (frame > 0) heap.freeTag(frame - 1);
+    }
+
+    printf("\n");
+}
+
+void ConcurrentPoolAllocatorTest()
+{
+    using namespace Berserk;
+
+    printf("\nConcurrent pool allocator\n");
+
+    const uint32 THREADS = 4;
+    const uint32 CHUNKS = 1000;
+
+    ConcurrentPoolAllocator pool(Buffers::SIZE_64, PoolAllocator::INITIAL_CHUNK_COUNT * 8);
+    std::thread workers[THREADS];
+
+    for (uint32 t = 0; t < THREADS; t++)
+    {
+        workers[t] = std::thread([&pool, t]()
+        {
+            void* chunks[CHUNKS];
+
+            for (uint32 round = 0; round < 100; round++)
+            {
+                for (uint32 i = 0; i < CHUNKS; i++)
+                {
+                    chunks[i] = pool.allocate(0);
+                    memset(chunks[i], t, Buffers::SIZE_64);
+                }
+
+                for (uint32 i = 0; i < CHUNKS; i++)
+                {
+                    pool.free(chunks[i]);
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    printf("Alloc calls: %u | free calls: %u | usage: %u | total memory: %lu \n",
+           pool.getAllocateCalls(), pool.getFreeCalls(), pool.getUsage(), pool.getTotalMemoryUsage());
+
+    printf("\n");
+}
+
+void SmallObjectAllocatorTest()
+{
+    using namespace Berserk;
+
+    printf("\nSmall object allocator\n");
+
+    SmallObjectAllocator allocator;
+    void* objects[512];
+
+    uint32 sizes[] = { 8, 24, 100, 500, 2000, 4096, 10000 };
+
+    for (auto size : sizes)
+    {
+        for (uint32 i = 0; i < 512; i++)
+        {
+            objects[i] = allocator.allocate(size);
+        }
+
+        printf("Size: %5u | class: %5u | slabs: %3u | usage: %8lu | total: %8lu \n",
+               size, allocator.getClassSize(size), allocator.getSlabsCount(), allocator.getUsage(), allocator.getTotalMemoryUsage());
+
+        for (uint32 i = 0; i < 512; i++)
+        {
+            allocator.free(objects[i]);
+        }
+    }
+
+    printf("After free: slabs: %u | usage: %lu | alloc calls: %u | free calls: %u \n",
+           allocator.getSlabsCount(), allocator.getUsage(), allocator.getAllocateCalls(), allocator.getFreeCalls());
+
+    printf("\n");
+}
+
+void AlignedAllocationTest()
+{
+    using namespace Berserk;
+
+    printf("\nAligned allocation\n");
+
+    Allocator& general = Allocator::getSingleton();
+    ListAllocator list(Buffers::KiB * 64);
+    StackAllocator stack(Buffers::KiB * 64);
+    LinearAllocator linear(Buffers::KiB * 64);
+    ProxyAllocator proxy(&general);
+    PoolAllocator pool(48, 64, nullptr, 64);
+
+    uint32 alignments[] = { 16, 32, 64, 128, 4096 };
+
+    for (auto alignment : alignments)
+    {
+        auto p1 = (uint8*) general.allocate(100, alignment);
+        auto p2 = (uint8*) list.allocate(100, alignment);
+        auto p3 = (uint8*) stack.allocate(100, alignment);
+        auto p4 = (uint8*) linear.allocate(100, alignment);
+        auto p5 = (uint8*) proxy.allocate(100, alignment);
+
+        printf("Alignment: %4u | general: %i | list: %i | stack: %i | linear: %i | proxy: %i \n", alignment,
+               (uint64)p1 % alignment == 0, (uint64)p2 % alignment == 0, (uint64)p3 % alignment == 0,
+               (uint64)p4 % alignment == 0, (uint64)p5 % alignment == 0);
+
+        memset(p1, 0, 100);
+        memset(p2, 0, 100);
+        memset(p3, 0, 100);
+
+        general.free(p1);
+        list.free(p2);
+        stack.free(p3);
+        proxy.free(p5);
+    }
+
+    void* chunks[128];
+    uint32 aligned = 0;
+
+    for (auto& chunk : chunks)
+    {
+        chunk = pool.allocate(48, 64);
+        aligned += ((uint64)chunk % 64 == 0);
+    }
+
+    printf("Pool: chunk size: %u | alignment: %u | aligned chunks: %u of %u \n",
+           pool.getChunkSize(), pool.getAlignment(), aligned, 128);
+
+    for (auto chunk : chunks)
+    {
+        pool.free(chunk);
+    }
+
+    AlignedArray32<float32> vector(13);
+    printf("Aligned array: count: %u | capacity: %u | aligned: %i \n",
+           vector.getCount(), vector.getCapacity(), (uint64)vector.get() % 32 == 0);
+
+    printf("Cache aligned: size: %lu | align: %lu \n", sizeof(CacheAligned<uint32>), alignof(CacheAligned<uint32>));
+    printf("\n");
+}
+
+void TLSFAllocatorTest()
+{
+    using namespace Berserk;
+
+    printf("\nTLSF allocator\n");
+
+    Allocator& general = Allocator::getSingleton();
+    ProxyAllocator parent(&general);
+    TLSFAllocator tlsf(Buffers::KiB * 4, &parent);
+
+    void* p[32];
+    uint32 sizes[] = { 16, 48, 100, 64, 200, 32 };
+    uint64 total = tlsf.getTotalMemoryUsage();
+
+    for (uint32 i = 0; i < 32; i++) p[i] = tlsf.allocate(sizes[i % 6]);
+
+    printf("Allocated: usage: %lu | total: %lu \n", tlsf.getUsage(), tlsf.getTotalMemoryUsage());
+
+    // Free in mixed order: neighbours are merged from both sides
+
+    for (uint32 i = 0; i < 32; i += 2) tlsf.free(p[i]);
+    for (int32 i = 31; i >= 0; i -= 2) tlsf.free(p[i]);
+
+    printf("Freed: usage: %lu \n", tlsf.getUsage());
+
+    // Whole pool is single free block again: fits without new pool
+
+    auto block = tlsf.allocate(tlsf.getBufferSize());
+    printf("Coalesced: usage: %lu | block: %i | new pool: %i \n",
+           tlsf.getUsage(), block == p[0], tlsf.getTotalMemoryUsage() != total);
+    tlsf.free(block);
+
+    // Oversize block is placed in dedicated pool, which is returned to parent on free
+
+    uint32 freeCalls = parent.getFreeCalls();
+    auto big = tlsf.allocate(tlsf.getBufferSize() * 4);
+    tlsf.free(big);
+
+    printf("Dedicated: released: %i | usage: %lu \n", parent.getFreeCalls() == freeCalls + 1, tlsf.getUsage());
+    printf("\n");
+}
+
+void VirtualArenaAllocatorTest()
+{
+    using namespace Berserk;
+
+    printf("\nVirtual arena allocator\n");
+
+    VirtualArenaAllocator arena(Buffers::GiB);
+
+    for (uint32 frame = 0; frame < 4; frame++)
+    {
+        // The first frames are heavy, the next ones are light
+
+        uint32 count = (frame < 2 ? 512 : 4);
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            auto data = (uint8*) arena.allocate(Buffers::KiB * 16);
+            memset(data, 0, Buffers::KiB * 16);
+        }
+
+        auto marker = arena.getMarker();
+        arena.allocate(Buffers::KiB, 64);
+        arena.rewind(marker);
+
+        printf("Frame: %u | usage: %8lu | committed: %8lu | reserved: %lu \n",
+               frame, arena.getUsage(), arena.getCommittedSize(), arena.getReservedSize());
+
+        arena.clear();
+    }
+
+    printf("After clear: committed: %lu \n", arena.getCommittedSize());
+    printf("\n");
+}
+
+void FrameAllocatorTest()
+{
+    using namespace Berserk;
+
+    printf("\nFrame allocator\n");
+
+    FrameAllocator frames(Buffers::KiB * 64, 3);
+    uint8* data[6];
+
+    for (uint32 frame = 0; frame < 6; frame++)
+    {
+        // Data of frame is valid while the frame is not retired (up to 3 frames)
+
+        data[frame] = (uint8*) frames.allocate(Buffers::KiB * (frame + 1));
+        memset(data[frame], frame, Buffers::KiB * (frame + 1));
+
+        if (frame >= 2)
+        {
+            printf("Frame: %lu | usage: %6lu | data of frame %u: %u \n",
+                   frames.getCurrentFrame(), frames.getUsage(), frame - 2, data[frame - 2][0]);
+
+            frames.retireFrame();
+        }
+
+        bool started = frames.tryBeginFrame();
+        printf("Begin frame: %lu | arena free: %i \n", frames.getCurrentFrame(), started);
+    }
+
+    printf("Peak usage: %lu | alloc calls: %u \n", frames.getPeakUsage(), frames.getAllocateCalls());
+    printf("\n");
+}
+
+void AllocationStatsTest()
+{
+    using namespace Berserk;
+
+    printf("\nAllocation stats\n");
+
+    PoolAllocator pool(64, 64);
+    pool.setStatsName("Test Pool");
+
+    void* chunks[100];
+    void* block;
+
+    {
+        AllocationStats::TagScope scope("Test Tag");
+
+        for (auto& chunk : chunks) chunk = pool.allocate(64);
+        for (uint32 i = 0; i < 50; i++) pool.free(chunks[i]);
+
+        block = Allocator::getSingleton().allocate(256);
+    }
+
+    // Out of tag scope: attributed to tag via block header
+    Allocator::getSingleton().free(block);
+
+    auto snapshot = (AllocationStats::Snapshot*) Allocator::getSingleton().allocate(sizeof(AllocationStats::Snapshot));
+    AllocationStats::snapshot(*snapshot);
+
+    for (uint32 i = 0; i < snapshot->channelsCount; i++)
+    {
+        auto& channel = snapshot->channels[i];
+        printf("Channel: %20s | %9s | alloc: %8lu | free: %8lu | live: %10li | peak: %10li \n",
+               channel.name, (channel.isTag ? "tag" : "allocator"),
+               channel.allocCalls, channel.freeCalls, channel.liveBytes, channel.peakBytes);
+    }
+
+    AllocationStats::exportJson(*snapshot, stdout);
+    Allocator::getSingleton().free(snapshot);
+
+    for (uint32 i = 50; i < 100; i++) pool.free(chunks[i]);
+
+    printf("\n");
+}
+
+void FrameAllocationCheckTest()
+{
+    using namespace Berserk;
+
+    printf("\nFrame allocation check\n");
+
+    Allocator& allocator = Allocator::getSingleton();
+    FrameAllocationCheck::enable(2, false);
+
+    void* cached = nullptr;
+
+    for (uint32 frame = 0; frame < 6; frame++)
+    {
+        FrameAllocationCheck::beginFrame();
+
+        // Warm-up frames fill the cache, steady-state frames reuse it,
+        // only the odd ones make temporary allocations
+
+        if (cached == nullptr) cached = allocator.allocate(Buffers::KiB);
+
+        if (frame % 2 == 1)
+        {
+            for (uint32 i = 0; i < 3; i++) allocator.free(allocator.allocate(64));
+        }
+
+        FrameAllocationCheck::endFrame();
+
+        printf("Frame: %u | allocations: %u \n", frame, FrameAllocationCheck::getLastFrameAllocations());
+    }
+
+    printf("Checked frames: %u | allocating frames: %u \n",
+           FrameAllocationCheck::getCheckedFramesCount(), FrameAllocationCheck::getAllocatingFramesCount());
+
+    FrameAllocationCheck::disable();
+    allocator.free(cached);
+}
+
+void RelocatableHeapTest()
+{
+    using namespace Berserk;
+
+    printf("\nRelocatable heap\n");
+
+    RelocatableHeap heap(RelocatableHeap::MIN_BUFFER_SIZE);
+    RelocatableHeap::Handle handles[256];
+
+    for (uint32 i = 0; i < 256; i++)
+    {
+        handles[i] = heap.allocate(Buffers::KiB);
+        memset(heap.get(handles[i]), i, Buffers::KiB);
+    }
+
+    printf("Allocated: usage: %8lu | mapped: %8lu | buffers: %u \n",
+           heap.getUsage(), heap.getMappedSize(), heap.getBuffersCount());
+
+    // Every second block is freed: each buffer is half empty
+
+    for (uint32 i = 0; i < 256; i += 2) heap.free(handles[i]);
+
+    uint32 frame = 0;
+
+    while (heap.compact(Buffers::KiB * 16) > 0)
+    {
+        printf("Frame: %u | mapped: %8lu | buffers: %u | moved: %8lu \n",
+               frame++, heap.getMappedSize(), heap.getBuffersCount(), heap.getMovedBytes());
+    }
+
+    bool valid = true;
+
+    for (uint32 i = 1; i < 256; i += 2)
+    {
+        valid = valid && ((uint8*)heap.get(handles[i]))[0] == (uint8)i;
+    }
+
+    printf("Compacted: usage: %8lu | mapped: %8lu | released: %u | data valid: %i | stale handle: %i \n",
+           heap.getUsage(), heap.getMappedSize(), heap.getReleasedBuffersCount(), valid, heap.isValid(handles[0]));
+    printf("\n");
+}
+
 void OptionTest()
 {
     printf("Version: %s | %d %d \n", BERSERK_VERSION, BERSERK_VERSION_MAJOR, BERSERK_VERSION_MINOR);
@@ -361,24 +855,158 @@ void XMLTest()
 
 }
 
-void ArrayListTest()
-{
-    using namespace Berserk;
+void ArrayListTest()
+{
+    using namespace Berserk;
+
+    printf("\nArray List\n");
+
+    ArrayList<int64> array(ArrayList<int64>::DEFAULT_INITIAL_SIZE);
+
+    for (int64 i = 0; i < 25; i++)
+    {
+        array += (i * i);
+        printf("Value[%i] = %li\n", i, array[i]);
+    }
+
+    auto i = 0;
+    for (auto item = array.iterate(); item; item = array.next())
+    {
+        printf("Value[%u] = %li\n", i++, *item);
+    }
+}
+
+void ArrayListEmplaceTest()
+{
+    using namespace Berserk;
+
+    printf("\nArray List Emplace\n");
+
+    // Non-trivial elements: copies share string nodes via
+    // reference counting, relocation must not break counters
+
+    struct Object
+    {
+        Object(const char* name, uint32 id) : name(name), id(id) {}
+
+        CString name;
+        uint32 id;
+    };
+
+    ArrayList<Object> objects(ArrayList<Object>::MIN_INITIAL_SIZE);
+    objects.reserve(4);
+
+    CString shared("Shared");
+
+    for (uint32 i = 0; i < 20; i++)
+    {
+        auto& object = objects.emplace("Object", i);
+        if (i % 2 == 0) object.name = shared;
+    }
+
+    objects += objects[0];
+    objects.remove(1);
+
+    printf("Size: %u | Capacity: %u | Shared refs: %u \n", objects.getSize(), objects.getCapacity(), shared.referenceCount());
+
+    for (auto object = objects.iterate(); object; object = objects.next())
+    {
+        printf("Object: %s %u \n", object->name.get(), object->id);
+    }
+
+    objects.empty();
+    printf("Shared refs after empty: %u \n", shared.referenceCount());
+
+    InlineArrayList<uint64, 4> small;
+
+    for (uint64 i = 0; i < 4; i++) small += i;
+    printf("Inline: %i | Size: %u | Heap: %u \n", small.isInline(), small.getSize(), small.getMemoryUsage());
+
+    for (uint64 i = 4; i < 10; i++) small.emplace(i * i);
+    printf("Inline: %i | Size: %u | Heap: %u | Last: %lu \n", small.isInline(), small.getSize(), small.getMemoryUsage(), small[9]);
+}
+
+void SoAArrayTest()
+{
+    using namespace Berserk;
+
+    printf("\nSoA Array\n");
+
+    // Bounds and visibility of objects are stored in separate columns:
+    // culling reads packed spheres and writes packed results
+
+    SoAArray<Sphere, float32> objects(SoAArray<Sphere, float32>::SIMD_WIDTH);
+
+    Frustum frustum(Degrees(90.0f).radians().get(), 1.0f, 0.1f, 10.f,
+                    Vec3f(0,0,-10), Vec3f(0,0,-1), Vec3f(0,1,0));
+
+    uint32 ids[10];
+
+    for (uint32 i = 0; i < 10; i++)
+    {
+        ids[i] = objects.add(Sphere(Vec3f(0, 0, -5.0f * i), 1.0f), 0.0f);
+    }
+
+    objects.remove(ids[0]);
+    objects.remove(ids[4]);
+    objects.get<0>(ids[9]) += Vec3f(0, 0, 30);
+
+    frustum.inside_SIMD(objects.column<0>(), objects.column<1>(), objects.getPaddedSize());
+
+    auto visible = objects.view<1>();
+    printf("Size: %u | Padded: %u | Capacity: %u | Memory: %u \n",
+           visible.count, visible.paddedCount, objects.getCapacity(), objects.getMemoryUsage());
+
+    for (uint32 i = 0; i < 10; i++)
+    {
+        if (!objects.contains(ids[i])) { printf("Id: %u removed \n", ids[i]); continue; }
+
+        auto index = objects.getIndex(ids[i]);
+        printf("Id: %u | Index: %u | Sphere: %s | Visible: %i \n",
+               ids[i], index, objects.get<0>(ids[i]).toString().get(), visible[index] != 0);
+    }
+
+    auto id = objects.add(Sphere(Vec3f(0, 0, -20), 2.0f), 0.0f);
+    printf("Reused id: %u | Index: %u \n", id, objects.getIndex(id));
+}
+
+void SlotMapTest()
+{
+    using namespace Berserk;
+
+    printf("\nSlot Map\n");
+
+    SlotMap<CString> map(SlotMap<CString>::MIN_INITIAL_SIZE);
+    SlotHandle handles[8];
+
+    char name[Buffers::SIZE_32];
+
+    for (uint32 i = 0; i < 8; i++)
+    {
+        sprintf(name, "Component%u", i);
+        handles[i] = map.emplace(name);
+    }
+
+    map.remove(handles[2]);
+    map.remove(handles[5]);
 
-    printf("\nArray List\n");
+    // Slot of the removed element is reused with new generation
+    auto handle = map.add(CString("Reused"));
 
-    ArrayList<int64> array(ArrayList<int64>::DEFAULT_INITIAL_SIZE);
+    printf("Size: %u | Capacity: %u | Memory: %u \n", map.getSize(), map.getCapacity(), map.getMemoryUsage());
+    printf("Stale: [%u %u] contains: %i | New: [%u %u] contains: %i \n",
+           handles[5].index, handles[5].generation, map.contains(handles[5]),
+           handle.index, handle.generation, map.contains(handle));
 
-    for (int64 i = 0; i < 25; i++)
+    for (uint32 i = 0; i < 8; i++)
     {
-        array += (i * i);
-        printf("Value[%i] = %li\n", i, array[i]);
+        auto element = map.get(handles[i]);
+        printf("Handle: [%u %u] value: %s \n", handles[i].index, handles[i].generation, (element ? element->get() : "removed"));
     }
 
-    auto i = 0;
-    for (auto item = array.iterate(); item; item = array.next())
+    for (auto element = map.iterate(); element; element = map.next())
     {
-        printf("Value[%u] = %li\n", i++, *item);
+        printf("Iterate: %s \n", element->get());
     }
 }
 
@@ -480,6 +1108,141 @@ void HashMapTest()
     }
 }
 
+void Crc32Test()
+{
+    using namespace Berserk;
+
+    printf("\nCrc32\n");
+
+    const char* check = "123456789";
+
+    printf("CRC-32:  %x (expected cbf43926) \n", Crc32::hash(check, 9));
+    printf("CRC-32C: %x (expected e3069283) | software: %x | hardware: %i \n",
+           Crc32::hashCastagnoli(check, 9), Crc32::hashCastagnoliSoftware(check, 9), Crc32::isHardwareCastagnoli());
+
+    // Sliced and hardware versions against bit-wise reference
+    // for all the tails and unaligned starts
+
+    uint8 buffer[300];
+    for (uint32 i = 0; i < 300; i++) buffer[i] = (uint8)(i * 31 + 7);
+
+    uint32 errors = 0;
+
+    for (uint32 offset = 0; offset < 8; offset++)
+    {
+        for (uint32 len = 0; len <= 256; len++)
+        {
+            uint32 ieee = 0xFFFFFFFF, castagnoli = 0xFFFFFFFF;
+
+            for (uint32 i = 0; i < len; i++)
+            {
+                ieee ^= buffer[offset + i];
+                castagnoli ^= buffer[offset + i];
+
+                for (uint32 j = 0; j < 8; j++)
+                {
+                    ieee = (ieee >> 1) ^ (0xEDB88320 & (0u - (ieee & 1)));
+                    castagnoli = (castagnoli >> 1) ^ (0x82F63B78 & (0u - (castagnoli & 1)));
+                }
+            }
+
+            ieee ^= 0xFFFFFFFF;
+            castagnoli ^= 0xFFFFFFFF;
+
+            if (Crc32::hash((const char*)buffer + offset, len) != ieee) errors += 1;
+            if (Crc32::hashCastagnoli(buffer + offset, len) != castagnoli) errors += 1;
+            if (Crc32::hashCastagnoliSoftware(buffer + offset, len) != castagnoli) errors += 1;
+        }
+    }
+
+    printf("Errors: %u \n", errors);
+}
+
+void HashTest()
+{
+    using namespace Berserk;
+
+    printf("\nHash\n");
+
+    const char* text = "The quick brown fox jumps over the lazy dog";
+    uint32 length = (uint32) strlen(text);
+
+    printf("Crc32: %x | Hash: %x | Hash64: %lx \n",
+           Crc32::hash(text, length), Hash::hash(text, length), Hash::hash64(text, length));
+
+    // Keys with the same value have the same hash (not the address of the key)
+
+    CName a("TextureDiffuse"), b("TextureDiffuse"), c("TextureNormal");
+    printf("CName: %x %x %x \n", HashTraits<CName>::hash(a), HashTraits<CName>::hash(b), HashTraits<CName>::hash(c));
+
+    uint32 x = 17, y = 17;
+    printf("uint32: %x %x | default: %x %x \n", HashTraits<uint32>::hash(x), HashTraits<uint32>::hash(y),
+           HashMap<uint32, uint32>::defaultHashing(&x), HashMap<uint32, uint32>::defaultHashing(&y));
+
+    // Sequential ids must be spread over buckets
+
+    const uint32 RANGE = 64;
+    uint32 buckets[RANGE] = {};
+
+    for (uint32 id = 0; id < 64 * RANGE; id++) buckets[HashTraits<uint32>::hash(id * RANGE) % RANGE] += 1;
+
+    uint32 min = 0xffffffff, max = 0;
+    for (auto count : buckets) { if (count < min) min = count; if (count > max) max = count; }
+
+    printf("Ids per bucket: min: %u | max: %u (expected about 64) \n", min, max);
+}
+
+void OpenHashMapTest()
+{
+    using namespace Berserk;
+
+    printf("\nOpen Hash Map\n");
+
+    OpenHashMap<CName, uint64> map(CName::Hashing);
+
+    map.add(CName("TextureSpecular"), 0);
+    map.add(CName("TextureDiffuse"), 2);
+    map.add(CName("TextureNormal"), 6);
+    map.add(CName("TextureBump"), 1);
+
+    printf("\n");
+    printf("Key: %s | Value: %lu \n", "TextureBump",     *map[CName("TextureBump")]);
+    printf("Key: %s | Value: %lu \n", "TextureNormal",   *map[CName("TextureNormal")]);
+    printf("Key: %s | Value: %lu \n", "TextureDiffuse",  *map[CName("TextureDiffuse")]);
+    printf("Key: %s | Value: %lu \n", "TextureSpecular", *map[CName("TextureSpecular")]);
+
+    printf("\n");
+    printf("Remove: Key: %s \n", "TextureBump");   map.remove(CName("TextureBump"));
+    printf("Rewrite: Key: %s \n", "TextureDiffuse"); map.add(CName("TextureDiffuse"), 14);
+
+    for (auto e = map.iterate(); e; e = map.next())
+    {
+        printf("Iterate: Key: %s | Value: %lu \n", e->key().get(), e->value());
+    }
+
+    // Grow with integer keys, then remove every second one
+    // (no tombstones: probe lengths stay short)
+
+    OpenHashMap<uint32, uint32> numbers;
+    const uint32 COUNT = 10000;
+
+    for (uint32 i = 0; i < COUNT; i++) numbers.add(i * 7, i);
+    for (uint32 i = 0; i < COUNT; i += 2) numbers.remove(i * 7);
+
+    uint32 errors = 0;
+
+    for (uint32 i = 0; i < COUNT; i++)
+    {
+        auto value = numbers[i * 7];
+        if (i % 2 == 0 && value != nullptr) errors += 1;
+        if (i % 2 == 1 && (value == nullptr || *value != i)) errors += 1;
+    }
+
+    printf("\n");
+    printf("Size: %u | Capacity: %u | Load factor: %f | Max probe: %u | Errors: %u \n",
+           numbers.getSize(), numbers.getRange(), numbers.getLoadFactor(), numbers.getMaxProbeLength(), errors);
+}
+
 void MathTest()
 {
     using namespace Berserk;
@@ -801,6 +1564,257 @@ void ThreadTest()
     printf("\n");
 }
 
+void MPMCQueueTest()
+{
+    using namespace Berserk;
+
+    printf("\nMPMC Queue\n");
+
+    static const uint32 COUNT = 100000;
+
+    MPMCQueue<uint32> queue(64);
+    std::atomic<uint64> sum(0);
+    std::atomic<uint32> popped(0);
+
+    // Two producers (single and batched push), two consumers (single and batched pop)
+
+    auto producer = [&](uint32 first, bool batched)
+    {
+        for (uint32 i = first; i < COUNT; )
+        {
+            uint32 values[4] = { i, i + 2, i + 4, i + 6 };
+            uint32 count = (batched ? queue.tryPushBatch(values, (i + 6 < COUNT ? 4 : 1)) : (queue.tryPush(i) ? 1 : 0));
+            if (count == 0) Thread::yield();
+            i += count * 2;
+        }
+    };
+
+    auto consumer = [&](bool batched)
+    {
+        uint32 values[8];
+
+        while (popped.load() < COUNT)
+        {
+            uint32 count = (batched ? queue.tryPopBatch(values, 8) : (queue.tryPop(values[0]) ? 1 : 0));
+            for (uint32 i = 0; i < count; i++) sum += values[i];
+            popped += count;
+        }
+    };
+
+    std::thread threads[] =
+    {
+        std::thread(producer, 0, false), std::thread(producer, 1, true),
+        std::thread(consumer, false),    std::thread(consumer, true)
+    };
+
+    for (auto& thread : threads) thread.join();
+
+    printf("Capacity: %u | Size: %u | Popped: %u | Sum: %lu (expected: %lu) \n",
+           queue.getCapacity(), queue.getSize(), popped.load(), sum.load(), (uint64) COUNT * (COUNT - 1) / 2);
+}
+
+void SPSCRingBufferTest()
+{
+    using namespace Berserk;
+
+    printf("\nSPSC Ring Buffer\n");
+
+    static const uint32 COUNT = 100000;
+
+    SPSCRingBuffer ring(SPSCRingBuffer::MIN_CAPACITY * 16);
+    uint32 errors = 0;
+    uint32 wraps = 0;
+
+    // Producer writes records of different lengths in place, filled with its index
+
+    std::thread producer([&]()
+    {
+        for (uint32 i = 0; i < COUNT; )
+        {
+            uint32 size = i % 77;
+            auto payload = (uint8*) ring.beginWrite(size, i);
+            if (payload == nullptr) { Thread::yield(); continue; }
+
+            memset(payload, (int32)(i & 0xff), size);
+            ring.endWrite();
+            i += 1;
+        }
+    });
+
+    uint64 position = ring.getReadPosition();
+
+    for (uint32 i = 0; i < COUNT; )
+    {
+        uint32 size, tag;
+        auto previous = position;
+        auto payload = (const uint8*) ring.read(position, size, tag);
+        if (payload == nullptr) { Thread::yield(); continue; }
+
+        if (tag != i || size != i % 77) errors += 1;
+        for (uint32 j = 0; j < size; j++) if (payload[j] != (i & 0xff)) errors += 1;
+
+        wraps += (position / ring.getCapacity() != previous / ring.getCapacity() ? 1 : 0);
+        ring.release(position);
+        i += 1;
+    }
+
+    producer.join();
+
+    printf("Capacity: %u | Records: %u | Wraps: %u | Errors: %u | Empty: %i \n",
+           ring.getCapacity(), COUNT, wraps, errors, ring.isEmpty());
+}
+
+void JobSystemTest()
+{
+    using namespace Berserk;
+
+    printf("\nJob System\n");
+
+    static const uint64 COUNT = 1000000;
+    static const uint64 GRAIN = 1000;
+
+    struct Range
+    {
+        uint64 begin;
+        uint64 end;
+        std::atomic<uint64>* sum;
+    };
+
+    // Range is split recursively in children jobs: root is
+    // finished only when all the leaves are finished
+
+    struct Sum
+    {
+        static void run(JobSystem& system, Job& job)
+        {
+            Range range = job.getData<Range>();
+
+            if (range.end - range.begin <= GRAIN)
+            {
+                uint64 local = 0;
+                for (uint64 i = range.begin; i < range.end; i++) local += i;
+                range.sum->fetch_add(local);
+                return;
+            }
+
+            uint64 middle = (range.begin + range.end) / 2;
+            Range left = { range.begin, middle, range.sum };
+            Range right = { middle, range.end, range.sum };
+
+            system.run(system.createChild(&job, run, left));
+            system.run(system.createChild(&job, run, right));
+        }
+    };
+
+    class Work : public IRunnable
+    {
+    public:
+
+        int32 run() override { done += 1; return 0; }
+
+        std::atomic<uint32> done{0};
+    };
+
+    JobSystem system(3, 256);
+    std::atomic<uint64> sum(0);
+    std::atomic<uint64> foreignSum(0);
+    Work work;
+
+    for (uint32 frame = 0; frame < 10; frame++)
+    {
+        Range range = { 0, COUNT, &sum };
+        Job* root = system.create(Sum::run, range);
+        system.run(root);
+        system.wait(root);
+    }
+
+    // Thread outside the system submits via shared queue
+
+    std::thread foreign([&]()
+    {
+        Range range = { 0, COUNT, &foreignSum };
+        Job* root = system.create(Sum::run, range);
+        system.run(root);
+        system.wait(root);
+    });
+
+    Job* runnables = system.create([](JobSystem&, Job&) { });
+
+    for (uint32 i = 0; i < 100; i++)
+    {
+        system.run(system.create(&work, runnables));
+    }
+
+    system.run(runnables);
+    system.wait(runnables);
+    foreign.join();
+
+    printf("Workers: %u | Pending: %u | Memory: %u \n", system.getWorkersCount(), system.getPendingJobsCount(), system.getMemoryUsage());
+    printf("Sum: %lu (expected: %lu) | Foreign sum: %lu (expected: %lu) | Runnables: %u (expected: 100) \n",
+           sum.load(), 10 * COUNT * (COUNT - 1) / 2, foreignSum.load(), COUNT * (COUNT - 1) / 2, work.done.load());
+}
+
+void ConcurrentHashMapTest()
+{
+    using namespace Berserk;
+
+    printf("\nConcurrent Hash Map\n");
+
+    static const uint32 KEYS = 64;
+    static const uint32 THREADS = 4;
+
+    ConcurrentHashMap<CName, uint32> map;
+    std::atomic<uint32> created[KEYS];
+    std::atomic<uint32> acquired(0);
+    std::atomic<uint32> errors(0);
+
+    for (auto& counter : created) counter = 0;
+
+    // All threads request the same keys: each value must be created once,
+    // the others get it (or wait for it) via acquire
+
+    auto worker = [&]()
+    {
+        for (uint32 i = 0; i < KEYS; i++)
+        {
+            char name[32];
+            sprintf(name, "Texture%u", i);
+
+            uint32 value = map.getOrInsert(CName(name), [&]()
+            {
+                created[i] += 1;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                return i + 1;
+            },
+            [&](uint32&)
+            {
+                acquired += 1;
+            });
+
+            if (value != i + 1) errors += 1;
+        }
+    };
+
+    std::thread threads[THREADS];
+    for (auto& thread : threads) thread = std::thread(worker);
+    for (auto& thread : threads) thread.join();
+
+    uint32 duplicates = 0;
+    for (auto& counter : created) duplicates += (counter.load() != 1 ? 1 : 0);
+
+    uint32 failed = map.getOrInsert(CName("Missing"), []() { return 0u; });
+    bool removed = map.removeIf(CName("Texture0"), [](uint32& value) { return value == 1; });
+    bool kept = map.removeIf(CName("Texture1"), [](uint32& value) { return value == 1; });
+
+    uint32 sum = 0;
+    map.forEach([&](const CName& key, uint32& value) { sum += value; });
+
+    printf("Size: %u | Duplicated creations: %u | Acquired: %u (expected: %u) | Errors: %u \n",
+           map.getSize(), duplicates, acquired.load(), KEYS * (THREADS - 1), errors.load());
+    printf("Failed factory: %u | Removed: %i | Kept: %i | Sum: %u (expected: %u) \n",
+           failed, removed, !kept, sum, KEYS * (KEYS + 1) / 2 - 1);
+}
+
 void ThreadPoolTest()
 {
     using namespace Berserk;
@@ -827,7 +1841,7 @@ void ThreadPoolTest()
     };
 
     const uint64 tasksCount = 100000;
-    ThreadPool pool(tasksCount);
+    ThreadPool pool;
     Future futures[tasksCount];
     Work works[tasksCount];
 
@@ -861,6 +1875,145 @@ void ThreadPoolTest()
     printf("\n");
 }
 
+void FutureTest()
+{
+    using namespace Berserk;
+
+    printf("\nFuture\n");
+
+    class Work : public IRunnable
+    {
+    public:
+
+        int32 run() override
+        {
+            if (input) value = input->value;
+            value += 1;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+            return (int32) value;
+        }
+
+        Work* input = nullptr;
+        uint32 delay = 0;
+        int64 value = 0;
+    };
+
+    const uint32 count = 8;
+    ThreadPool pool;
+    Future futures[count];
+    Work works[count];
+
+    // Chain: each work is continuation of the previous one
+
+    works[0].delay = 10;
+    pool.submit(&works[0], &futures[0]);
+
+    for (uint32 i = 1; i < count; i++)
+    {
+        works[i].input = &works[i - 1];
+        futures[i - 1].then(&works[i], futures[i]);
+    }
+
+    printf("Done before timeout: %i (expected: 0) \n", futures[count - 1].waitFor(0.001));
+
+    futures[count - 1].wait();
+    printf("Chain result: %i (expected: %u) \n", futures[count - 1].result(), count);
+
+    // Continuation of done future is submitted at once
+
+    Work last;
+    Future lastFuture;
+    last.input = &works[count - 1];
+    futures[count - 1].then(&last, lastFuture);
+    lastFuture.wait();
+    printf("Late continuation: %i (expected: %u) \n", lastFuture.result(), count + 1);
+
+    // Groups
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        works[i].input = nullptr;
+        works[i].value = 0;
+        works[i].delay = (i == 3 ? 1 : 50);
+        pool.submit(&works[i], &futures[i]);
+    }
+
+    uint32 any = Future::waitAny(futures, count);
+    printf("Any: %u | Done: %i (expected: 1) \n", any, futures[any].done());
+
+    Future::waitAll(futures, count);
+
+    uint32 done = 0;
+    for (uint32 i = 0; i < count; i++) done += (futures[i].done() ? 1 : 0);
+    printf("All: %u (expected: %u) \n", done, count);
+
+    // Group results compose with continuations (no thread is blocked)
+
+    Work afterAny;
+    Work afterAll;
+    Future anyGroup;
+    Future allGroup;
+    Future afterAnyFuture;
+    Future afterAllFuture;
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        works[i].value = 0;
+        pool.submit(&works[i], &futures[i]);
+    }
+
+    Future::whenAny(futures, count, anyGroup);
+    anyGroup.then(&afterAny, afterAnyFuture);
+
+    pool.join();
+    printf("When any: %i | Done: %i | Continuation: %i (expected: 1 1 1) \n",
+           anyGroup.result(), futures[anyGroup.result()].done(), afterAnyFuture.done());
+
+    // Result is reused as soon as it is done: not done futures of
+    // the previous group must not signal the new one
+
+    Work slow[2];
+    Future slowFutures[2];
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        works[i].value = 0;
+        pool.submit(&works[i], &futures[i]);
+    }
+
+    Future::whenAny(futures, count, anyGroup);
+    anyGroup.wait();
+
+    for (uint32 i = 0; i < 2; i++)
+    {
+        slow[i].delay = 200;
+        pool.submit(&slow[i], &slowFutures[i]);
+    }
+
+    Future::whenAll(slowFutures, 2, anyGroup);
+    anyGroup.wait();
+    printf("Reused group: %i | Done: %i %i (expected: 2 1 1) \n",
+           anyGroup.result(), slowFutures[0].done(), slowFutures[1].done());
+
+    pool.join();
+
+    for (uint32 i = 0; i < count; i++)
+    {
+        works[i].value = 0;
+        pool.submit(&works[i], &futures[i]);
+    }
+
+    Future::whenAll(futures, count, allGroup);
+    allGroup.then(&afterAll, afterAllFuture);
+
+    afterAllFuture.wait();
+    printf("When all: %i | Continuation: %i (expected: %u 1) \n", allGroup.result(), afterAllFuture.done(), count);
+
+    pool.join();
+    pool.shutdown();
+}
+
 void OperatorTest()
 {
     using namespace Berserk;
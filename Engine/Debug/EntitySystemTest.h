@@ -19,7 +19,7 @@ void TraverseEntity(Berserk::Engine::IEntity *entity, Berserk::uint32 offset = 0
     auto ownerName = (entity->getOwnerEntity() ? entity->getOwnerEntity()->getName() : nullptr);
     printf("%*s %s -> %s \n", offset, "", entity->getName(), ownerName);
 
-    ArrayList<IEntity*> &list = entity->getEntitiesList();
+    auto& list = entity->getEntitiesList();
 
     for (uint32 i = 0; i < list.getSize(); i++)
     {
@@ -109,7 +109,7 @@ void MultiThread()
 
     std::chrono::duration<double> elp = end - start;
 
-    printf("Multi-Thread: %lfms [Threads count: %u]\n", elp.count() * 1000.0, executor.THREADS_COUNT + 1);
+    printf("Multi-Thread: %lfms [Threads count: %u]\n", elp.count() * 1000.0, executor.getThreadsCount() + 1);
 
     executor.shutdown();
 }
@@ -174,7 +174,7 @@ void MultiThreadSIMD()
 
     std::chrono::duration<double> elp = end - start;
 
-    printf("Multi-Thread SSE: %lfms [Threads count: %u]\n", elp.count() * 1000.0, executor.THREADS_COUNT + 1);
+    printf("Multi-Thread SSE: %lfms [Threads count: %u]\n", elp.count() * 1000.0, executor.getThreadsCount() + 1);
 
     executor.shutdown();
 }
@@ -0,0 +1,78 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_MEMORYPERFORMANCETEST_H
+#define BERSERK_MEMORYPERFORMANCETEST_H
+
+#include <chrono>
+#include "Memory/ListAllocator.h"
+#include "Memory/TLSFAllocator.h"
+
+using namespace Berserk;
+
+const uint32 TRACE_SLOTS_COUNT = 1024;
+const uint32 TRACE_OPERATIONS_COUNT = 20000;
+
+/** Allocates and frees chunks of pseudo random sizes in [min, max] in random slots */
+double MixedSizeTrace(IAllocator& allocator, uint32 min, uint32 max)
+{
+    void* slots[TRACE_SLOTS_COUNT] = { nullptr };
+    uint32 seed = 0x9e3779b9;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (uint32 i = 0; i < TRACE_OPERATIONS_COUNT; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        uint32 slot = (seed >> 8) % TRACE_SLOTS_COUNT;
+
+        if (slots[slot])
+        {
+            allocator.free(slots[slot]);
+            slots[slot] = nullptr;
+        }
+        else
+        {
+            seed = seed * 1664525 + 1013904223;
+            uint32 size = min + (seed >> 8) % (max - min + 1);
+            slots[slot] = allocator.allocate(size);
+        }
+    }
+
+    for (uint32 i = 0; i < TRACE_SLOTS_COUNT; i++)
+    {
+        if (slots[i]) allocator.free(slots[i]);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double> elp = end - start;
+    return elp.count() * 1000.0;
+}
+
+void TLSFAllocatorPerformance()
+{
+    printf("\n");
+
+    printf("TLSF Allocator Performance test\n");
+    printf("Operations: %u | Slots: %u\n", TRACE_OPERATIONS_COUNT, TRACE_SLOTS_COUNT);
+
+    const uint32 ranges[][2] = { { 16, 64 }, { 16, 1024 }, { 256, 4096 }, { 16, 16384 } };
+
+    for (auto range : ranges)
+    {
+        ListAllocator list(Buffers::KiB * 64);
+        TLSFAllocator tlsf(Buffers::KiB * 64);
+
+        double listTime = MixedSizeTrace(list, range[0], range[1]);
+        double tlsfTime = MixedSizeTrace(tlsf, range[0], range[1]);
+
+        printf("Sizes [%5u, %5u]: List: %10lfms | TLSF: %10lfms | TLSF total memory: %lu\n",
+               range[0], range[1], listTime, tlsfTime, tlsf.getTotalMemoryUsage());
+    }
+
+    printf("\n");
+}
+
+#endif //BERSERK_MEMORYPERFORMANCETEST_H
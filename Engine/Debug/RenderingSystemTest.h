@@ -9,6 +9,7 @@
 #include <Foundation/RenderSystem.h>
 #include <Memory/LinearAllocator.h>
 #include <Profiling/ProfilingUtility.h>
+#include <Memory/BuddyRangeAllocator.h>
 
 void MaterialImporterTest()
 {
@@ -19,6 +20,61 @@ void MaterialImporterTest()
 
 }
 
+void BuddyRangeAllocatorTest()
+{
+    using namespace Berserk;
+    using namespace Berserk::Resources;
+
+    BuddyRangeAllocator allocator(Buffers::MiB, Buffers::KiB);
+    BuddyRangeAllocator::Stats stats;
+
+    uint32 offsets[64];
+
+    for (uint32 i = 0; i < 64; i++)
+    {
+        offsets[i] = allocator.allocate(Buffers::KiB * (1 + i % 8), (i % 2 ? 256 : 4096));
+        printf("Allocate: %2u | offset: %7u | block: %6u \n", i, offsets[i], allocator.getBlockSize(offsets[i]));
+    }
+
+    // Leave holes in the range
+
+    for (uint32 i = 0; i < 64; i += 2)
+    {
+        allocator.free(offsets[i]);
+        offsets[i] = BuddyRangeAllocator::INVALID_OFFSET;
+    }
+
+    allocator.getStats(stats);
+    printf("Used: %u | free: %u | largest: %u | count: %u | fragmentation: %f \n",
+           stats.usedSize, stats.freeSize, stats.largestFreeBlock, stats.allocationsCount, stats.fragmentation);
+
+    // Defragmentation: move blocks to let buddies merge
+
+    uint32 source, destination, moved = 0;
+
+    while (allocator.relocate(source, destination))
+    {
+        for (uint32 i = 0; i < 64; i++)
+        {
+            if (offsets[i] == source) offsets[i] = destination;
+        }
+
+        allocator.free(source);
+        moved += 1;
+    }
+
+    allocator.getStats(stats);
+    printf("Moved: %u | used: %u | free: %u | largest: %u | count: %u | fragmentation: %f \n",
+           moved, stats.usedSize, stats.freeSize, stats.largestFreeBlock, stats.allocationsCount, stats.fragmentation);
+
+    for (uint32 i = 0; i < 64; i++)
+    {
+        if (offsets[i] != BuddyRangeAllocator::INVALID_OFFSET) allocator.free(offsets[i]);
+    }
+
+    printf("Can allocate whole range: %i \n", allocator.canAllocate(Buffers::MiB));
+}
+
 void RenderSystemStartUp()
 {
     using namespace Berserk;
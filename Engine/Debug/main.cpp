@@ -1,4 +1,5 @@
 #include "CoreTest.h"
+#include "MemoryPerformanceTest.h"
 #include "OpenGLDriverTest.h"
 #include "EntitySystemTest.h"
 #include "RenderingSystemTest.h"
@@ -11,23 +12,46 @@ int main()
     // OptionTest();
     // AssertTest();
     // AlignmentTest();
+    // Crc32Test();
+    // HashTest();
     // AllocatorTest();
     // ProxyAllocatorTest();
+    // BudgetedProxyAllocatorTest();
+    // TaggedHeapTest();
+    // ConcurrentPoolAllocatorTest();
+    // SmallObjectAllocatorTest();
+    // AlignedAllocationTest();
+    // TLSFAllocatorTest();
+    // VirtualArenaAllocatorTest();
+    // FrameAllocatorTest();
+    // AllocationStatsTest();
+    // RelocatableHeapTest();
+    // FrameAllocationCheckTest();
+    // TLSFAllocatorPerformance();
     // XMLTest();
     // StringUtilityTest();
     // StaticStringTest();
     // DynamicStringTest();
     // ArrayListTest();
+    // ArrayListEmplaceTest();
+    // SoAArrayTest();
+    // SlotMapTest();
     // SharedListTest();
     // LinkedListTest();
     // HashMapTest();
+    // OpenHashMapTest();
     // MathTest();
     // GeometryTest();
     // SIMDTest();
     // FrustumTest();
     // TransformTest();
     // ThreadTest();
+    // MPMCQueueTest();
+    // SPSCRingBufferTest();
+    // ConcurrentHashMapTest();
+    // JobSystemTest();
     // ThreadPoolTest();
+    // FutureTest();
     // FrustumCullingPerformance();
     // OperatorTest();
     // DynamicStringTest();
@@ -53,6 +77,7 @@ int main()
     /// Render System
 
     // MaterialImporterTest();
+    // BuddyRangeAllocatorTest();
     RenderSystemStartUp();
 
     return 0;
@@ -0,0 +1,416 @@
+//
+// Created by Egor Orachyov on 08.03.2019.
+//
+
+#include "JobSystem/JobSystem.h"
+#include "Memory/Allocator.h"
+#include "Logging/LogMacros.h"
+
+namespace Berserk
+{
+
+    static_assert(sizeof(Job) == CACHE_LINE_SIZE, "Job must occupy one cache line");
+
+    /** Job system and context index of the calling thread (one system per thread) */
+    struct ThreadRegistration
+    {
+        const JobSystem* system;
+        uint32 index;
+    };
+
+    static thread_local ThreadRegistration gThreadRegistration = { nullptr, 0 };
+
+    JobSystem::JobSystem(uint32 workersCount, uint32 jobsPerThread, IAllocator *allocator)
+            : mForeignJobs(jobsPerThread, allocator),
+              mPendingJobs(0),
+              mShutdown(false),
+              mSleepingWorkers(0),
+              mWaitingThreads(0)
+    {
+        FAIL(jobsPerThread >= WorkStealingDeque<Job*>::MIN_CAPACITY, "Jobs per thread must be more than %u", WorkStealingDeque<Job*>::MIN_CAPACITY);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        if (workersCount == 0)
+        {
+            uint32 cores = Thread::numberOfCores();
+            workersCount = (cores > 1 ? cores - 1 : 1);
+        }
+
+        mWorkersCount = workersCount;
+        mContextsCount = workersCount + 1;
+
+        mJobsPerThread = WorkStealingDeque<Job*>::MIN_CAPACITY;
+        while (mJobsPerThread < jobsPerThread) mJobsPerThread *= 2;
+
+        // Context 0 is for the thread created the system,
+        // the others are for the workers
+
+        mContexts = (ThreadContext*) mAllocator->allocate((mContextsCount + 1) * (uint32) sizeof(ThreadContext), CACHE_LINE_SIZE);
+        mForeignContext = &mContexts[mContextsCount];
+
+        for (uint32 i = 0; i <= mContextsCount; i++)
+        {
+            auto context = new (&mContexts[i]) ThreadContext((i < mContextsCount ? mJobsPerThread : WorkStealingDeque<Job*>::MIN_CAPACITY), mAllocator);
+            context->random = i * 2654435761u + 1;
+            expand(*context);
+        }
+
+        if (gThreadRegistration.system == nullptr)
+        {
+            gThreadRegistration.system = this;
+            gThreadRegistration.index = 0;
+        }
+
+        mWorkers = (Worker*) mAllocator->allocate(mWorkersCount * (uint32) sizeof(Worker));
+        mThreads = (Thread*) mAllocator->allocate(mWorkersCount * (uint32) sizeof(Thread));
+
+        for (uint32 i = 0; i < mWorkersCount; i++)
+        {
+            new (&mWorkers[i]) Worker();
+            new (&mThreads[i]) Thread();
+
+            mWorkers[i].mSystem = this;
+            mWorkers[i].mIndex = i + 1;
+        }
+
+        // All the contexts are ready before the first worker is started
+
+        for (uint32 i = 0; i < mWorkersCount; i++)
+        {
+            mThreads[i].run(&mWorkers[i]);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        if (mAllocator)
+        {
+            shutdown();
+
+            for (uint32 i = 0; i < mWorkersCount; i++)
+            {
+                mThreads[i].~Thread();
+                mWorkers[i].~Worker();
+            }
+
+            for (uint32 i = 0; i <= mContextsCount; i++)
+            {
+                auto& context = mContexts[i];
+
+                for (uint32 j = 0; j < context.pages.getSize(); j++)
+                {
+                    mAllocator->free(context.pages[j]);
+                }
+
+                context.~ThreadContext();
+            }
+
+            mAllocator->free(mThreads);
+            mAllocator->free(mWorkers);
+            mAllocator->free(mContexts);
+            mAllocator = nullptr;
+
+            if (gThreadRegistration.system == this)
+            {
+                gThreadRegistration.system = nullptr;
+            }
+        }
+    }
+
+    Job* JobSystem::create(IRunnable *runnable, Job *parent)
+    {
+        Job::Function function = [](JobSystem&, Job& job)
+        {
+            job.getData<IRunnable*>()->run();
+        };
+
+        return allocate(function, parent, &runnable, sizeof(IRunnable*));
+    }
+
+    void JobSystem::run(Job *job)
+    {
+        uint32 index = getThreadIndex();
+
+        // Pending counter is incremented before push: parking
+        // thread could not miss job, which is already in the deque
+
+        mPendingJobs.fetch_add(1);
+
+        bool pushed = (index == FOREIGN_THREAD ? mForeignJobs.tryPush(job) : mContexts[index].deque.push(job));
+
+        if (!pushed)
+        {
+            mPendingJobs.fetch_sub(1);
+            execute(job);
+            return;
+        }
+
+        if (mSleepingWorkers.load() > 0)
+        {
+            std::lock_guard<std::mutex> guard(mSleepMutex);
+            mWorkCondition.notify_one();
+        }
+        else if (mWaitingThreads.load() > 0)
+        {
+            std::lock_guard<std::mutex> guard(mSleepMutex);
+            mDoneCondition.notify_all();
+        }
+    }
+
+    void JobSystem::wait(const Job *job)
+    {
+        uint32 index = getThreadIndex();
+
+        while (job->mUnfinished.load() != 0)
+        {
+            Job* other = find(index);
+
+            if (other)
+            {
+                execute(other);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mWaitingThreads.fetch_add(1);
+
+            if (job->mUnfinished.load() != 0 && mPendingJobs.load() <= 0 && !mShutdown.load())
+            {
+                mDoneCondition.wait(lock);
+            }
+
+            mWaitingThreads.fetch_sub(1);
+        }
+    }
+
+    void JobSystem::shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> guard(mSleepMutex);
+            mShutdown.store(true);
+        }
+
+        mWorkCondition.notify_all();
+        mDoneCondition.notify_all();
+
+        for (uint32 i = 0; i < mWorkersCount; i++)
+        {
+            mThreads[i].join();
+        }
+    }
+
+    void JobSystem::terminate()
+    {
+        {
+            std::lock_guard<std::mutex> guard(mSleepMutex);
+            mShutdown.store(true);
+        }
+
+        mWorkCondition.notify_all();
+        mDoneCondition.notify_all();
+
+        for (uint32 i = 0; i < mWorkersCount; i++)
+        {
+            mThreads[i].daemon(true);
+        }
+    }
+
+    uint32 JobSystem::getMemoryUsage() const
+    {
+        uint32 usage = sizeof(JobSystem) +
+                       (mContextsCount + 1) * (uint32) sizeof(ThreadContext) +
+                       mWorkersCount * (uint32) (sizeof(Worker) + sizeof(Thread)) +
+                       mForeignJobs.getMemoryUsage();
+
+        for (uint32 i = 0; i <= mContextsCount; i++)
+        {
+            auto& context = mContexts[i];
+            usage += context.deque.getMemoryUsage() + context.pages.getMemoryUsage();
+            usage += context.pages.getSize() * mJobsPerThread * (uint32) sizeof(Job);
+        }
+
+        return usage;
+    }
+
+    uint32 JobSystem::getThreadIndex() const
+    {
+        return (gThreadRegistration.system == this ? gThreadRegistration.index : FOREIGN_THREAD);
+    }
+
+    Job* JobSystem::allocate(Job::Function function, Job *parent, const void *data, uint32 size)
+    {
+        uint32 index = getThreadIndex();
+        Job* job;
+
+        if (index == FOREIGN_THREAD)
+        {
+            std::lock_guard<std::mutex> guard(mForeignMutex);
+            job = acquire(*mForeignContext);
+        }
+        else
+        {
+            job = acquire(mContexts[index]);
+        }
+
+        job->mFunction = function;
+        job->mParent = parent;
+        job->mUnfinished.store(1, std::memory_order_relaxed);
+
+        if (parent) parent->mUnfinished.fetch_add(1, std::memory_order_relaxed);
+        if (size > 0) memcpy(job->mData, data, size);
+
+        return job;
+    }
+
+    Job* JobSystem::acquire(ThreadContext &context)
+    {
+        // Pool does not wait for jobs to be finished: slot could be taken
+        // by ancestor of the caller (or its parent), which waits for it
+
+        uint32 slots = context.pages.getSize() * mJobsPerThread;
+
+        for (uint32 i = 0; i < slots; i++)
+        {
+            uint32 slot = context.cursor;
+            context.cursor = (slot + 1 < slots ? slot + 1 : 0);
+
+            Job* job = &context.pages[slot / mJobsPerThread][slot & (mJobsPerThread - 1)];
+            if (job->isFinished()) return job;
+        }
+
+        expand(context);
+        context.cursor = slots + 1;
+
+        return &context.pages[slots / mJobsPerThread][0];
+    }
+
+    void JobSystem::expand(ThreadContext &context)
+    {
+        auto page = (Job*) mAllocator->allocate(mJobsPerThread * (uint32) sizeof(Job), CACHE_LINE_SIZE);
+
+        for (uint32 i = 0; i < mJobsPerThread; i++)
+        {
+            new (&page[i]) Job();
+        }
+
+        context.pages += page;
+    }
+
+    Job* JobSystem::find(uint32 index)
+    {
+        Job* job = nullptr;
+
+        if (index != FOREIGN_THREAD && mContexts[index].deque.pop(job))
+        {
+            mPendingJobs.fetch_sub(1);
+            return job;
+        }
+
+        if (mForeignJobs.tryPop(job))
+        {
+            mPendingJobs.fetch_sub(1);
+            return job;
+        }
+
+        // Victims are checked from random one: thieves
+        // do not contend for the same deque
+
+        uint32 start = 0;
+
+        if (index != FOREIGN_THREAD)
+        {
+            uint32& random = mContexts[index].random;
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+            start = random;
+        }
+
+        for (uint32 i = 0; i < mContextsCount; i++)
+        {
+            uint32 victim = (start + i) % mContextsCount;
+
+            if (victim != index && mContexts[victim].deque.steal(job))
+            {
+                mPendingJobs.fetch_sub(1);
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::execute(Job *job)
+    {
+        job->mFunction(*this, *job);
+        finish(job);
+    }
+
+    void JobSystem::finish(Job *job)
+    {
+        bool finished = false;
+
+        // Parent is read before decrement: finished job could be reused at once
+
+        while (job != nullptr)
+        {
+            Job* parent = job->mParent;
+            if (job->mUnfinished.fetch_sub(1) != 1) break;
+
+            finished = true;
+            job = parent;
+        }
+
+        if (finished && mWaitingThreads.load() > 0)
+        {
+            std::lock_guard<std::mutex> guard(mSleepMutex);
+            mDoneCondition.notify_all();
+        }
+    }
+
+    void JobSystem::work(uint32 index)
+    {
+        gThreadRegistration.system = this;
+        gThreadRegistration.index = index;
+
+        uint32 idle = 0;
+
+        while (!mShutdown.load(std::memory_order_acquire))
+        {
+            Job* job = find(index);
+
+            if (job)
+            {
+                execute(job);
+                idle = 0;
+                continue;
+            }
+
+            if (++idle < SPIN_COUNT)
+            {
+                Thread::yield();
+                continue;
+            }
+
+            // Sleeping counter is changed under lock: submitting thread
+            // either sees it and notifies or its job is seen here
+
+            idle = 0;
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mSleepingWorkers.fetch_add(1);
+
+            if (mPendingJobs.load() <= 0 && !mShutdown.load())
+            {
+                mWorkCondition.wait(lock);
+            }
+
+            mSleepingWorkers.fetch_sub(1);
+        }
+
+        gThreadRegistration.system = nullptr;
+    }
+
+} // namespace Berserk
@@ -100,7 +100,7 @@ namespace Berserk
             planes_w[i] = SIMD4_FLOAT32_SET1(mPlanes[i].mW);
         }
 
-        for (uint32 i = 0; i <= num - 4; i += 4)
+        for (uint32 i = 0; i + 4 <= num; i += 4)
         {
             /* Suppose that all points in the frustum */
 
@@ -156,7 +156,7 @@ namespace Berserk
             planes_w[i] = SIMD4_FLOAT32_SET1(mPlanes[i].mW);
         }
 
-        for (uint32 i = 0; i <= num - 4; i+= 4)
+        for (uint32 i = 0; i + 4 <= num; i += 4)
         {
             /* Suppose that all spheres in the frustum */
 
@@ -213,7 +213,7 @@ namespace Berserk
             planes_w[i] = SIMD4_FLOAT32_SET1(mPlanes[i].mW);
         }
 
-        for (uint32 i = 0; i <= num - 4; i += 4)
+        for (uint32 i = 0; i + 4 <= num; i += 4)
         {
             /* Suppose that all boxes in the frustum */
 
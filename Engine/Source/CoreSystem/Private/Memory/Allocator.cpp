@@ -6,57 +6,402 @@
 #include "Misc/Alignment.h"
 #include "Memory/Allocator.h"
 #include "Profiling/ProfilingUtility.h"
+#include "Profiling/FrameAllocationCheck.h"
 
 namespace Berserk
 {
 
-    Allocator::Allocator() : IAllocator()
+    Allocator::Allocator() : IAllocator(), mCaches(nullptr)
     {
-        /** Do actually nothing */
+        setStatsName("Allocator");
+
+        for (uint32 i = 0; i < SIZE_CLASSES_COUNT; i++)
+        {
+            uint32 size;
+
+            if (i < 8)
+            {
+                size = (i + 1) * Buffers::SIZE_16;
+            }
+            else
+            {
+                uint32 power = 7 + (i - 8) / 4;
+                uint32 step = 1u << (power - 2);
+                size = (1u << power) + ((i - 8) % 4 + 1) * step;
+            }
+
+            uint32 batch = SPAN_SIZE / 4 / size;
+            if (batch < 2) batch = 2;
+            if (batch > MAX_BATCH_COUNT) batch = MAX_BATCH_COUNT;
+
+            mClassSize[i] = size;
+            mClassBatch[i] = batch;
+
+            mCentral[i].head = nullptr;
+            mCentral[i].spans = nullptr;
+            mCentral[i].length = 0;
+        }
     }
 
     Allocator::~Allocator()
     {
-        /** Do actually nothing */
+        /** Spans are kept until process exit: static objects could still free memory */
 #if DEBUG
         char buffer[20];
         printf("======================================================================================================================= Alloc-calls: %u | Free-calls %u | Total: %10s\n",
-               mAllocCalls, mFreeCalls, ProfilingUtility::print((uint32)getTotalMemoryUsage(), buffer));
+               getAllocateCalls(), getFreeCalls(), ProfilingUtility::print((uint32)getTotalMemoryUsage(), buffer));
 #endif
     }
 
     void* Allocator::allocate(uint32 size)
     {
 #ifdef VIRTUAL_MEMORY
+        FrameAllocationCheck::onAllocate(size);
         ALIGN(size);
-        void* pointer = malloc(size);
-        FAIL(pointer != nullptr, "Core: cannot malloc memory (size: %lu)", size);
+        uint64 total = (uint64)size + sizeof(Header);
+        Header* header;
+
+        auto cache = getThreadCache();
+
+        if (total <= MAX_SMALL_SIZE)
+        {
+            auto sizeClass = getSizeClass((uint32)total);
+
+            if (cache)
+            {
+                FreeList& list = cache->lists[sizeClass];
+                if (list.head == nullptr) fetchFromCentral(sizeClass, list);
+
+                auto object = list.head;
+                list.head = object->next;
+                list.length -= 1;
+
+                header = (Header*) object;
+            }
+            else
+            {
+                FreeList list = { nullptr, 0 };
+                fetchFromCentral(sizeClass, list);
+
+                header = (Header*) list.head;
+                list.head = list.head->next;
+                list.length -= 1;
+
+                if (list.length > 0) releaseToCentral(sizeClass, list, list.length);
+            }
 
-        mAllocCalls += 1;
-        mTotalMemUsage += size;
+            header->sizeClass = sizeClass;
+            header->size = mClassSize[sizeClass];
+        }
+        else
+        {
+            header = (Header*) malloc(total);
+            FAIL(header != nullptr, "Core: cannot malloc memory (size: %lu)", total);
+
+            header->sizeClass = LARGE_CLASS;
+            header->size = total;
+        }
+
+        if (cache)
+        {
+            increment(cache->allocCalls, 1);
+            increment(cache->totalMemUsage, size);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> guard(mCachesMutex);
+            mAllocCalls += 1;
+            mTotalMemUsage += size;
+        }
+
+        header->tag = AllocationStats::getThreadTag();
+        trackAllocate(header->size);
 
 #if PROFILE_SYSTEM_ALLOCATOR
         char buffer[20];
         printf("======================================================================================================================= Alloc-calls: %u | Free-calls %u | Total: %10s\n",
-               mAllocCalls, mFreeCalls, ProfilingUtility::print((uint32)getTotalMemoryUsage(), buffer));
+               getAllocateCalls(), getFreeCalls(), ProfilingUtility::print((uint32)getTotalMemoryUsage(), buffer));
 #endif
 
-        return pointer;
+        return (uint8*)header + sizeof(Header);
 #endif
     }
 
+    void* Allocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+        if (alignment <= MEMORY_ALIGNMENT) return allocate(size);
+
+        auto original = (uint8*) allocate(size + alignment + sizeof(Header));
+        auto aligned = alignPointer(original + sizeof(Header), alignment);
+
+        auto header = (Header*) (aligned - sizeof(Header));
+        header->sizeClass = ALIGNED_CLASS;
+        header->size = (uint64) original;
+
+        return aligned;
+    }
+
     void Allocator::free(void *pointer)
     {
 #ifdef VIRTUAL_MEMORY
-        ::free(pointer);
-        mFreeCalls += 1;
+        if (pointer == nullptr) return;
+
+        auto header = (Header*) ((uint8*)pointer - sizeof(Header));
+
+        if (header->sizeClass == ALIGNED_CLASS)
+        {
+            pointer = (void*) header->size;
+            header = (Header*) ((uint8*)pointer - sizeof(Header));
+        }
+        auto cache = getThreadCache();
+        trackFree(header->size, header->tag);
+
+        if (header->sizeClass == LARGE_CLASS)
+        {
+            ::free(header);
+        }
+        else if (cache)
+        {
+            auto sizeClass = header->sizeClass;
+            auto object = (Object*) header;
+
+            FreeList& list = cache->lists[sizeClass];
+            object->next = list.head;
+            list.head = object;
+            list.length += 1;
+
+            if (list.length > 2 * mClassBatch[sizeClass])
+            {
+                releaseToCentral(sizeClass, list, mClassBatch[sizeClass]);
+            }
+        }
+        else
+        {
+            auto object = (Object*) header;
+            object->next = nullptr;
+
+            FreeList list = { object, 1 };
+            releaseToCentral(header->sizeClass, list, 1);
+        }
+
+        if (cache)
+        {
+            increment(cache->freeCalls, 1);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> guard(mCachesMutex);
+            mFreeCalls += 1;
+        }
 #endif
     }
 
+    uint32 Allocator::getFreeCalls() const
+    {
+        std::lock_guard<std::mutex> guard(mCachesMutex);
+
+        uint64 result = mFreeCalls;
+        for (auto cache = mCaches; cache != nullptr; cache = cache->next)
+        {
+            result += cache->freeCalls.load(std::memory_order_relaxed);
+        }
+
+        return (uint32) result;
+    }
+
+    uint32 Allocator::getAllocateCalls() const
+    {
+        std::lock_guard<std::mutex> guard(mCachesMutex);
+
+        uint64 result = mAllocCalls;
+        for (auto cache = mCaches; cache != nullptr; cache = cache->next)
+        {
+            result += cache->allocCalls.load(std::memory_order_relaxed);
+        }
+
+        return (uint32) result;
+    }
+
+    uint64 Allocator::getTotalMemoryUsage() const
+    {
+        std::lock_guard<std::mutex> guard(mCachesMutex);
+
+        uint64 result = mTotalMemUsage;
+        for (auto cache = mCaches; cache != nullptr; cache = cache->next)
+        {
+            result += cache->totalMemUsage.load(std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
     Allocator& Allocator::getSingleton()
     {
         static Allocator allocator;
         return allocator;
     }
 
-}
\ No newline at end of file
+    uint32 Allocator::getSizeClass(uint32 size)
+    {
+        if (size <= Buffers::SIZE_128)
+        {
+            return (size >> 4) - 1;
+        }
+
+        // size - 1 lays in [2^power, 2^(power + 1)), which is split in 4 classes
+
+        uint32 power = 31 - __builtin_clz(size - 1);
+        uint32 sub = ((size - 1) >> (power - 2)) & 0x3;
+
+        return 8 + (power - 7) * 4 + sub;
+    }
+
+    Allocator::ThreadCache* Allocator::getThreadCache()
+    {
+        if (THREAD_CACHE) return THREAD_CACHE;
+        if (THREAD_CACHE_RELEASED) return nullptr;
+
+        // Cache itself is not allocated via engine allocators
+        // to avoid recursion on thread start
+
+        auto memory = malloc(sizeof(ThreadCache));
+        FAIL(memory != nullptr, "Core: cannot malloc memory (size: %lu)", sizeof(ThreadCache));
+
+        auto cache = new (memory) ThreadCache();
+        for (uint32 i = 0; i < SIZE_CLASSES_COUNT; i++)
+        {
+            cache->lists[i].head = nullptr;
+            cache->lists[i].length = 0;
+        }
+
+        cache->allocCalls.store(0, std::memory_order_relaxed);
+        cache->freeCalls.store(0, std::memory_order_relaxed);
+        cache->totalMemUsage.store(0, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> guard(mCachesMutex);
+
+            cache->prev = nullptr;
+            cache->next = mCaches;
+            if (mCaches) mCaches->prev = cache;
+            mCaches = cache;
+        }
+
+        // Odr-use of holder registers its destructor for this thread
+        (void) &THREAD_CACHE_HOLDER;
+
+        THREAD_CACHE = cache;
+        return cache;
+    }
+
+    void Allocator::fetchFromCentral(uint32 sizeClass, FreeList &list)
+    {
+        CentralList& central = mCentral[sizeClass];
+        uint32 size = mClassSize[sizeClass];
+        uint32 batch = mClassBatch[sizeClass];
+
+        std::lock_guard<std::mutex> guard(central.mutex);
+
+        if (central.length < batch)
+        {
+            uint64 spanSize = sizeof(Span) + (uint64)size * batch;
+            if (spanSize < SPAN_SIZE) spanSize = SPAN_SIZE;
+
+            auto span = (Span*) malloc(spanSize);
+            FAIL(span != nullptr, "Core: cannot malloc memory (size: %lu)", spanSize);
+
+            span->size = spanSize;
+            span->next = central.spans;
+            central.spans = span;
+
+            auto current = (uint8*)span + sizeof(Span);
+            auto end = (uint8*)span + spanSize;
+
+            while (current + size <= end)
+            {
+                auto object = (Object*) current;
+                object->next = central.head;
+                central.head = object;
+                central.length += 1;
+                current += size;
+            }
+        }
+
+        for (uint32 i = 0; i < batch; i++)
+        {
+            auto object = central.head;
+            central.head = object->next;
+            central.length -= 1;
+
+            object->next = list.head;
+            list.head = object;
+            list.length += 1;
+        }
+    }
+
+    void Allocator::releaseToCentral(uint32 sizeClass, FreeList &list, uint32 count)
+    {
+        // Detach chain of count objects without lock
+
+        auto first = list.head;
+        auto last = first;
+
+        for (uint32 i = 1; i < count; i++)
+        {
+            last = last->next;
+        }
+
+        list.head = last->next;
+        list.length -= count;
+
+        CentralList& central = mCentral[sizeClass];
+        std::lock_guard<std::mutex> guard(central.mutex);
+
+        last->next = central.head;
+        central.head = first;
+        central.length += count;
+    }
+
+    void Allocator::releaseThreadCache(ThreadCache *cache)
+    {
+        for (uint32 i = 0; i < SIZE_CLASSES_COUNT; i++)
+        {
+            FreeList& list = cache->lists[i];
+            if (list.length > 0) releaseToCentral(i, list, list.length);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mCachesMutex);
+
+            mAllocCalls += cache->allocCalls.load(std::memory_order_relaxed);
+            mFreeCalls += cache->freeCalls.load(std::memory_order_relaxed);
+            mTotalMemUsage += cache->totalMemUsage.load(std::memory_order_relaxed);
+
+            if (cache->prev) cache->prev->next = cache->next;
+            else mCaches = cache->next;
+            if (cache->next) cache->next->prev = cache->prev;
+        }
+
+        cache->~ThreadCache();
+        ::free(cache);
+    }
+
+    Allocator::ThreadCacheHolder::~ThreadCacheHolder()
+    {
+        if (THREAD_CACHE)
+        {
+            Allocator::getSingleton().releaseThreadCache(THREAD_CACHE);
+            THREAD_CACHE = nullptr;
+        }
+
+        THREAD_CACHE_RELEASED = true;
+    }
+
+    thread_local Allocator::ThreadCache* Allocator::THREAD_CACHE = nullptr;
+
+    thread_local bool Allocator::THREAD_CACHE_RELEASED = false;
+
+    thread_local Allocator::ThreadCacheHolder Allocator::THREAD_CACHE_HOLDER;
+
+}
@@ -0,0 +1,314 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Alignment.h"
+#include "Logging/LogMacros.h"
+#include "Memory/Allocator.h"
+#include "Memory/ConcurrentPoolAllocator.h"
+
+namespace Berserk
+{
+
+    ConcurrentPoolAllocator::ConcurrentPoolAllocator() : PoolAllocator(), mMagazineSize(0), mDepot(0)
+    {
+        for (uint32 i = 0; i <= MAX_THREADS_COUNT; i++)
+        {
+            Slot& slot = mSlots[i];
+            slot.loaded = nullptr;
+            slot.previous = nullptr;
+            slot.loadedCount = 0;
+            slot.previousCount = 0;
+            slot.allocCalls.store(0, std::memory_order_relaxed);
+            slot.freeCalls.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentPoolAllocator::ConcurrentPoolAllocator(uint32 chunkSize, uint32 chunkCount, IAllocator *allocator, uint32 alignment)
+            : ConcurrentPoolAllocator()
+    {
+        FAIL(chunkSize >= MIN_CHUNK_SIZE, "Chunk size must be more minimum size %u", MIN_CHUNK_SIZE);
+        FAIL(chunkCount >= MIN_CHUNK_COUNT, "Chunks count must be more than minimum count %u", MIN_CHUNK_COUNT);
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+
+        ALIGN(chunkSize);
+        if (alignment < MEMORY_ALIGNMENT) alignment = MEMORY_ALIGNMENT;
+
+        mChunkSize = (chunkSize + alignment - 1) & ~(alignment - 1);
+        mChunkCount = chunkCount;
+        mAlignment = alignment;
+        mMagazineSize = (chunkCount < MAGAZINE_SIZE ? chunkCount : MAGAZINE_SIZE);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+    }
+
+    void* ConcurrentPoolAllocator::allocate(uint32)
+    {
+        auto index = getThreadSlot();
+
+        if (index == OVERFLOW_SLOT)
+        {
+            std::lock_guard<std::mutex> guard(mOverflowMutex);
+            return allocateChunk(mSlots[OVERFLOW_SLOT]);
+        }
+
+        return allocateChunk(mSlots[index]);
+    }
+
+    void ConcurrentPoolAllocator::free(void *pointer)
+    {
+        auto index = getThreadSlot();
+
+        if (index == OVERFLOW_SLOT)
+        {
+            std::lock_guard<std::mutex> guard(mOverflowMutex);
+            freeChunk(mSlots[OVERFLOW_SLOT], (Chunk*) pointer);
+            return;
+        }
+
+        freeChunk(mSlots[index], (Chunk*) pointer);
+    }
+
+    uint32 ConcurrentPoolAllocator::getFreeCalls() const
+    {
+        uint64 result = 0;
+        for (uint32 i = 0; i <= MAX_THREADS_COUNT; i++)
+        {
+            result += mSlots[i].freeCalls.load(std::memory_order_relaxed);
+        }
+
+        return (uint32) result;
+    }
+
+    uint32 ConcurrentPoolAllocator::getAllocateCalls() const
+    {
+        uint64 result = 0;
+        for (uint32 i = 0; i <= MAX_THREADS_COUNT; i++)
+        {
+            result += mSlots[i].allocCalls.load(std::memory_order_relaxed);
+        }
+
+        return (uint32) result;
+    }
+
+    uint64 ConcurrentPoolAllocator::getTotalMemoryUsage() const
+    {
+        std::lock_guard<std::mutex> guard(mBufferMutex);
+        return mTotalMemUsage;
+    }
+
+    uint32 ConcurrentPoolAllocator::getUsage() const
+    {
+        return (getAllocateCalls() - getFreeCalls()) * mChunkSize;
+    }
+
+    void* ConcurrentPoolAllocator::allocateChunk(Slot &slot)
+    {
+        if (slot.loadedCount == 0)
+        {
+            if (slot.previousCount == mMagazineSize)
+            {
+                // Previous magazine is full: just swap with empty one
+
+                slot.loaded = slot.previous;
+                slot.loadedCount = slot.previousCount;
+                slot.previous = nullptr;
+                slot.previousCount = 0;
+            }
+            else
+            {
+                auto magazine = pop();
+
+                if (magazine)
+                {
+                    slot.loaded = magazine;
+                    slot.loadedCount = mMagazineSize;
+                }
+                else
+                {
+                    std::lock_guard<std::mutex> guard(mBufferMutex);
+                    expand(slot);
+                }
+            }
+        }
+
+        auto chunk = slot.loaded;
+        slot.loaded = chunk->next;
+        slot.loadedCount -= 1;
+
+        slot.allocCalls.store(slot.allocCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        trackAllocate(mChunkSize);
+
+        return chunk;
+    }
+
+    void ConcurrentPoolAllocator::freeChunk(Slot &slot, Chunk *chunk)
+    {
+        if (slot.loadedCount == mMagazineSize)
+        {
+            if (slot.previousCount != 0)
+            {
+                // Both magazines are full: share one of them with other threads
+
+                push(slot.previous);
+            }
+
+            slot.previous = slot.loaded;
+            slot.previousCount = slot.loadedCount;
+            slot.loaded = nullptr;
+            slot.loadedCount = 0;
+        }
+
+        chunk->next = slot.loaded;
+        slot.loaded = chunk;
+        slot.loadedCount += 1;
+
+        slot.freeCalls.store(slot.freeCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        trackFree(mChunkSize);
+    }
+
+    void ConcurrentPoolAllocator::expand(Slot &slot)
+    {
+        // Other thread could fill depot while this one waited for lock
+
+        auto magazine = pop();
+
+        if (magazine)
+        {
+            slot.loaded = magazine;
+            slot.loadedCount = mMagazineSize;
+            return;
+        }
+
+        auto bufferSize = getBufferHeaderSize() + mChunkSize * mChunkCount;
+        auto buffer = (Buffer*) mAllocator->allocate(bufferSize, mAlignment);
+        buffer->size = bufferSize;
+        buffer->next = mBuffer;
+        mBuffer = buffer;
+
+        // The first magazine (possibly not full) goes to the slot,
+        // other full magazines are placed in the depot
+
+        auto chunks = (uint8*)buffer + getBufferHeaderSize();
+        uint32 first = mChunkCount % mMagazineSize;
+        if (first == 0) first = mMagazineSize;
+
+        uint32 index = 0;
+        while (index < mChunkCount)
+        {
+            uint32 count = (index == 0 ? first : mMagazineSize);
+            auto head = (Chunk*)(chunks + index * mChunkSize);
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                auto current = (Chunk*)(chunks + (index + i) * mChunkSize);
+                current->next = (i + 1 < count ? (Chunk*)((uint8*)current + mChunkSize) : nullptr);
+            }
+
+            if (index == 0)
+            {
+                slot.loaded = head;
+                slot.loadedCount = count;
+            }
+            else
+            {
+                push(head);
+            }
+
+            index += count;
+        }
+
+        mTotalMemUsage += mChunkCount * mChunkSize;
+
+#if PROFILE_POOL_ALLOCATOR
+        PUSH("ConcurrentPoolAllocator: expand: total: %lu | chunk size: %u | chunk count: %u | buffer size: %lu",
+             mTotalMemUsage, mChunkSize, mChunkCount, bufferSize);
+#endif
+    }
+
+    void ConcurrentPoolAllocator::push(Chunk *magazine)
+    {
+        auto head = mDepot.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            magazine->nextMagazine = (Chunk*)(head & POINTER_MASK);
+            uint64 updated = (((head >> TAG_SHIFT) + 1) << TAG_SHIFT) | (uint64)magazine;
+
+            if (mDepot.compare_exchange_weak(head, updated, std::memory_order_release, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    ConcurrentPoolAllocator::Chunk* ConcurrentPoolAllocator::pop()
+    {
+        auto head = mDepot.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            auto magazine = (Chunk*)(head & POINTER_MASK);
+            if (magazine == nullptr) return nullptr;
+
+            // Buffers are not released while pool is alive, therefore the read
+            // is safe even if magazine is already taken by other thread (CAS fails)
+
+            auto next = magazine->nextMagazine;
+            uint64 updated = (((head >> TAG_SHIFT) + 1) << TAG_SHIFT) | (uint64)next;
+
+            if (mDepot.compare_exchange_weak(head, updated, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return magazine;
+            }
+        }
+    }
+
+    uint32 ConcurrentPoolAllocator::getThreadSlot()
+    {
+        if (THREAD_SLOT != NO_SLOT) return THREAD_SLOT;
+        if (THREAD_SLOT_RELEASED) return OVERFLOW_SLOT;
+
+        auto mask = SLOTS_MASK.load(std::memory_order_relaxed);
+
+        while (mask != 0xffffffff)
+        {
+            uint32 index = __builtin_ctz(~mask);
+
+            // Acquire: see magazines state, left by the previous owner of the slot
+
+            if (SLOTS_MASK.compare_exchange_weak(mask, mask | (1u << index), std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                // Odr-use of holder registers its destructor for this thread
+                (void) &THREAD_SLOT_HOLDER;
+
+                THREAD_SLOT = index;
+                return index;
+            }
+        }
+
+        return OVERFLOW_SLOT;
+    }
+
+    ConcurrentPoolAllocator::SlotHolder::~SlotHolder()
+    {
+        if (THREAD_SLOT != NO_SLOT)
+        {
+            SLOTS_MASK.fetch_and(~(1u << THREAD_SLOT), std::memory_order_release);
+            THREAD_SLOT = NO_SLOT;
+        }
+
+        THREAD_SLOT_RELEASED = true;
+    }
+
+    std::atomic<uint32> ConcurrentPoolAllocator::SLOTS_MASK(0);
+
+    thread_local uint32 ConcurrentPoolAllocator::THREAD_SLOT = ConcurrentPoolAllocator::NO_SLOT;
+
+    thread_local bool ConcurrentPoolAllocator::THREAD_SLOT_RELEASED = false;
+
+    thread_local ConcurrentPoolAllocator::SlotHolder ConcurrentPoolAllocator::THREAD_SLOT_HOLDER;
+
+} // namespace Berserk
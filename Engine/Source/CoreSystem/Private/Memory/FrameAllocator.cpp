@@ -0,0 +1,197 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include <thread>
+#include "Misc/Assert.h"
+#include "Misc/Alignment.h"
+#include "Logging/LogMacros.h"
+#include "Memory/Allocator.h"
+#include "Memory/FrameAllocator.h"
+
+namespace Berserk
+{
+
+    FrameAllocator::FrameAllocator(uint32 frameSize, uint32 framesCount, IAllocator *allocator)
+            : IAllocator(),
+              mCurrent(nullptr),
+              mCurrentFrame(0),
+              mRetiredFrames(0),
+              mFrameAllocCalls(0),
+              mFrameFreeCalls(0)
+    {
+        FAIL(frameSize >= MIN_FRAME_SIZE, "Frame size must be more than minimum size %u", MIN_FRAME_SIZE);
+        FAIL(framesCount >= 1 && framesCount <= MAX_FRAMES_COUNT, "Frames count must be in range [1, %u]", MAX_FRAMES_COUNT);
+
+        // Arenas start on cache line boundary: threads, which
+        // allocate in different frames, do not share lines
+
+        frameSize = (frameSize + Buffers::SIZE_64 - 1) & ~(Buffers::SIZE_64 - 1);
+
+        mFrameSize = frameSize;
+        mFramesCount = framesCount;
+        mTotalMemUsage = (uint64)frameSize * framesCount;
+
+        FAIL(mTotalMemUsage <= 0xffffffff, "FrameAllocator: an attempt to allocate too big buffer %lu", mTotalMemUsage);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mBuffer = mAllocator->allocate((uint32)mTotalMemUsage, Buffers::SIZE_64);
+
+        for (uint32 i = 0; i < MAX_FRAMES_COUNT; i++)
+        {
+            Arena& arena = mArenas[i];
+            arena.offset.store(0, std::memory_order_relaxed);
+            arena.buffer = (i < framesCount ? (uint8*)mBuffer + (uint64)i * frameSize : nullptr);
+            arena.frame = 0;
+            arena.peak = 0;
+        }
+
+        activate(0);
+    }
+
+    FrameAllocator::~FrameAllocator()
+    {
+        if (mBuffer)
+        {
+#if PROFILE_FRAME_ALLOCATOR
+            PUSH("FrameAllocator: delete: frames: %lu | frame size: %u | peak usage: %lu",
+                 getCurrentFrame() + 1, mFrameSize, getPeakUsage());
+#endif
+
+            mAllocator->free(mBuffer);
+            mBuffer = nullptr;
+        }
+    }
+
+    void* FrameAllocator::allocate(uint32 size)
+    {
+        ALIGN(size);
+
+        auto arena = mCurrent.load(std::memory_order_acquire);
+        auto offset = arena->offset.fetch_add(size, std::memory_order_relaxed);
+
+        FAIL(offset + size <= mFrameSize, "FrameAllocator: cannot allocate memory. Frame %lu is full (size: %u)",
+             arena->frame, size);
+
+        mFrameAllocCalls.fetch_add(1, std::memory_order_relaxed);
+        trackAllocate(size);
+
+        return arena->buffer + offset;
+    }
+
+    void* FrameAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+        ALIGN(size);
+
+        auto arena = mCurrent.load(std::memory_order_acquire);
+        auto offset = arena->offset.load(std::memory_order_relaxed);
+        uint64 start;
+
+        do
+        {
+            start = (uint64)(alignPointer(arena->buffer + offset, alignment) - arena->buffer);
+
+            FAIL(start + size <= mFrameSize, "FrameAllocator: cannot allocate memory. Frame %lu is full (size: %u)",
+                 arena->frame, size);
+        }
+        while (!arena->offset.compare_exchange_weak(offset, start + size, std::memory_order_relaxed));
+
+        mFrameAllocCalls.fetch_add(1, std::memory_order_relaxed);
+        trackAllocate(start + size - offset);
+
+        return arena->buffer + start;
+    }
+
+    uint64 FrameAllocator::beginFrame()
+    {
+        auto next = mCurrentFrame.load(std::memory_order_relaxed) + 1;
+
+        // Arena is used by frame next - N, wait for its consumers
+
+        while (next >= mRetiredFrames.load(std::memory_order_acquire) + mFramesCount)
+        {
+            std::this_thread::yield();
+        }
+
+        activate(next);
+        return next;
+    }
+
+    bool FrameAllocator::tryBeginFrame()
+    {
+        auto next = mCurrentFrame.load(std::memory_order_relaxed) + 1;
+
+        if (next >= mRetiredFrames.load(std::memory_order_acquire) + mFramesCount)
+        {
+            return false;
+        }
+
+        activate(next);
+        return true;
+    }
+
+    void FrameAllocator::retireFrame()
+    {
+        auto retired = mRetiredFrames.load(std::memory_order_relaxed);
+        FAIL(retired <= mCurrentFrame.load(std::memory_order_acquire), "FrameAllocator: all started frames are retired");
+
+        // Release: accesses to frame data happen before its arena reset
+
+        mRetiredFrames.store(retired + 1, std::memory_order_release);
+    }
+
+    uint64 FrameAllocator::getUsage() const
+    {
+        auto offset = mCurrent.load(std::memory_order_acquire)->offset.load(std::memory_order_relaxed);
+        return (offset < mFrameSize ? offset : mFrameSize);
+    }
+
+    uint64 FrameAllocator::getPeakUsage() const
+    {
+        uint64 result = 0;
+
+        for (uint32 i = 0; i < mFramesCount; i++)
+        {
+            auto offset = mArenas[i].offset.load(std::memory_order_relaxed);
+            if (offset > mFrameSize) offset = mFrameSize;
+            if (offset > result) result = offset;
+            if (mArenas[i].peak > result) result = mArenas[i].peak;
+        }
+
+        return result;
+    }
+
+    uint32 FrameAllocator::getFreeCalls() const
+    {
+        return mFrameFreeCalls.load(std::memory_order_relaxed);
+    }
+
+    uint32 FrameAllocator::getAllocateCalls() const
+    {
+        return mFrameAllocCalls.load(std::memory_order_relaxed);
+    }
+
+    void FrameAllocator::activate(uint64 frame)
+    {
+        Arena& arena = mArenas[frame % mFramesCount];
+
+        auto offset = arena.offset.load(std::memory_order_relaxed);
+        if (offset > mFrameSize) offset = mFrameSize;
+        if (offset > arena.peak) arena.peak = offset;
+        trackFree(offset);
+
+        arena.offset.store(0, std::memory_order_relaxed);
+        arena.frame = frame;
+
+        mCurrent.store(&arena, std::memory_order_release);
+        mCurrentFrame.store(frame, std::memory_order_release);
+
+#if PROFILE_FRAME_ALLOCATOR
+        PUSH("FrameAllocator: begin frame: %lu | arena: %lu | last usage: %lu", frame, frame % mFramesCount, offset);
+#endif
+    }
+
+} // namespace Berserk
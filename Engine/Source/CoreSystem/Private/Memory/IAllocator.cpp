@@ -2,17 +2,28 @@
 // Created by Egor Orachyov on 20.03.2019.
 //
 
+#include "Misc/Assert.h"
+#include "Misc/Alignment.h"
 #include "Memory/IAllocator.h"
 
 namespace Berserk
 {
-    IAllocator::IAllocator() : mAllocCalls(0),
+    IAllocator::IAllocator() : mStatsChannel(AllocationStats::NO_CHANNEL),
+                               mAllocCalls(0),
                                mFreeCalls(0),
                                mTotalMemUsage(0)
     {
 
     }
 
+    void* IAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+        FAIL(alignment <= MEMORY_ALIGNMENT, "Allocator does not support alignment %u", alignment);
+
+        return allocate(size);
+    }
+
     uint32 IAllocator::getFreeCalls() const
     {
         return mFreeCalls;
@@ -18,14 +18,35 @@ namespace Berserk
         mUsage = 0;
         mTotalMemUsage = size;
 
-        if (allocator) mAllocator = allocator;
-        else mAllocator = &Allocator::getSingleton();
+        if (allocator)
+        {
+            mAllocator = allocator;
+            mArena = nullptr;
+            mBuffer = mAllocator->allocate(size);
+        }
+        else
+        {
+            // Only address range is reserved: pages are committed on demand
 
-        mBuffer = mAllocator->allocate(size);
+            mAllocator = &Allocator::getSingleton();
+            mArena = new (mAllocator->allocate(sizeof(VirtualArenaAllocator))) VirtualArenaAllocator(size);
+            mBuffer = nullptr;
+        }
     }
 
     LinearAllocator::~LinearAllocator()
     {
+        if (mArena)
+        {
+            mArena->~VirtualArenaAllocator();
+            mAllocator->free(mArena);
+            mArena = nullptr;
+
+#if PROFILE_LINEAR_ALLOCATOR
+            printf("Linear allocator: delete arena %lu\n", mTotalMemUsage);
+#endif
+        }
+
         if (mBuffer)
         {
             mAllocator->free(mBuffer);
@@ -39,12 +60,34 @@ namespace Berserk
 
     void* LinearAllocator::allocate(uint32 size)
     {
+        return allocate(size, MEMORY_ALIGNMENT);
+    }
+
+    void* LinearAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
         ALIGN(size);
-        FAIL(mUsage + size <= mTotalMemUsage, "Cannot allocate memory. Buffer is full");
 
-        auto pointer = (void*)((uint8*)mBuffer + mUsage);
-        mUsage += size;
+        uint8* pointer;
+        uint64 end;
 
+        if (mArena)
+        {
+            pointer = (uint8*) mArena->allocate(size, alignment);
+            end = mArena->getUsage();
+        }
+        else
+        {
+            auto base = (uint8*) mBuffer;
+            pointer = alignPointer(base + mUsage, alignment);
+            end = (uint64)(pointer - base) + size;
+        }
+
+        FAIL(end <= mTotalMemUsage, "Cannot allocate memory. Buffer is full");
+
+        trackAllocate(end - mUsage);
+
+        mUsage = (uint32) end;
         mAllocCalls += 1;
 
         return pointer;
@@ -52,6 +95,9 @@ namespace Berserk
 
     void LinearAllocator::clear()
     {
+        if (mArena) mArena->clear();
+
+        trackFree(mUsage);
         mUsage = 0;
     }
 
@@ -60,4 +106,4 @@ namespace Berserk
         return mUsage;
     }
 
-}
\ No newline at end of file
+}
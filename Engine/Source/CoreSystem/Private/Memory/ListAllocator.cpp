@@ -61,20 +61,23 @@ namespace Berserk
         }
 
         auto current = mChunk;
-        auto best = mChunk;
+        Chunk* best = nullptr;
 
         while (current)
         {
-            if (current->size >= size && current->size <= best->size)
+            if (current->size >= size && (best == nullptr || current->size < best->size))
             { best = current; }
 
             current = current->next;
         }
 
-        if (best->size < size)
+        if (best == nullptr)
         {
+            // Chunks are ordered by address: chunk of the
+            // new buffer is not necessarily the first one
+
             expand();
-            best = mChunk;
+            best = (Chunk*) ((uint8*)mBuffer + sizeof(Buffer));
         }
 
         auto source = best;
@@ -92,13 +95,39 @@ namespace Berserk
             if (best == mChunk) mChunk = left->next;
         }
 
+        // Used block header overlaps chunk's prev pointer,
+        // which must not be taken as aligned block mark
+
+        ((Block*)left)->data = 0;
+
         mUsage += left->size + sizeof(Block);
+        trackAllocate(left->size + sizeof(Block));
+
         return ((uint8*)left + sizeof(Block));
     }
 
+    void* ListAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+        if (alignment <= MEMORY_ALIGNMENT) return allocate(size);
+
+        auto original = (uint8*) allocate(size + alignment + sizeof(Block));
+        auto aligned = alignPointer(original + sizeof(Block), alignment);
+
+        auto block = (Block*) (aligned - sizeof(Block));
+        block->size = (uint64) original;
+        block->data = ALIGNED_BLOCK;
+
+        return aligned;
+    }
+
     void ListAllocator::free(void *pointer)
     {
+        auto header = (Block*) ((uint8*)pointer - sizeof(Block));
+        if (header->data == ALIGNED_BLOCK) pointer = (void*) header->size;
+
         mUsage -= sizeof(Block) + ((Block*)((uint8*)pointer - sizeof(Block)))->size;
+        trackFree(sizeof(Block) + ((Block*)((uint8*)pointer - sizeof(Block)))->size);
 
         if (mChunk == nullptr)
         {
@@ -11,15 +11,18 @@
 namespace Berserk
 {
 
-    PoolAllocator::PoolAllocator(uint32 chunkSize, uint32 chunkCount, IAllocator* allocator) : IAllocator()
+    PoolAllocator::PoolAllocator(uint32 chunkSize, uint32 chunkCount, IAllocator* allocator, uint32 alignment) : IAllocator()
     {
         FAIL(chunkSize >= MIN_CHUNK_SIZE, "Chunk size must be more minimum size %u", MIN_CHUNK_SIZE);
         FAIL(chunkCount >= MIN_CHUNK_COUNT, "Chunks count must be more than minimum count %u", MIN_CHUNK_COUNT);
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
 
         ALIGN(chunkSize);
+        if (alignment < MEMORY_ALIGNMENT) alignment = MEMORY_ALIGNMENT;
 
-        mChunkSize = chunkSize;
+        mChunkSize = (chunkSize + alignment - 1) & ~(alignment - 1);
         mChunkCount = chunkCount;
+        mAlignment = alignment;
 
         mChunk = nullptr;
         mBuffer = nullptr;
@@ -64,10 +67,19 @@ namespace Berserk
         mUsage += mChunkSize;
 
         mAllocCalls += 1;
+        trackAllocate(mChunkSize);
 
         return pointer;
     }
 
+    void * PoolAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+        FAIL(alignment <= mAlignment, "Pool chunks alignment %u is less than required %u", mAlignment, alignment);
+
+        return allocate(size);
+    }
+
     void PoolAllocator::free(void *pointer)
     {
         auto chunk = (Chunk*)(pointer);
@@ -75,6 +87,7 @@ namespace Berserk
         mChunk = chunk;
 
         mFreeCalls += 1;
+        trackFree(mChunkSize);
 
         mUsage -= mChunkSize;
     }
@@ -89,6 +102,11 @@ namespace Berserk
         return mChunkCount;
     }
 
+    uint32 PoolAllocator::getAlignment() const
+    {
+        return mAlignment;
+    }
+
     uint32 PoolAllocator::getUsage() const
     {
         return mUsage;
@@ -98,8 +116,8 @@ namespace Berserk
     {
         if (mChunk == nullptr)
         {
-            auto bufferSize = sizeof(Buffer) + mChunkSize * mChunkCount;
-            auto buffer = (Buffer*) mAllocator->allocate(bufferSize);
+            auto bufferSize = getBufferHeaderSize() + mChunkSize * mChunkCount;
+            auto buffer = (Buffer*) mAllocator->allocate(bufferSize, mAlignment);
             buffer->size = bufferSize;
 
             if (mBuffer)
@@ -113,7 +131,7 @@ namespace Berserk
                 buffer->next = nullptr;
             }
 
-            auto current = (Chunk*)((uint8*)mBuffer + sizeof(Buffer));
+            auto current = (Chunk*)((uint8*)mBuffer + getBufferHeaderSize());
             mChunk = current;
 
             while ((uint8*)current + mChunkSize < (uint8*)mBuffer + bufferSize)
@@ -136,7 +154,7 @@ namespace Berserk
     void PoolAllocator::profile(const char* msg) const
     {
         PUSH("PoolAllocator: %s: usage: %u | total: %lu | chunk size: %u | chunk count: %u | buffer size: %lu",
-                msg, mUsage, mTotalMemUsage, mChunkSize, mChunkCount, sizeof(Buffer) + mChunkCount * mChunkSize);
+                msg, mUsage, mTotalMemUsage, mChunkSize, mChunkCount, getBufferHeaderSize() + mChunkCount * mChunkSize);
     }
 #endif
 
@@ -4,6 +4,8 @@
 
 #include "Memory/ProxyAllocator.h"
 #include "Misc/Assert.h"
+#include "Misc/Alignment.h"
+#include "Logging/LogMacros.h"
 
 namespace Berserk
 {
@@ -13,17 +15,199 @@ namespace Berserk
         FAIL(allocator, "Null pointer IAllocator")
     }
 
+    ProxyAllocator::ProxyAllocator(IAllocator *allocator, const char *name, uint64 softLimit, uint64 hardLimit)
+            : mAllocator(allocator),
+              mName(name),
+              mIsBudgeted(true)
+    {
+        FAIL(allocator, "Null pointer IAllocator");
+        FAIL(name, "Null pointer name");
+
+        setStatsName(name);
+        setLimits(softLimit, hardLimit);
+    }
+
     void* ProxyAllocator::allocate(uint32 size)
     {
         mAllocCalls += 1;
         mTotalMemUsage += size;
-        return mAllocator->allocate(size);
+
+        auto pointer = (mIsBudgeted ? allocateTracked(size, MEMORY_ALIGNMENT) : mAllocator->allocate(size));
+        if (mTraceFile) fprintf(mTraceFile, "a %p %u\n", pointer, size);
+
+        return pointer;
+    }
+
+    void* ProxyAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        mAllocCalls += 1;
+        mTotalMemUsage += size;
+
+        auto pointer = (mIsBudgeted ? allocateTracked(size, alignment) : mAllocator->allocate(size, alignment));
+        if (mTraceFile) fprintf(mTraceFile, "a %p %u\n", pointer, size);
+
+        return pointer;
     }
 
     void ProxyAllocator::free(void *pointer)
     {
         mFreeCalls += 1;
-        mAllocator->free(pointer);
+        if (mTraceFile) fprintf(mTraceFile, "f %p\n", pointer);
+
+        if (!mIsBudgeted)
+        {
+            mAllocator->free(pointer);
+            return;
+        }
+
+        if (pointer == nullptr) return;
+
+        auto header = (Header*) ((uint8*)pointer - sizeof(Header));
+        uint64 size = header->size;
+
+        mAllocator->free((uint8*)pointer - header->offset);
+
+        mLiveUsage -= size;
+        trackFree(size);
+        updatePressure();
+    }
+
+    void ProxyAllocator::setLimits(uint64 softLimit, uint64 hardLimit)
+    {
+        FAIL(mIsBudgeted, "ProxyAllocator: limits are available only for budgeted proxy");
+        FAIL(hardLimit == 0 || softLimit <= hardLimit, "ProxyAllocator: soft limit %lu is more than hard limit %lu", softLimit, hardLimit);
+
+        mSoftLimit = softLimit;
+        mHardLimit = hardLimit;
+
+        updatePressure();
+    }
+
+    void ProxyAllocator::addPressureListener(PressureCallback callback, void *data)
+    {
+        FAIL(callback, "Null pointer callback");
+        FAIL(mListenersCount < MAX_LISTENERS_COUNT, "ProxyAllocator: max number of listeners is %u", MAX_LISTENERS_COUNT);
+
+        mListeners[mListenersCount].callback = callback;
+        mListeners[mListenersCount].data = data;
+        mListenersCount += 1;
+    }
+
+    void ProxyAllocator::removePressureListener(PressureCallback callback, void *data)
+    {
+        for (uint32 i = 0; i < mListenersCount; i++)
+        {
+            if (mListeners[i].callback == callback && mListeners[i].data == data)
+            {
+                mListenersCount -= 1;
+                mListeners[i] = mListeners[mListenersCount];
+                return;
+            }
+        }
+    }
+
+    void* ProxyAllocator::allocateTracked(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+
+        // Header is placed right before returned pointer: for alignment
+        // up to MEMORY_ALIGNMENT it is simply prefix of the block
+
+        uint32 offset = (alignment > sizeof(Header) ? alignment : (uint32) sizeof(Header));
+        uint64 total = (uint64)size + offset;
+
+        if (!reserve(total))
+        {
+            WARNING("ProxyAllocator: hard limit is exceeded [name: '%s'][live: %lu][requested: %lu][limit: %lu]",
+                    mName, mLiveUsage, total, mHardLimit);
+            return nullptr;
+        }
+
+        auto block = (uint8*) (alignment > MEMORY_ALIGNMENT ?
+                               mAllocator->allocate(size + offset, alignment) :
+                               mAllocator->allocate(size + offset));
+
+        auto pointer = block + offset;
+        auto header = (Header*) (pointer - sizeof(Header));
+        header->size = total;
+        header->offset = offset;
+        header->data = 0;
+
+        mLiveUsage += total;
+        if (mLiveUsage > mPeakUsage) mPeakUsage = mLiveUsage;
+
+        trackAllocate(total);
+        updatePressure();
+
+        return pointer;
+    }
+
+    bool ProxyAllocator::reserve(uint64 size)
+    {
+        if (mHardLimit == 0 || mLiveUsage + size <= mHardLimit) return true;
+
+        // Listeners have the last chance to free memory
+
+        mHardPressureCount += 1;
+
+#if PROFILE_PROXY_ALLOCATOR
+        profile("hard limit");
+#endif
+
+        notify(ePL_Hard);
+
+        return (mLiveUsage + size <= mHardLimit);
+    }
+
+    void ProxyAllocator::updatePressure()
+    {
+        bool overSoftLimit = (mSoftLimit != 0 && mLiveUsage > mSoftLimit);
+
+        if (overSoftLimit && mPressureLevel == ePL_Normal)
+        {
+            mPressureLevel = ePL_Soft;
+            mSoftPressureCount += 1;
+
+#if PROFILE_PROXY_ALLOCATOR
+            profile("soft pressure");
+#endif
+
+            notify(ePL_Soft);
+        }
+        else if (!overSoftLimit && mPressureLevel != ePL_Normal)
+        {
+            mPressureLevel = ePL_Normal;
+
+#if PROFILE_PROXY_ALLOCATOR
+            profile("normal pressure");
+#endif
+
+            notify(ePL_Normal);
+        }
+    }
+
+    void ProxyAllocator::notify(PressureLevel level)
+    {
+        // Listener frees memory through this allocator: changes
+        // of pressure inside callback are not reported again
+
+        if (mIsNotifying) return;
+        mIsNotifying = true;
+
+        for (uint32 i = 0; i < mListenersCount; i++)
+        {
+            mListeners[i].callback(*this, level, mListeners[i].data);
+        }
+
+        mIsNotifying = false;
+    }
+
+#if PROFILE_PROXY_ALLOCATOR
+    void ProxyAllocator::profile(const char *msg) const
+    {
+        PUSH("ProxyAllocator: %s: %s: live: %lu | peak: %lu | soft: %lu | hard: %lu",
+             mName, msg, mLiveUsage, mPeakUsage, mSoftLimit, mHardLimit);
     }
+#endif
 
-} // namespace Berserk
\ No newline at end of file
+} // namespace Berserk
@@ -0,0 +1,412 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+#include "Misc/Platform.h"
+#include "Misc/Alignment.h"
+#include "Logging/LogMacros.h"
+#include "Memory/Allocator.h"
+#include "Memory/RelocatableHeap.h"
+
+#if PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+namespace Berserk
+{
+
+    /** @return System page size */
+    static uint64 getPageSize()
+    {
+#if PLATFORM_WINDOWS
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return (uint64) info.dwPageSize;
+#else
+        return (uint64) sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+    RelocatableHeap::RelocatableHeap(uint32 bufferSize, IAllocator *allocator)
+            : mBuffers(nullptr),
+              mCurrent(nullptr),
+              mEvacuated(nullptr),
+              mCursor(0),
+              mFragmentationFactor(DEFAULT_FRAGMENTATION_FACTOR),
+              mUsage(0),
+              mMappedSize(0),
+              mMovedBytes(0),
+              mBuffersCount(0),
+              mReleasedBuffers(0),
+              mBlocksCount(0)
+    {
+        FAIL(bufferSize >= MIN_BUFFER_SIZE, "Buffer size must be more than %u", MIN_BUFFER_SIZE);
+
+        // Whole mapping (header and data) is multiple of page size
+
+        uint64 pageSize = getPageSize();
+        uint64 mappingSize = ((sizeof(Buffer) + bufferSize + pageSize - 1) / pageSize) * pageSize;
+        mBufferSize = mappingSize - sizeof(Buffer);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mEntriesCount = INITIAL_ENTRIES_COUNT;
+        mEntries = (Entry*) mAllocator->allocate(sizeof(Entry) * mEntriesCount);
+
+        for (uint32 i = 0; i < mEntriesCount; i++)
+        {
+            mEntries[i].block = nullptr;
+            mEntries[i].buffer = nullptr;
+            mEntries[i].generation = 0;
+            mEntries[i].next = (i + 1 < mEntriesCount ? i + 1 : INVALID_INDEX);
+        }
+
+        mFreeEntry = 0;
+        mStatsChannel = AllocationStats::getChannel("RelocatableHeap");
+    }
+
+    RelocatableHeap::~RelocatableHeap()
+    {
+        if (mEntries)
+        {
+#if PROFILE_RELOCATABLE_HEAP
+            profile("delete");
+#endif
+
+            while (mBuffers) unmap(mBuffers);
+
+            mAllocator->free(mEntries);
+            mEntries = nullptr;
+        }
+    }
+
+    RelocatableHeap::Handle RelocatableHeap::allocate(uint32 size)
+    {
+        ALIGN(size);
+
+        uint64 total = sizeof(Block) + (uint64)size;
+        Buffer* buffer;
+        Block* block;
+
+        if (total > mBufferSize)
+        {
+            buffer = map(total);
+            buffer->offset = total;
+            block = (Block*) getData(buffer);
+        }
+        else
+        {
+            block = place(total, buffer);
+        }
+
+        uint32 index = acquireEntry();
+        Entry& entry = mEntries[index];
+
+        block->size = size;
+        block->entry = index;
+        block->data = 0;
+
+        entry.block = block;
+        entry.buffer = buffer;
+
+        buffer->live += total;
+        mUsage += total;
+        mBlocksCount += 1;
+        AllocationStats::onAllocate(mStatsChannel, total);
+
+        Handle handle;
+        handle.index = index;
+        handle.generation = entry.generation;
+
+        return handle;
+    }
+
+    void RelocatableHeap::free(Handle handle)
+    {
+        Entry* entry = getEntry(handle);
+        FAIL(entry, "RelocatableHeap: an attempt to free stale handle [index: %u]", handle.index);
+
+        Block* block = entry->block;
+        Buffer* buffer = entry->buffer;
+        uint64 total = sizeof(Block) + block->size;
+
+        block->entry = INVALID_INDEX;
+        buffer->live -= total;
+
+        // The last block is simply cut off, others leave holes
+
+        if ((uint8*)block + total == getData(buffer) + buffer->offset) buffer->offset -= total;
+        else buffer->dead += total;
+
+        entry->block = nullptr;
+        entry->buffer = nullptr;
+        entry->generation += 1;
+        entry->next = mFreeEntry;
+        mFreeEntry = handle.index;
+
+        mUsage -= total;
+        mBlocksCount -= 1;
+        AllocationStats::onFree(mStatsChannel, total);
+
+        if (buffer->live == 0)
+        {
+            if (buffer == mEvacuated) mEvacuated = nullptr;
+
+            // Current buffer is kept: allocate / free of single block must not map and unmap buffer each time
+
+            if (buffer == mCurrent)
+            {
+                buffer->offset = 0;
+                buffer->dead = 0;
+            }
+            else
+            {
+                unmap(buffer);
+            }
+        }
+    }
+
+    void* RelocatableHeap::get(Handle handle) const
+    {
+        Entry* entry = getEntry(handle);
+        return (entry ? (uint8*)entry->block + sizeof(Block) : nullptr);
+    }
+
+    uint32 RelocatableHeap::getSize(Handle handle) const
+    {
+        Entry* entry = getEntry(handle);
+        return (entry ? (uint32)entry->block->size : 0);
+    }
+
+    bool RelocatableHeap::isValid(Handle handle) const
+    {
+        return getEntry(handle) != nullptr;
+    }
+
+    uint64 RelocatableHeap::compact(uint64 budget)
+    {
+        uint64 moved = 0;
+
+        while (moved < budget)
+        {
+            if (mEvacuated == nullptr)
+            {
+                mEvacuated = selectEvacuated();
+                mCursor = 0;
+
+                if (mEvacuated == nullptr) break;
+            }
+
+            Buffer* source = mEvacuated;
+
+            // All the blocks before cursor are moved or freed,
+            // therefore live blocks are always after cursor
+
+            auto block = (Block*) (getData(source) + mCursor);
+            uint64 total = sizeof(Block) + block->size;
+
+            if (block->entry != INVALID_INDEX)
+            {
+                if (moved > 0 && moved + total > budget) break;
+
+                Buffer* target;
+                Block* copy = place(total, target);
+                memcpy(copy, block, total);
+
+                Entry& entry = mEntries[block->entry];
+                entry.block = copy;
+                entry.buffer = target;
+
+                target->live += total;
+                source->live -= total;
+                moved += total;
+            }
+
+            mCursor += total;
+
+            if (source->live == 0)
+            {
+                mEvacuated = nullptr;
+                unmap(source);
+            }
+        }
+
+        mMovedBytes += moved;
+
+#if PROFILE_RELOCATABLE_HEAP
+        if (moved > 0) profile("compact");
+#endif
+
+        return moved;
+    }
+
+    void RelocatableHeap::compactAll()
+    {
+        while (compact(mBufferSize) > 0);
+    }
+
+    RelocatableHeap::Block* RelocatableHeap::place(uint64 size, Buffer* &buffer)
+    {
+        buffer = mCurrent;
+
+        if (buffer == nullptr || buffer->offset + size > buffer->size)
+        {
+            buffer = nullptr;
+
+            for (auto current = mBuffers; current != nullptr; current = current->next)
+            {
+                if (current != mEvacuated && !isDedicated(current) && current->offset + size <= current->size)
+                {
+                    buffer = current;
+                    break;
+                }
+            }
+
+            if (buffer == nullptr) buffer = map(mBufferSize);
+            mCurrent = buffer;
+        }
+
+        auto block = (Block*) (getData(buffer) + buffer->offset);
+        buffer->offset += size;
+
+        return block;
+    }
+
+    RelocatableHeap::Buffer* RelocatableHeap::map(uint64 size)
+    {
+        uint64 pageSize = getPageSize();
+        uint64 mappingSize = ((sizeof(Buffer) + size + pageSize - 1) / pageSize) * pageSize;
+
+#if PLATFORM_WINDOWS
+        void* mapping = VirtualAlloc(nullptr, mappingSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        FAIL(mapping != nullptr, "RelocatableHeap: cannot map buffer (size: %lu)", mappingSize);
+#else
+        void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        FAIL(mapping != MAP_FAILED, "RelocatableHeap: cannot map buffer (size: %lu)", mappingSize);
+#endif
+
+        auto buffer = (Buffer*) mapping;
+        buffer->prev = nullptr;
+        buffer->next = mBuffers;
+        buffer->size = mappingSize - sizeof(Buffer);
+        buffer->offset = 0;
+        buffer->live = 0;
+        buffer->dead = 0;
+
+        if (mBuffers) mBuffers->prev = buffer;
+        mBuffers = buffer;
+
+        mMappedSize += mappingSize;
+        mBuffersCount += 1;
+
+#if PROFILE_RELOCATABLE_HEAP
+        profile("map");
+#endif
+
+        return buffer;
+    }
+
+    void RelocatableHeap::unmap(Buffer *buffer)
+    {
+        if (buffer->prev) buffer->prev->next = buffer->next;
+        else mBuffers = buffer->next;
+
+        if (buffer->next) buffer->next->prev = buffer->prev;
+
+        if (buffer == mCurrent) mCurrent = nullptr;
+
+        uint64 mappingSize = sizeof(Buffer) + buffer->size;
+
+#if PLATFORM_WINDOWS
+        VirtualFree(buffer, 0, MEM_RELEASE);
+#else
+        munmap(buffer, mappingSize);
+#endif
+
+        mMappedSize -= mappingSize;
+        mBuffersCount -= 1;
+        mReleasedBuffers += 1;
+
+#if PROFILE_RELOCATABLE_HEAP
+        profile("unmap");
+#endif
+    }
+
+    RelocatableHeap::Buffer* RelocatableHeap::selectEvacuated() const
+    {
+        Buffer* result = nullptr;
+
+        for (auto buffer = mBuffers; buffer != nullptr; buffer = buffer->next)
+        {
+            // Current buffer is filled with new blocks, it will be
+            // considered after the next one becomes current
+
+            if (buffer == mCurrent || isDedicated(buffer)) continue;
+            if (buffer->dead * mFragmentationFactor <= buffer->offset) continue;
+
+            // Choose the biggest part of holes: dead / offset
+
+            if (result == nullptr || buffer->dead * result->offset > result->dead * buffer->offset)
+            {
+                result = buffer;
+            }
+        }
+
+        return result;
+    }
+
+    uint32 RelocatableHeap::acquireEntry()
+    {
+        if (mFreeEntry == INVALID_INDEX)
+        {
+            uint32 count = mEntriesCount * 2;
+            auto entries = (Entry*) mAllocator->allocate(sizeof(Entry) * count);
+
+            memcpy(entries, mEntries, sizeof(Entry) * mEntriesCount);
+
+            for (uint32 i = mEntriesCount; i < count; i++)
+            {
+                entries[i].block = nullptr;
+                entries[i].buffer = nullptr;
+                entries[i].generation = 0;
+                entries[i].next = (i + 1 < count ? i + 1 : INVALID_INDEX);
+            }
+
+            mAllocator->free(mEntries);
+
+            mFreeEntry = mEntriesCount;
+            mEntries = entries;
+            mEntriesCount = count;
+        }
+
+        uint32 index = mFreeEntry;
+        mFreeEntry = mEntries[index].next;
+
+        return index;
+    }
+
+    RelocatableHeap::Entry* RelocatableHeap::getEntry(Handle handle) const
+    {
+        if (handle.index >= mEntriesCount) return nullptr;
+
+        Entry* entry = &mEntries[handle.index];
+        if (entry->block == nullptr || entry->generation != handle.generation) return nullptr;
+
+        return entry;
+    }
+
+#if PROFILE_RELOCATABLE_HEAP
+    void RelocatableHeap::profile(const char *msg) const
+    {
+        PUSH("RelocatableHeap: %s: usage: %lu | mapped: %lu | buffers: %u | moved: %lu | released: %u",
+             msg, mUsage, mMappedSize, mBuffersCount, mMovedBytes, mReleasedBuffers);
+    }
+#endif
+
+} // namespace Berserk
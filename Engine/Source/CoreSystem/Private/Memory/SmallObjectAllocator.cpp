@@ -0,0 +1,312 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+#include "Misc/Platform.h"
+#include "Misc/Alignment.h"
+#include "Logging/LogMacros.h"
+#include "Memory/SmallObjectAllocator.h"
+
+#if PLATFORM_WINDOWS
+    #include <malloc.h>
+#endif
+
+namespace Berserk
+{
+
+    SmallObjectAllocator::SmallObjectAllocator() : IAllocator()
+    {
+        uint32 index = 0;
+
+        for (uint32 i = 0; i < SIZE_CLASSES_COUNT; i++)
+        {
+            uint32 size;
+
+            if (i < 8)
+            {
+                size = (i + 1) * Buffers::SIZE_16;
+            }
+            else
+            {
+                uint32 power = 7 + (i - 8) / 4;
+                uint32 step = 1u << (power - 2);
+                size = (1u << power) + ((i - 8) % 4 + 1) * step;
+            }
+
+            mClasses[i].partial = nullptr;
+            mClasses[i].full = nullptr;
+            mClasses[i].empty = nullptr;
+            mClasses[i].size = size;
+            mClasses[i].capacity = (SLAB_SIZE - sizeof(Slab)) / size;
+
+            // All the 16 bytes steps up to size belong to this class
+
+            while (index < size / Buffers::SIZE_16)
+            {
+                mClassIndex[index] = (uint8) i;
+                index += 1;
+            }
+        }
+
+        mLarge = nullptr;
+        mUsage = 0;
+        mSlabsCount = 0;
+    }
+
+    SmallObjectAllocator::~SmallObjectAllocator()
+    {
+        for (uint32 i = 0; i < SIZE_CLASSES_COUNT; i++)
+        {
+            Slab* lists[] = { mClasses[i].partial, mClasses[i].full, mClasses[i].empty };
+
+            for (auto current : lists)
+            {
+                while (current)
+                {
+                    auto next = current->next;
+                    systemFree(current);
+                    current = next;
+                }
+            }
+        }
+
+        while (mLarge)
+        {
+            auto next = mLarge->next;
+            systemFree(mLarge);
+            mLarge = next;
+        }
+
+#if PROFILE_SMALL_OBJECT_ALLOCATOR
+        profile("delete");
+#endif
+    }
+
+    void* SmallObjectAllocator::allocate(uint32 size)
+    {
+        if (size == 0) size = Buffers::SIZE_16;
+
+        if (size > MAX_SMALL_SIZE)
+        {
+            uint64 total = sizeof(Slab) + (uint64)size;
+
+            auto block = (Slab*) systemAllocate(total);
+            block->sizeClass = LARGE_CLASS;
+            block->used = 1;
+            block->size = total;
+            insert(mLarge, block);
+
+            mUsage += size;
+            mTotalMemUsage += total;
+            mAllocCalls += 1;
+            trackAllocate(size);
+
+            return (uint8*)block + sizeof(Slab);
+        }
+
+        uint32 sizeClass = mClassIndex[(size - 1) >> 4];
+        SizeClass& info = mClasses[sizeClass];
+
+        auto slab = info.partial;
+
+        if (slab == nullptr)
+        {
+            slab = acquireSlab(sizeClass);
+            insert(info.partial, slab);
+        }
+
+        Object* object;
+
+        if (slab->free)
+        {
+            object = slab->free;
+            slab->free = object->next;
+        }
+        else
+        {
+            // Objects are carved lazily to not touch pages of new slab at once
+
+            object = (Object*)((uint8*)slab + sizeof(Slab) + slab->carved * info.size);
+            slab->carved += 1;
+        }
+
+        slab->used += 1;
+
+        if (slab->used == slab->capacity)
+        {
+            remove(info.partial, slab);
+            insert(info.full, slab);
+        }
+
+        mUsage += info.size;
+        mAllocCalls += 1;
+        trackAllocate(info.size);
+
+        return object;
+    }
+
+    void SmallObjectAllocator::free(void *pointer)
+    {
+        if (pointer == nullptr) return;
+
+        auto slab = (Slab*)((uint64)pointer & ~((uint64)SLAB_SIZE - 1));
+        mFreeCalls += 1;
+
+        if (slab->sizeClass == LARGE_CLASS)
+        {
+            remove(mLarge, slab);
+
+            mUsage -= slab->size - sizeof(Slab);
+            mTotalMemUsage -= slab->size;
+            trackFree(slab->size - sizeof(Slab));
+
+            systemFree(slab);
+            return;
+        }
+
+        SizeClass& info = mClasses[slab->sizeClass];
+
+        if (slab->used == slab->capacity)
+        {
+            remove(info.full, slab);
+            insert(info.partial, slab);
+        }
+
+        auto object = (Object*) pointer;
+        object->next = slab->free;
+        slab->free = object;
+        slab->used -= 1;
+
+        mUsage -= info.size;
+        trackFree(info.size);
+
+        if (slab->used == 0)
+        {
+            remove(info.partial, slab);
+            releaseSlab(slab);
+        }
+    }
+
+    uint64 SmallObjectAllocator::getUsage() const
+    {
+        return mUsage;
+    }
+
+    uint32 SmallObjectAllocator::getSlabsCount() const
+    {
+        return mSlabsCount;
+    }
+
+    uint32 SmallObjectAllocator::getClassSize(uint32 size) const
+    {
+        if (size == 0) size = Buffers::SIZE_16;
+        if (size > MAX_SMALL_SIZE) return size;
+
+        return mClasses[mClassIndex[(size - 1) >> 4]].size;
+    }
+
+    SmallObjectAllocator::Slab* SmallObjectAllocator::acquireSlab(uint32 sizeClass)
+    {
+        SizeClass& info = mClasses[sizeClass];
+        Slab* slab = info.empty;
+
+        if (slab)
+        {
+            info.empty = nullptr;
+        }
+        else
+        {
+            slab = (Slab*) systemAllocate(SLAB_SIZE);
+            slab->sizeClass = sizeClass;
+            slab->capacity = info.capacity;
+            slab->size = SLAB_SIZE;
+
+            mSlabsCount += 1;
+            mTotalMemUsage += SLAB_SIZE;
+
+#if PROFILE_SMALL_OBJECT_ALLOCATOR
+            profile("acquire slab");
+#endif
+        }
+
+        slab->used = 0;
+        slab->carved = 0;
+        slab->free = nullptr;
+
+        return slab;
+    }
+
+    void SmallObjectAllocator::releaseSlab(Slab *slab)
+    {
+        SizeClass& info = mClasses[slab->sizeClass];
+
+        // Keep one empty slab to avoid system calls on
+        // allocate / free of one object on the slab boundary
+
+        if (info.empty == nullptr)
+        {
+            slab->next = nullptr;
+            slab->prev = nullptr;
+            info.empty = slab;
+            return;
+        }
+
+        systemFree(slab);
+
+        mSlabsCount -= 1;
+        mTotalMemUsage -= SLAB_SIZE;
+
+#if PROFILE_SMALL_OBJECT_ALLOCATOR
+        profile("release slab");
+#endif
+    }
+
+    void SmallObjectAllocator::insert(Slab* &list, Slab *slab)
+    {
+        slab->prev = nullptr;
+        slab->next = list;
+        if (list) list->prev = slab;
+        list = slab;
+    }
+
+    void SmallObjectAllocator::remove(Slab* &list, Slab *slab)
+    {
+        if (slab->prev) slab->prev->next = slab->next;
+        else list = slab->next;
+        if (slab->next) slab->next->prev = slab->prev;
+    }
+
+    void* SmallObjectAllocator::systemAllocate(uint64 size)
+    {
+        void* memory = nullptr;
+
+#if PLATFORM_WINDOWS
+        memory = _aligned_malloc(size, SLAB_SIZE);
+#else
+        if (posix_memalign(&memory, SLAB_SIZE, size) != 0) memory = nullptr;
+#endif
+
+        FAIL(memory != nullptr, "SmallObjectAllocator: cannot allocate memory (size: %lu)", size);
+        return memory;
+    }
+
+    void SmallObjectAllocator::systemFree(void *pointer)
+    {
+#if PLATFORM_WINDOWS
+        _aligned_free(pointer);
+#else
+        ::free(pointer);
+#endif
+    }
+
+#if PROFILE_SMALL_OBJECT_ALLOCATOR
+    void SmallObjectAllocator::profile(const char* msg) const
+    {
+        PUSH("SmallObjectAllocator: %s: usage: %lu | total: %lu | slabs: %u",
+             msg, mUsage, mTotalMemUsage, mSlabsCount);
+    }
+#endif
+
+} // namespace Berserk
@@ -18,14 +18,38 @@ namespace Berserk
         mUsage = 0;
         mTotalMemUsage = size;
 
-        if (allocator) mAllocator = allocator;
-        else mAllocator = &Allocator::getSingleton();
+        if (allocator)
+        {
+            mAllocator = allocator;
+            mArena = nullptr;
+            mBuffer = (Data*) mAllocator->allocate(size);
+        }
+        else
+        {
+            // Only address range is reserved: pages are committed on demand
 
-        mBuffer = (Data*) mAllocator->allocate(size);
+            mAllocator = &Allocator::getSingleton();
+            mArena = new (mAllocator->allocate(sizeof(VirtualArenaAllocator))) VirtualArenaAllocator(size);
+            mBuffer = nullptr;
+        }
     }
 
     StackAllocator::~StackAllocator()
     {
+        if (mArena)
+        {
+            clear();
+
+            mArena->~VirtualArenaAllocator();
+            mAllocator->free(mArena);
+            mArena = nullptr;
+            mBuffer = nullptr;
+
+#if PROFILE_STACK_ALLOCATOR
+            printf("Stack allocator: delete arena %lu\n", mTotalMemUsage);
+#endif
+        }
+
         if (mBuffer)
         {
             clear();
@@ -41,43 +65,58 @@ namespace Berserk
 
     void* StackAllocator::allocate(uint32 size)
     {
+        return allocate(size, MEMORY_ALIGNMENT);
+    }
+
+    void* StackAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
         ALIGN(size);
-        FAIL(mUsage + size + sizeof(Data) <= mTotalMemUsage, "Cannot allocate memory. Buffer is full");
 
-        void* pointer;
+        Data* chunk;
+        uint8* pointer;
 
-        if (mUsage == 0)
+        if (mArena)
         {
-            mBuffer->prev = mBuffer;
-            mBuffer->size = size;
-
-            pointer = (uint8*)mBuffer + sizeof(Data);
+            // Arena is linear: payload is placed right after header
+            chunk = (Data*) mArena->allocate(sizeof(Data));
+            pointer = (uint8*) mArena->allocate(size, alignment);
         }
         else
         {
-            auto chunk = mBuffer;
-            chunk = (Data*)((uint8*)chunk + chunk->size + sizeof(Data));
-            chunk->prev = mBuffer;
-            chunk->size = size;
+            chunk = mBuffer;
+            if (mUsage != 0) chunk = (Data*)((uint8*)chunk + chunk->size + sizeof(Data));
+            pointer = alignPointer((uint8*)chunk + sizeof(Data), alignment);
+        }
 
-            mBuffer = chunk;
+        auto data = (uint8*)chunk + sizeof(Data);
+        auto offset = (uint32)(pointer - data);
 
-            pointer = (uint8*)mBuffer + sizeof(Data);
-        }
+        FAIL(mUsage + offset + size + sizeof(Data) <= mTotalMemUsage, "Cannot allocate memory. Buffer is full");
+
+        chunk->prev = (mUsage == 0 ? chunk : mBuffer);
+        chunk->size = offset + size;
+        chunk->offset = offset;
+
+        mBuffer = chunk;
 
         mAllocCalls += 1;
-        mUsage += size + sizeof(Data);
+        mUsage += chunk->size + sizeof(Data);
+        trackAllocate(chunk->size + sizeof(Data));
 
         return pointer;
     }
 
     void StackAllocator::free(void *pointer)
     {
-        FAIL(pointer == (uint8*)mBuffer + sizeof(Data), "An attempt to free not previously allocated chunk of memory");
+        FAIL(pointer == (uint8*)mBuffer + sizeof(Data) + mBuffer->offset, "An attempt to free not previously allocated chunk of memory");
 
         mUsage -= mBuffer->size + sizeof(Data);
+        trackFree(mBuffer->size + sizeof(Data));
         mBuffer = mBuffer->prev;
 
+        if (mArena) mArena->rewind(mUsage);
+
         mFreeCalls += 1;
     }
 
@@ -86,8 +125,11 @@ namespace Berserk
         if (mUsage)
         {
             mBuffer = (Data*) ((uint8*)mBuffer - (mUsage - mBuffer->size - sizeof(Data)));
+            trackFree(mUsage);
             mUsage = 0;
         }
+
+        if (mArena) mArena->clear();
     }
 
     uint32 StackAllocator::getUsage() const
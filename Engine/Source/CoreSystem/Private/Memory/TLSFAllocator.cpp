@@ -0,0 +1,316 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Alignment.h"
+#include "Memory/Allocator.h"
+#include "Memory/TLSFAllocator.h"
+
+namespace Berserk
+{
+
+    TLSFAllocator::TLSFAllocator(uint32 bufferSize, IAllocator* allocator) : IAllocator()
+    {
+        FAIL(bufferSize >= MIN_BUFFER_SIZE, "Buffer size must be more than %u", MIN_BUFFER_SIZE);
+        ALIGN(bufferSize);
+
+        mPool = nullptr;
+        mUsage = 0;
+        mBufferSize = bufferSize;
+        mFlBitmap = 0;
+
+        for (uint32 i = 0; i < FL_INDEX_COUNT; i++)
+        {
+            mSlBitmap[i] = 0;
+
+            for (uint32 j = 0; j < SL_INDEX_COUNT; j++)
+            {
+                mBlocks[i][j] = nullptr;
+            }
+        }
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        insert(expand(mBufferSize, false));
+    }
+
+    TLSFAllocator::~TLSFAllocator()
+    {
+        auto current = mPool;
+        while (current)
+        {
+#if PROFILE_TLSF_ALLOCATOR
+            printf("TLSF Allocator: free pool %p\n", current);
+#endif
+
+            auto next = current->next;
+            mAllocator->free(current);
+            current = next;
+        }
+
+        mPool = nullptr;
+    }
+
+    void* TLSFAllocator::allocate(uint32 size)
+    {
+        uint64 required = size;
+        ALIGN(required);
+        if (required < MIN_BLOCK_SIZE) required = MIN_BLOCK_SIZE;
+
+        Block* block = nullptr;
+
+        uint32 fl, sl, bufferFl, bufferSl;
+        mappingSearch(required, fl, sl);
+        mapping(mBufferSize, bufferFl, bufferSl);
+
+        // Whole empty pool is found by search only if
+        // the rounded size is in the class not above pool's one
+
+        bool fitsPool = (fl < bufferFl) || (fl == bufferFl && sl <= bufferSl);
+
+        if (fitsPool)
+        {
+            block = findSuitable(fl, sl);
+
+            if (block == nullptr)
+            {
+                insert(expand(mBufferSize, false));
+                mappingSearch(required, fl, sl);
+                block = findSuitable(fl, sl);
+            }
+        }
+
+        if (block)
+        {
+            remove(block);
+            trim(block, required);
+        }
+        else
+        {
+            block = expand(required, true);
+        }
+
+        block->size &= ~BLOCK_FREE;
+        getNext(block)->size &= ~BLOCK_PREV_FREE;
+
+        mUsage += getSize(block) + BLOCK_OVERHEAD;
+        mAllocCalls += 1;
+        trackAllocate(getSize(block) + BLOCK_OVERHEAD);
+
+        return (uint8*)block + BLOCK_OVERHEAD;
+    }
+
+    void TLSFAllocator::free(void *pointer)
+    {
+        if (pointer == nullptr) return;
+
+        auto block = (Block*)((uint8*)pointer - BLOCK_OVERHEAD);
+        FAIL(!(block->size & BLOCK_FREE), "TLSF Allocator: an attempt to free already free block %p", pointer);
+
+        mUsage -= getSize(block) + BLOCK_OVERHEAD;
+        mFreeCalls += 1;
+        trackFree(getSize(block) + BLOCK_OVERHEAD);
+
+        block->size |= BLOCK_FREE;
+        getNext(block)->size |= BLOCK_PREV_FREE;
+
+        block = merge(block);
+
+        // Block occupies whole pool: dedicated pools are
+        // returned at once, ordinary ones are kept for next allocations
+
+        if (block->prevPhys == nullptr && getSize(getNext(block)) == 0)
+        {
+            auto pool = (Pool*)((uint8*)block - sizeof(Pool));
+
+            if (pool->dedicated)
+            {
+                release(pool);
+                return;
+            }
+        }
+
+        insert(block);
+    }
+
+    uint32 TLSFAllocator::getBufferSize() const
+    {
+        return mBufferSize;
+    }
+
+    uint64 TLSFAllocator::getUsage() const
+    {
+        return mUsage;
+    }
+
+    void TLSFAllocator::mapping(uint64 size, uint32 &fl, uint32 &sl)
+    {
+        if (size < (1u << FL_INDEX_SHIFT))
+        {
+            fl = 0;
+            sl = (uint32)(size >> 4);
+        }
+        else
+        {
+            uint32 msb = 63 - __builtin_clzll(size);
+            sl = (uint32)(size >> (msb - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+            fl = msb - FL_INDEX_SHIFT + 1;
+        }
+    }
+
+    void TLSFAllocator::mappingSearch(uint64 size, uint32 &fl, uint32 &sl)
+    {
+        if (size >= (1u << FL_INDEX_SHIFT))
+        {
+            uint32 msb = 63 - __builtin_clzll(size);
+            size += (1ull << (msb - SL_INDEX_COUNT_LOG2)) - 1;
+        }
+
+        mapping(size, fl, sl);
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::findSuitable(uint32 &fl, uint32 &sl)
+    {
+        if (fl >= FL_INDEX_COUNT) return nullptr;
+
+        uint32 slMap = mSlBitmap[fl] & (~0u << sl);
+
+        if (slMap == 0)
+        {
+            uint32 flMap = (fl + 1 < FL_INDEX_COUNT ? mFlBitmap & (~0u << (fl + 1)) : 0);
+            if (flMap == 0) return nullptr;
+
+            fl = __builtin_ctz(flMap);
+            slMap = mSlBitmap[fl];
+        }
+
+        sl = __builtin_ctz(slMap);
+        return mBlocks[fl][sl];
+    }
+
+    void TLSFAllocator::insert(Block *block)
+    {
+        uint32 fl, sl;
+        mapping(getSize(block), fl, sl);
+
+        auto head = mBlocks[fl][sl];
+        block->nextFree = head;
+        block->prevFree = nullptr;
+        if (head) head->prevFree = block;
+
+        mBlocks[fl][sl] = block;
+        mFlBitmap |= (1u << fl);
+        mSlBitmap[fl] |= (1u << sl);
+    }
+
+    void TLSFAllocator::remove(Block *block)
+    {
+        uint32 fl, sl;
+        mapping(getSize(block), fl, sl);
+
+        if (block->prevFree) block->prevFree->nextFree = block->nextFree;
+        if (block->nextFree) block->nextFree->prevFree = block->prevFree;
+
+        if (mBlocks[fl][sl] == block)
+        {
+            mBlocks[fl][sl] = block->nextFree;
+
+            if (mBlocks[fl][sl] == nullptr)
+            {
+                mSlBitmap[fl] &= ~(1u << sl);
+                if (mSlBitmap[fl] == 0) mFlBitmap &= ~(1u << fl);
+            }
+        }
+    }
+
+    void TLSFAllocator::trim(Block *block, uint64 size)
+    {
+        uint64 blockSize = getSize(block);
+
+        if (blockSize >= size + BLOCK_OVERHEAD + MIN_BLOCK_SIZE)
+        {
+            auto rest = (Block*)((uint8*)block + BLOCK_OVERHEAD + size);
+            rest->prevPhys = block;
+            rest->size = (blockSize - size - BLOCK_OVERHEAD) | BLOCK_FREE;
+
+            block->size = size | (block->size & (BLOCK_FREE | BLOCK_PREV_FREE));
+
+            auto next = getNext(rest);
+            next->prevPhys = rest;
+            next->size |= BLOCK_PREV_FREE;
+
+            insert(rest);
+        }
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::merge(Block *block)
+    {
+        if (block->size & BLOCK_PREV_FREE)
+        {
+            auto prev = block->prevPhys;
+            remove(prev);
+
+            prev->size += BLOCK_OVERHEAD + getSize(block);
+            block = prev;
+            getNext(block)->prevPhys = block;
+        }
+
+        auto next = getNext(block);
+
+        if (next->size & BLOCK_FREE)
+        {
+            remove(next);
+
+            block->size += BLOCK_OVERHEAD + getSize(next);
+            getNext(block)->prevPhys = block;
+        }
+
+        return block;
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::expand(uint64 size, bool dedicated)
+    {
+        uint64 poolSize = sizeof(Pool) + BLOCK_OVERHEAD + size + BLOCK_OVERHEAD;
+        FAIL(poolSize <= 0xffffffff, "TLSF Allocator: an attempt to acquire too big block %lu", size);
+
+        auto pool = (Pool*) mAllocator->allocate((uint32)poolSize);
+        pool->size = poolSize;
+        pool->dedicated = dedicated;
+        pool->prev = nullptr;
+        pool->next = mPool;
+        if (mPool) mPool->prev = pool;
+        mPool = pool;
+
+        auto block = (Block*)((uint8*)pool + sizeof(Pool));
+        block->prevPhys = nullptr;
+        block->size = size | BLOCK_FREE;
+
+        // Sentinel block with zero size closes the pool and
+        // is never merged, because it is never marked as free
+
+        auto sentinel = getNext(block);
+        sentinel->prevPhys = block;
+        sentinel->size = BLOCK_PREV_FREE;
+
+        mTotalMemUsage += poolSize;
+
+#if PROFILE_TLSF_ALLOCATOR
+        printf("TLSF Allocator: expand: usage: %lu | total: %lu | pool size: %lu | dedicated: %i\n",
+               mUsage, mTotalMemUsage, poolSize, dedicated);
+#endif
+
+        return block;
+    }
+
+    void TLSFAllocator::release(Pool *pool)
+    {
+        if (pool->prev) pool->prev->next = pool->next;
+        else mPool = pool->next;
+        if (pool->next) pool->next->prev = pool->prev;
+
+        mAllocator->free(pool);
+    }
+
+} // namespace Berserk
@@ -0,0 +1,55 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Alignment.h"
+#include "Memory/TaggedAllocator.h"
+
+namespace Berserk
+{
+
+    TaggedAllocator::TaggedAllocator(TaggedHeap *heap, TaggedHeap::Tag tag) : IAllocator()
+    {
+        FAIL(heap, "Null pointer TaggedHeap");
+
+        mHeap = heap;
+        mTag = tag;
+        mBlock = nullptr;
+        mOffset = 0;
+        mUsage = 0;
+    }
+
+    void* TaggedAllocator::allocate(uint32 size)
+    {
+        ALIGN(size);
+        FAIL(size <= TaggedHeap::BLOCK_SIZE, "TaggedAllocator: an attempt to allocate more than block size %u", size);
+
+        if (mBlock == nullptr || mOffset + size > TaggedHeap::BLOCK_SIZE)
+        {
+            mBlock = (uint8*) mHeap->allocateBlock(mTag);
+            mOffset = 0;
+            mTotalMemUsage += TaggedHeap::BLOCK_SIZE;
+        }
+
+        auto pointer = mBlock + mOffset;
+        mOffset += size;
+        mUsage += size;
+        mAllocCalls += 1;
+
+        trackAllocate(size);
+
+        return pointer;
+    }
+
+    void TaggedAllocator::reset(TaggedHeap::Tag tag)
+    {
+        trackFree(mUsage);
+
+        mTag = tag;
+        mBlock = nullptr;
+        mOffset = 0;
+        mUsage = 0;
+    }
+
+} // namespace Berserk
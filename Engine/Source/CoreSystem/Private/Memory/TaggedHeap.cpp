@@ -2,9 +2,293 @@
 // Created by Egor Orachyov on 24.01.2019.
 //
 
+#include "Misc/Assert.h"
+#include "Misc/Platform.h"
+#include "Memory/Allocator.h"
 #include "Memory/TaggedHeap.h"
+#include "Logging/LogMacros.h"
+
+#if !PLATFORM_WINDOWS
+    #include <sys/mman.h>
+    #ifndef MAP_ANONYMOUS
+        #define MAP_ANONYMOUS MAP_ANON
+    #endif
+#endif
 
 namespace Berserk
 {
 
-}
\ No newline at end of file
+    TaggedHeap::TaggedHeap(uint32 blocksCount, bool useHugePages)
+    {
+        FAIL(blocksCount > 0, "TaggedHeap: blocks count must be more than 0");
+
+        uint64 size = (uint64)blocksCount * BLOCK_SIZE;
+
+        mBlocksCount = blocksCount;
+        mUsesHugePages = false;
+        mMapping = nullptr;
+        mRegion = nullptr;
+
+#if PLATFORM_WINDOWS
+        mMappingSize = size + BLOCK_SIZE;
+        mMapping = malloc(mMappingSize);
+        FAIL(mMapping != nullptr, "TaggedHeap: cannot reserve memory (size: %lu)", mMappingSize);
+#else
+    #ifdef MAP_HUGETLB
+        if (useHugePages)
+        {
+            // Explicit huge pages could be not configured in the system,
+            // then try transparent huge pages for usual mapping
+
+            mMapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if (mMapping != MAP_FAILED)
+            {
+                mMappingSize = size;
+                mRegion = (uint8*) mMapping;
+                mUsesHugePages = true;
+            }
+            else
+            {
+                mMapping = nullptr;
+            }
+        }
+    #endif
+
+        if (mMapping == nullptr)
+        {
+            mMappingSize = size + BLOCK_SIZE;
+            mMapping = mmap(nullptr, mMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            FAIL(mMapping != MAP_FAILED, "TaggedHeap: cannot reserve memory (size: %lu)", mMappingSize);
+        }
+#endif
+
+        if (mRegion == nullptr)
+        {
+            // Blocks are aligned on their size to be backed by whole huge pages
+
+            auto address = (uint64) mMapping;
+            address = (address + BLOCK_SIZE - 1) & ~((uint64)BLOCK_SIZE - 1);
+            mRegion = (uint8*) address;
+
+#if !PLATFORM_WINDOWS && defined(MADV_HUGEPAGE)
+            if (useHugePages && madvise(mRegion, size, MADV_HUGEPAGE) == 0)
+            {
+                mUsesHugePages = true;
+            }
+#endif
+        }
+
+        auto& allocator = Allocator::getSingleton();
+        mNext = (std::atomic<uint32>*) allocator.allocate(blocksCount * sizeof(std::atomic<uint32>));
+        mBlockTag = (std::atomic<uint64>*) allocator.allocate(blocksCount * sizeof(std::atomic<uint64>));
+
+        // Initially blocks are placed in the stack in the order of addresses
+
+        for (uint32 i = 0; i < blocksCount; i++)
+        {
+            new (&mNext[i]) std::atomic<uint32>(i + 1 < blocksCount ? i + 1 : BLOCK_NONE);
+            new (&mBlockTag[i]) std::atomic<uint64>(NO_TAG);
+        }
+
+        mFreeHead.store(0, std::memory_order_relaxed);
+        mFreeBlocks.store(blocksCount, std::memory_order_relaxed);
+
+        for (uint32 i = 0; i < MAX_TAGS_COUNT; i++)
+        {
+            mSlots[i].tag.store(NO_TAG, std::memory_order_relaxed);
+            mSlots[i].blocks.store(0, std::memory_order_relaxed);
+            mSlots[i].peak.store(0, std::memory_order_relaxed);
+            mSlots[i].acquires.store(0, std::memory_order_relaxed);
+        }
+
+#if PROFILE_TAGGED_HEAP
+        PUSH("TaggedHeap: create blocks: %u | huge pages: %i | region: %p", mBlocksCount, mUsesHugePages, mRegion);
+#endif
+    }
+
+    TaggedHeap::~TaggedHeap()
+    {
+        if (mMapping)
+        {
+#if PLATFORM_WINDOWS
+            ::free(mMapping);
+#else
+            munmap(mMapping, mMappingSize);
+#endif
+
+            auto& allocator = Allocator::getSingleton();
+            allocator.free(mNext);
+            allocator.free(mBlockTag);
+
+            mMapping = nullptr;
+            mRegion = nullptr;
+
+#if PROFILE_TAGGED_HEAP
+            PUSH("TaggedHeap: delete blocks: %u", mBlocksCount);
+#endif
+        }
+    }
+
+    void* TaggedHeap::allocateBlock(Tag tag)
+    {
+        FAIL(tag != NO_TAG, "TaggedHeap: invalid tag");
+
+        auto index = pop();
+        FAIL(index != BLOCK_NONE, "TaggedHeap: no free blocks (total: %u)", mBlocksCount);
+
+        mBlockTag[index].store(tag, std::memory_order_release);
+
+        auto slot = acquireSlot(tag);
+        auto blocks = slot->blocks.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto peak = slot->peak.load(std::memory_order_relaxed);
+
+        while (peak < blocks && !slot->peak.compare_exchange_weak(peak, blocks, std::memory_order_relaxed))
+        {
+            /** Other thread updated peak, retry */
+        }
+
+        slot->acquires.fetch_add(1, std::memory_order_relaxed);
+
+        return mRegion + (uint64)index * BLOCK_SIZE;
+    }
+
+    void TaggedHeap::freeTag(Tag tag)
+    {
+        uint32 released = 0;
+
+        for (uint32 i = 0; i < mBlocksCount; i++)
+        {
+            if (mBlockTag[i].load(std::memory_order_acquire) == tag)
+            {
+                mBlockTag[i].store(NO_TAG, std::memory_order_relaxed);
+                push(i);
+                released += 1;
+            }
+        }
+
+        std::lock_guard<std::mutex> guard(mSlotsMutex);
+
+        auto slot = findSlot(tag);
+        if (slot)
+        {
+            slot->blocks.fetch_sub(released, std::memory_order_relaxed);
+            slot->tag.store(NO_TAG, std::memory_order_release);
+        }
+    }
+
+    TaggedHeap::TagStat TaggedHeap::getTagStat(Tag tag) const
+    {
+        TagStat stat = { tag, 0, 0, 0 };
+
+        auto slot = findSlot(tag);
+        if (slot)
+        {
+            stat.blocks = slot->blocks.load(std::memory_order_relaxed);
+            stat.peak = slot->peak.load(std::memory_order_relaxed);
+            stat.acquires = slot->acquires.load(std::memory_order_relaxed);
+        }
+
+        return stat;
+    }
+
+    uint32 TaggedHeap::getTagsStat(TagStat *stats) const
+    {
+        uint32 count = 0;
+
+        for (uint32 i = 0; i < MAX_TAGS_COUNT; i++)
+        {
+            auto tag = mSlots[i].tag.load(std::memory_order_acquire);
+            if (tag == NO_TAG) continue;
+
+            stats[count].tag = tag;
+            stats[count].blocks = mSlots[i].blocks.load(std::memory_order_relaxed);
+            stats[count].peak = mSlots[i].peak.load(std::memory_order_relaxed);
+            stats[count].acquires = mSlots[i].acquires.load(std::memory_order_relaxed);
+            count += 1;
+        }
+
+        return count;
+    }
+
+    TaggedHeap::TagSlot* TaggedHeap::findSlot(Tag tag) const
+    {
+        for (uint32 i = 0; i < MAX_TAGS_COUNT; i++)
+        {
+            if (mSlots[i].tag.load(std::memory_order_acquire) == tag)
+            {
+                return &mSlots[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    TaggedHeap::TagSlot* TaggedHeap::acquireSlot(Tag tag)
+    {
+        auto slot = findSlot(tag);
+        if (slot) return slot;
+
+        std::lock_guard<std::mutex> guard(mSlotsMutex);
+
+        // Check again: other thread could register tag before lock
+
+        slot = findSlot(tag);
+        if (slot) return slot;
+
+        for (uint32 i = 0; i < MAX_TAGS_COUNT; i++)
+        {
+            if (mSlots[i].tag.load(std::memory_order_relaxed) == NO_TAG)
+            {
+                mSlots[i].blocks.store(0, std::memory_order_relaxed);
+                mSlots[i].peak.store(0, std::memory_order_relaxed);
+                mSlots[i].acquires.store(0, std::memory_order_relaxed);
+                mSlots[i].tag.store(tag, std::memory_order_release);
+
+                return &mSlots[i];
+            }
+        }
+
+        FAIL(false, "TaggedHeap: too many tags with acquired blocks (max: %u)", MAX_TAGS_COUNT);
+        return nullptr;
+    }
+
+    void TaggedHeap::push(uint32 index)
+    {
+        auto head = mFreeHead.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            mNext[index].store((uint32)head, std::memory_order_relaxed);
+            uint64 updated = (((head >> 32) + 1) << 32) | index;
+
+            if (mFreeHead.compare_exchange_weak(head, updated, std::memory_order_release, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        mFreeBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32 TaggedHeap::pop()
+    {
+        auto head = mFreeHead.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            auto index = (uint32)head;
+            if (index == BLOCK_NONE) return BLOCK_NONE;
+
+            auto next = mNext[index].load(std::memory_order_relaxed);
+            uint64 updated = (((head >> 32) + 1) << 32) | next;
+
+            if (mFreeHead.compare_exchange_weak(head, updated, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                mFreeBlocks.fetch_sub(1, std::memory_order_relaxed);
+                return index;
+            }
+        }
+    }
+
+} // namespace Berserk
@@ -0,0 +1,209 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Platform.h"
+#include "Misc/Alignment.h"
+#include "Logging/LogMacros.h"
+#include "Memory/VirtualArenaAllocator.h"
+
+#if PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+namespace Berserk
+{
+
+    VirtualArenaAllocator::VirtualArenaAllocator(uint64 reserveSize, uint32 commitSize, bool useHugePages) : IAllocator()
+    {
+        FAIL(reserveSize > 0, "VirtualArenaAllocator: reserve size must be more than 0");
+
+        uint32 pageSize = getPageSize();
+        if (commitSize < pageSize) commitSize = pageSize;
+        if (useHugePages && commitSize < HUGE_PAGE_SIZE) commitSize = HUGE_PAGE_SIZE;
+        commitSize = ((commitSize + pageSize - 1) / pageSize) * pageSize;
+
+        mCommitSize = commitSize;
+        mReserved = ((reserveSize + commitSize - 1) / commitSize) * commitSize;
+        mCommitted = 0;
+        mUsage = 0;
+        mPeakUsage = 0;
+        mUsesHugePages = false;
+
+        // Range is over-reserved to align it on commit size:
+        // with huge pages each commit is backed by whole 2 MiB pages
+
+        mMappingSize = mReserved + (useHugePages ? commitSize : 0);
+
+#if PLATFORM_WINDOWS
+        mMapping = VirtualAlloc(nullptr, mMappingSize, MEM_RESERVE, PAGE_NOACCESS);
+        FAIL(mMapping != nullptr, "VirtualArenaAllocator: cannot reserve memory (size: %lu)", mMappingSize);
+#else
+        mMapping = mmap(nullptr, mMappingSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        FAIL(mMapping != MAP_FAILED, "VirtualArenaAllocator: cannot reserve memory (size: %lu)", mMappingSize);
+#endif
+
+        auto address = (uint64) mMapping;
+        if (useHugePages) address = (address + commitSize - 1) & ~((uint64)commitSize - 1);
+        mRegion = (uint8*) address;
+
+#if !PLATFORM_WINDOWS && defined(MADV_HUGEPAGE)
+        if (useHugePages && madvise(mRegion, mReserved, MADV_HUGEPAGE) == 0)
+        {
+            mUsesHugePages = true;
+        }
+#endif
+
+#if PROFILE_VIRTUAL_ARENA_ALLOCATOR
+        profile("create");
+#endif
+    }
+
+    VirtualArenaAllocator::~VirtualArenaAllocator()
+    {
+        if (mMapping)
+        {
+#if PLATFORM_WINDOWS
+            VirtualFree(mMapping, 0, MEM_RELEASE);
+#else
+            munmap(mMapping, mMappingSize);
+#endif
+
+#if PROFILE_VIRTUAL_ARENA_ALLOCATOR
+            profile("delete");
+#endif
+
+            mMapping = nullptr;
+            mRegion = nullptr;
+        }
+    }
+
+    void* VirtualArenaAllocator::allocate(uint32 size)
+    {
+        return allocate(size, MEMORY_ALIGNMENT);
+    }
+
+    void* VirtualArenaAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isValidAlignment(alignment), "Alignment must be power of 2 [%u]", alignment);
+        ALIGN(size);
+
+        auto pointer = alignPointer(mRegion + mUsage, alignment);
+        auto end = (uint64)(pointer - mRegion) + size;
+
+        FAIL(end <= mReserved, "VirtualArenaAllocator: cannot allocate memory. Reserved range is full (size: %u)", size);
+
+        if (end > mCommitted) commit(end);
+
+        trackAllocate(end - mUsage);
+
+        mUsage = end;
+        if (mUsage > mPeakUsage) mPeakUsage = mUsage;
+        mAllocCalls += 1;
+
+        return pointer;
+    }
+
+    void VirtualArenaAllocator::clear()
+    {
+        // Usage of this cycle was low: the rest of pages most
+        // likely will not be needed in the next cycles too
+
+        if (mPeakUsage * DECOMMIT_FACTOR < mCommitted)
+        {
+            uint64 keep = ((mPeakUsage + mCommitSize - 1) / mCommitSize) * mCommitSize;
+            decommit(keep);
+        }
+
+        trackFree(mUsage);
+
+        mUsage = 0;
+        mPeakUsage = 0;
+    }
+
+    void VirtualArenaAllocator::rewind(Marker marker)
+    {
+        FAIL(marker <= mUsage, "VirtualArenaAllocator: marker %lu is after current position %lu", marker, mUsage);
+        trackFree(mUsage - marker);
+        mUsage = marker;
+    }
+
+    void VirtualArenaAllocator::decommit()
+    {
+        FAIL(mUsage == 0, "VirtualArenaAllocator: cannot decommit memory in use (usage: %lu)", mUsage);
+        decommit(0);
+        mPeakUsage = 0;
+    }
+
+    void VirtualArenaAllocator::commit(uint64 size)
+    {
+        uint64 committed = ((size + mCommitSize - 1) / mCommitSize) * mCommitSize;
+        if (committed > mReserved) committed = mReserved;
+
+        auto start = mRegion + mCommitted;
+        auto length = committed - mCommitted;
+
+#if PLATFORM_WINDOWS
+        auto result = VirtualAlloc(start, length, MEM_COMMIT, PAGE_READWRITE);
+        FAIL(result != nullptr, "VirtualArenaAllocator: cannot commit memory (size: %lu)", length);
+#else
+        auto result = mprotect(start, length, PROT_READ | PROT_WRITE);
+        FAIL(result == 0, "VirtualArenaAllocator: cannot commit memory (size: %lu)", length);
+#endif
+
+        mCommitted = committed;
+        mTotalMemUsage = mCommitted;
+
+#if PROFILE_VIRTUAL_ARENA_ALLOCATOR
+        profile("commit");
+#endif
+    }
+
+    void VirtualArenaAllocator::decommit(uint64 offset)
+    {
+        if (offset >= mCommitted) return;
+
+        auto start = mRegion + offset;
+        auto length = mCommitted - offset;
+
+#if PLATFORM_WINDOWS
+        VirtualFree(start, length, MEM_DECOMMIT);
+#else
+        // Drop physical pages and make range inaccessible again
+
+        madvise(start, length, MADV_DONTNEED);
+        mprotect(start, length, PROT_NONE);
+#endif
+
+        mCommitted = offset;
+        mTotalMemUsage = mCommitted;
+
+#if PROFILE_VIRTUAL_ARENA_ALLOCATOR
+        profile("decommit");
+#endif
+    }
+
+    uint32 VirtualArenaAllocator::getPageSize()
+    {
+#if PLATFORM_WINDOWS
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return (uint32) info.dwPageSize;
+#else
+        return (uint32) sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+#if PROFILE_VIRTUAL_ARENA_ALLOCATOR
+    void VirtualArenaAllocator::profile(const char* msg) const
+    {
+        PUSH("VirtualArenaAllocator: %s: usage: %lu | committed: %lu | reserved: %lu | huge pages: %i",
+             msg, mUsage, mCommitted, mReserved, mUsesHugePages);
+    }
+#endif
+
+} // namespace Berserk
@@ -3,6 +3,21 @@
 //
 
 #include "Misc/Crc32.h"
+#include "Misc/Include.h"
+#include "Misc/Platform.h"
+
+#if defined(TARGET_x86_64) && (defined(__x86_64__) || defined(_M_X64))
+    #define CRC32_HARDWARE 1
+    #include <nmmintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define CRC32_TARGET
+    #else
+        #define CRC32_TARGET __attribute__((target("sse4.2")))
+    #endif
+#else
+    #define CRC32_HARDWARE 0
+#endif
 
 namespace Berserk
 {
@@ -15,6 +30,13 @@ namespace Berserk
         Revert: true
         XorOut: 0xFFFFFFFF
         Check : 0xCBF43926 ("123456789")
+
+        Name  : CRC-32C (Castagnoli)
+        Poly  : 0x1EDC6F41 (reflected 0x82F63B78)
+        Init  : 0xFFFFFFFF
+        Revert: true
+        XorOut: 0xFFFFFFFF
+        Check : 0xE3069283 ("123456789")
     */
 
     static const uint32 Crc32Table[256] =
@@ -85,76 +107,188 @@ namespace Berserk
             0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
     };
 
-    uint32 Crc32::hash(float32 value)
+    /** Reflected Castagnoli polynomial */
+    static const uint32 CASTAGNOLI_POLYNOMIAL = 0x82F63B78;
+
+    /**
+     * Tables for slicing-by-8: table[k][b] is CRC of byte b followed by k zero
+     * bytes, so 8 input bytes are processed with 8 independent lookups
+     */
+    struct SlicingTables
     {
-        const char* buffer = (char*)&value;
-        int32 len = 4;
+        uint32 table[8][256];
 
-        uint32 crc = 0xFFFFFFFF;
+        /** Builds tables from byte-wise table of polynomial */
+        explicit SlicingTables(const uint32* base)
+        {
+            for (uint32 i = 0; i < 256; i++) table[0][i] = base[i];
+            extend();
+        }
 
-        while (len--)
+        /** Builds tables from reflected polynomial */
+        explicit SlicingTables(uint32 polynomial)
         {
-            crc = (crc >> 8) ^ Crc32Table[(crc ^ *buffer++) & 0xFF];
+            for (uint32 i = 0; i < 256; i++)
+            {
+                uint32 crc = i;
+                for (uint32 j = 0; j < 8; j++) crc = (crc >> 1) ^ (polynomial & (0u - (crc & 1)));
+                table[0][i] = crc;
+            }
+
+            extend();
         }
 
-        return crc ^ 0xFFFFFFFF;
+        void extend()
+        {
+            for (uint32 k = 1; k < 8; k++)
+            {
+                for (uint32 i = 0; i < 256; i++)
+                {
+                    uint32 previous = table[k - 1][i];
+                    table[k][i] = (previous >> 8) ^ table[0][previous & 0xFF];
+                }
+            }
+        }
+    };
+
+    /** Tables are built on first use (could be called while static initialization) */
+    static const SlicingTables& getIEEETables()
+    {
+        static SlicingTables tables(Crc32Table);
+        return tables;
     }
 
-    uint32 Crc32::hash(int32 value)
+    static const SlicingTables& getCastagnoliTables()
+    {
+        static SlicingTables tables(CASTAGNOLI_POLYNOMIAL);
+        return tables;
+    }
+
+    /** Slicing-by-8 update of crc (little-endian targets) */
+    static uint32 update(const SlicingTables& tables, uint32 crc, const uint8* buffer, uint64 len)
     {
-        const char* buffer = (char*)&value;
-        int32 len = 4;
+        auto& t = tables.table;
+
+        while (len >= 8)
+        {
+            uint32 low, high;
+            memcpy(&low, buffer, sizeof(uint32));
+            memcpy(&high, buffer + 4, sizeof(uint32));
+            low ^= crc;
 
-        uint32 crc = 0xFFFFFFFF;
+            crc = t[7][low & 0xFF]          ^ t[6][(low >> 8) & 0xFF]  ^
+                  t[5][(low >> 16) & 0xFF]  ^ t[4][low >> 24]          ^
+                  t[3][high & 0xFF]         ^ t[2][(high >> 8) & 0xFF] ^
+                  t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+
+            buffer += 8;
+            len -= 8;
+        }
 
         while (len--)
         {
-            crc = (crc >> 8) ^ Crc32Table[(crc ^ *buffer++) & 0xFF];
+            crc = (crc >> 8) ^ t[0][(crc ^ *buffer++) & 0xFF];
         }
 
-        return crc ^ 0xFFFFFFFF;
+        return crc;
     }
 
-    uint32 Crc32::hash(float64 value)
+#if CRC32_HARDWARE
+
+    /** CRC-32C via SSE 4.2 instruction (8 bytes per instruction) */
+    CRC32_TARGET static uint32 updateHardware(uint32 crc, const uint8* buffer, uint64 len)
     {
-        const char* buffer = (char*)&value;
-        int32 len = 8;
+        uint64 crc64 = crc;
+
+        while (len >= 8)
+        {
+            uint64 value;
+            memcpy(&value, buffer, sizeof(uint64));
+            crc64 = _mm_crc32_u64(crc64, value);
+
+            buffer += 8;
+            len -= 8;
+        }
 
-        uint32 crc = 0xFFFFFFFF;
+        crc = (uint32) crc64;
 
         while (len--)
         {
-            crc = (crc >> 8) ^ Crc32Table[(crc ^ *buffer++) & 0xFF];
+            crc = _mm_crc32_u8(crc, *buffer++);
         }
 
-        return crc ^ 0xFFFFFFFF;
+        return crc;
     }
 
-    uint32 Crc32::hash(int64 value)
+    static bool isSSE42Supported()
     {
-        const char* buffer = (char*)&value;
-        int32 len = 8;
+#if defined(_MSC_VER)
+        int32 info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        return __builtin_cpu_supports("sse4.2");
+#endif
+    }
 
-        uint32 crc = 0xFFFFFFFF;
+#endif
 
-        while (len--)
-        {
-            crc = (crc >> 8) ^ Crc32Table[(crc ^ *buffer++) & 0xFF];
-        }
+    /** Chosen once on the first call */
+    static bool useHardwareCastagnoli()
+    {
+#if CRC32_HARDWARE
+        static bool supported = isSSE42Supported();
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    uint32 Crc32::hash(float32 value)
+    {
+        return hash((const char*)&value, sizeof(float32));
+    }
+
+    uint32 Crc32::hash(int32 value)
+    {
+        return hash((const char*)&value, sizeof(int32));
+    }
 
-        return crc ^ 0xFFFFFFFF;
+    uint32 Crc32::hash(float64 value)
+    {
+        return hash((const char*)&value, sizeof(float64));
+    }
+
+    uint32 Crc32::hash(int64 value)
+    {
+        return hash((const char*)&value, sizeof(int64));
     }
 
     uint32 Crc32::hash(const char* buffer, uint32 len)
     {
-        uint32 crc = 0xFFFFFFFF;
+        return update(getIEEETables(), 0xFFFFFFFF, (const uint8*)buffer, len) ^ 0xFFFFFFFF;
+    }
 
-        while (len--)
+    uint32 Crc32::hashCastagnoli(const void *buffer, uint32 len)
+    {
+#if CRC32_HARDWARE
+        if (useHardwareCastagnoli())
         {
-            crc = (crc >> 8) ^ Crc32Table[(crc ^ *buffer++) & 0xFF];
+            return updateHardware(0xFFFFFFFF, (const uint8*)buffer, len) ^ 0xFFFFFFFF;
         }
+#endif
+
+        return hashCastagnoliSoftware(buffer, len);
+    }
 
-        return crc ^ 0xFFFFFFFF;
+    uint32 Crc32::hashCastagnoliSoftware(const void *buffer, uint32 len)
+    {
+        return update(getCastagnoliTables(), 0xFFFFFFFF, (const uint8*)buffer, len) ^ 0xFFFFFFFF;
+    }
+
+    bool Crc32::isHardwareCastagnoli()
+    {
+        return useHardwareCastagnoli();
     }
 
 }
@@ -0,0 +1,118 @@
+//
+// Created by Egor Orachyov on 01.03.2019.
+//
+
+#include "Misc/Hash.h"
+#include "Misc/Include.h"
+
+namespace Berserk
+{
+
+    /*
+        Name  : wyhash (final version 3 by Wang Yi, public domain)
+        Step  : 48 bytes per loop iteration in 3 independent lanes,
+                each 16 bytes folded via 64x64->128 bit multiply
+        Tail  : up to 16 bytes with overlapping reads (no per-byte loop)
+    */
+
+    static const uint64 WY_SECRET[4] =
+    {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+        0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+    };
+
+    /** 128-bit product of a and b: low part in a, high part in b */
+    static FORCEINLINE void multiply(uint64& a, uint64& b)
+    {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t r = a;
+        r *= b;
+        a = (uint64) r;
+        b = (uint64) (r >> 64);
+#else
+        uint64 ha = a >> 32, hb = b >> 32, la = (uint32) a, lb = (uint32) b;
+        uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64 t = rl + (rm0 << 32), c = (t < rl);
+        uint64 lo = t + (rm1 << 32);
+        c += (lo < t);
+        uint64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        a = lo;
+        b = hi;
+#endif
+    }
+
+    static FORCEINLINE uint64 fold(uint64 a, uint64 b)
+    {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+    /** Unaligned reads (compiled in single load instruction) */
+    static FORCEINLINE uint64 read64(const uint8* p) { uint64 v; memcpy(&v, p, sizeof(uint64)); return v; }
+    static FORCEINLINE uint64 read32(const uint8* p) { uint32 v; memcpy(&v, p, sizeof(uint32)); return v; }
+    static FORCEINLINE uint64 read3(const uint8* p, uint64 k) { return (((uint64)p[0]) << 16) | (((uint64)p[k >> 1]) << 8) | p[k - 1]; }
+
+    uint64 Hash::hash64(const void *data, uint64 length, uint64 seed)
+    {
+        auto p = (const uint8*) data;
+        uint64 a, b;
+
+        seed ^= fold(seed ^ WY_SECRET[0], WY_SECRET[1]);
+
+        if (length <= 16)
+        {
+            if (length >= 4)
+            {
+                a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+                b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+            }
+            else if (length > 0)
+            {
+                a = read3(p, length);
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            uint64 i = length;
+
+            if (i > 48)
+            {
+                uint64 see1 = seed, see2 = seed;
+
+                do
+                {
+                    seed = fold(read64(p) ^ WY_SECRET[1], read64(p + 8) ^ seed);
+                    see1 = fold(read64(p + 16) ^ WY_SECRET[2], read64(p + 24) ^ see1);
+                    see2 = fold(read64(p + 32) ^ WY_SECRET[3], read64(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                }
+                while (i > 48);
+
+                seed ^= see1 ^ see2;
+            }
+
+            while (i > 16)
+            {
+                seed = fold(read64(p) ^ WY_SECRET[1], read64(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+
+        a ^= WY_SECRET[1];
+        b ^= seed;
+        multiply(a, b);
+
+        return fold(a ^ WY_SECRET[0] ^ length, b ^ WY_SECRET[1]);
+    }
+
+} // namespace Berserk
@@ -0,0 +1,316 @@
+//
+// Created by Egor Orachyov on 27.02.2019.
+//
+
+#include "Misc/Include.h"
+#include "Profiling/AllocationStats.h"
+
+namespace Berserk
+{
+
+    /** Increment of counter with single writer (without atomic RMW) */
+    template <typename T>
+    static void increment(std::atomic<T>& counter, T value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    uint32 AllocationStats::getChannel(const char *name)
+    {
+        return registerChannel(name, false);
+    }
+
+    uint32 AllocationStats::getTag(const char *name)
+    {
+        return registerChannel(name, true);
+    }
+
+    void AllocationStats::snapshot(Snapshot &snapshot)
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+        std::lock_guard<std::mutex> overflowGuard(OVERFLOW_MUTEX);
+
+        uint32 count = CHANNELS_COUNT.load(std::memory_order_acquire);
+
+        snapshot.channelsCount = count;
+        snapshot.threadsCount = 0;
+
+        for (auto shard = SHARDS.load(std::memory_order_acquire); shard != nullptr; shard = shard->next)
+        {
+            if (shard->used) snapshot.threadsCount += 1;
+        }
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            ChannelStats& stats = snapshot.channels[i];
+            Channel& channel = CHANNELS[i];
+
+            memset(&stats, 0, sizeof(ChannelStats));
+            stats.name = channel.name;
+            stats.isTag = channel.isTag;
+            stats.liveBytes = channel.live.load(std::memory_order_relaxed);
+
+            Shard* shard = SHARDS.load(std::memory_order_acquire);
+            bool overflow = false;
+
+            while (shard != nullptr)
+            {
+                ShardChannel& data = shard->channels[i];
+
+                stats.allocCalls += data.allocCalls.load(std::memory_order_relaxed);
+                stats.freeCalls += data.freeCalls.load(std::memory_order_relaxed);
+                stats.allocBytes += data.allocBytes.load(std::memory_order_relaxed);
+                stats.freeBytes += data.freeBytes.load(std::memory_order_relaxed);
+                stats.liveBytes += data.pending.load(std::memory_order_relaxed);
+
+                for (uint32 bin = 0; bin < HISTOGRAM_BINS; bin++)
+                {
+                    stats.histogram[bin] += data.histogram[bin].load(std::memory_order_relaxed);
+                }
+
+                shard = shard->next;
+
+                if (shard == nullptr && !overflow)
+                {
+                    shard = &OVERFLOW_SHARD;
+                    overflow = true;
+                }
+            }
+
+            // Not flushed deltas are seen only here: update high-water mark by exact value
+
+            auto peak = channel.peak.load(std::memory_order_relaxed);
+            while (peak < stats.liveBytes && !channel.peak.compare_exchange_weak(peak, stats.liveBytes, std::memory_order_relaxed));
+
+            stats.peakBytes = (peak > stats.liveBytes ? peak : stats.liveBytes);
+        }
+    }
+
+    void AllocationStats::exportJson(const Snapshot &snapshot, FILE *file)
+    {
+        fprintf(file, "{\n  \"threads\": %u,\n  \"channels\": [", snapshot.threadsCount);
+
+        for (uint32 i = 0; i < snapshot.channelsCount; i++)
+        {
+            const ChannelStats& stats = snapshot.channels[i];
+
+            fprintf(file, "%s\n    {\n      \"name\": \"", (i == 0 ? "" : ","));
+
+            for (auto c = stats.name; *c != '\0'; c++)
+            {
+                if (*c == '"' || *c == '\\') fputc('\\', file);
+                fputc(*c, file);
+            }
+
+            fprintf(file, "\",\n      \"type\": \"%s\",\n", (stats.isTag ? "tag" : "allocator"));
+            fprintf(file, "      \"allocCalls\": %lu,\n", stats.allocCalls);
+            fprintf(file, "      \"freeCalls\": %lu,\n", stats.freeCalls);
+            fprintf(file, "      \"allocBytes\": %lu,\n", stats.allocBytes);
+            fprintf(file, "      \"freeBytes\": %lu,\n", stats.freeBytes);
+            fprintf(file, "      \"liveBytes\": %li,\n", stats.liveBytes);
+            fprintf(file, "      \"peakBytes\": %li,\n", stats.peakBytes);
+            fprintf(file, "      \"histogram\": [");
+
+            for (uint32 bin = 0; bin < HISTOGRAM_BINS; bin++)
+            {
+                fprintf(file, "%s%lu", (bin == 0 ? "" : ", "), stats.histogram[bin]);
+            }
+
+            fprintf(file, "]\n    }");
+        }
+
+        fprintf(file, "\n  ]\n}\n");
+    }
+
+    uint32 AllocationStats::getBin(uint64 size)
+    {
+        if (size <= 1) return 0;
+
+        uint32 bin = 63 - (uint32) __builtin_clzll(size);
+        return (bin < HISTOGRAM_BINS ? bin : HISTOGRAM_BINS - 1);
+    }
+
+    void AllocationStats::registerAllocate(uint32 channel, uint64 size)
+    {
+        std::unique_lock<std::mutex> lock;
+        Shard* shard;
+
+        if (THREAD_SHARD_RELEASED)
+        {
+            // Allocations from thread-exit destructors of other objects
+            lock = std::unique_lock<std::mutex>(OVERFLOW_MUTEX);
+            shard = &OVERFLOW_SHARD;
+        }
+        else
+        {
+            shard = getShard();
+        }
+
+        auto bin = getBin(size);
+        ShardChannel& data = shard->channels[channel];
+
+        increment(data.allocCalls, (uint64)1);
+        increment(data.allocBytes, size);
+        increment(data.histogram[bin], (uint32)1);
+        increment(data.pending, (int64)size);
+
+        if (data.pending.load(std::memory_order_relaxed) >= FLUSH_BYTES) flush(channel, data);
+
+        if (THREAD_TAG != NO_CHANNEL && THREAD_TAG != channel)
+        {
+            ShardChannel& tag = shard->channels[THREAD_TAG];
+
+            increment(tag.allocCalls, (uint64)1);
+            increment(tag.allocBytes, size);
+            increment(tag.histogram[bin], (uint32)1);
+            increment(tag.pending, (int64)size);
+
+            if (tag.pending.load(std::memory_order_relaxed) >= FLUSH_BYTES) flush(THREAD_TAG, tag);
+        }
+    }
+
+    void AllocationStats::registerFree(uint32 channel, uint64 size, uint32 tag)
+    {
+        std::unique_lock<std::mutex> lock;
+        Shard* shard;
+
+        if (THREAD_SHARD_RELEASED)
+        {
+            lock = std::unique_lock<std::mutex>(OVERFLOW_MUTEX);
+            shard = &OVERFLOW_SHARD;
+        }
+        else
+        {
+            shard = getShard();
+        }
+
+        ShardChannel& data = shard->channels[channel];
+
+        increment(data.freeCalls, (uint64)1);
+        increment(data.freeBytes, size);
+        increment(data.pending, -(int64)size);
+
+        if (data.pending.load(std::memory_order_relaxed) <= -FLUSH_BYTES) flush(channel, data);
+
+        if (tag != NO_CHANNEL && tag != channel)
+        {
+            ShardChannel& tagData = shard->channels[tag];
+
+            increment(tagData.freeCalls, (uint64)1);
+            increment(tagData.freeBytes, size);
+            increment(tagData.pending, -(int64)size);
+
+            if (tagData.pending.load(std::memory_order_relaxed) <= -FLUSH_BYTES) flush(tag, tagData);
+        }
+    }
+
+    uint32 AllocationStats::registerChannel(const char *name, bool isTag)
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+
+        uint32 count = CHANNELS_COUNT.load(std::memory_order_relaxed);
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            if (CHANNELS[i].isTag == isTag && strncmp(CHANNELS[i].name, name, MAX_NAME_LENGTH - 1) == 0)
+            {
+                return i;
+            }
+        }
+
+        if (count == MAX_CHANNELS_COUNT) return NO_CHANNEL;
+
+        Channel& channel = CHANNELS[count];
+        strncpy(channel.name, name, MAX_NAME_LENGTH - 1);
+        channel.name[MAX_NAME_LENGTH - 1] = '\0';
+        channel.isTag = isTag;
+        channel.live.store(0, std::memory_order_relaxed);
+        channel.peak.store(0, std::memory_order_relaxed);
+
+        CHANNELS_COUNT.store(count + 1, std::memory_order_release);
+
+        return count;
+    }
+
+    void AllocationStats::flush(uint32 channel, ShardChannel &data)
+    {
+        auto delta = data.pending.load(std::memory_order_relaxed);
+        data.pending.store(0, std::memory_order_relaxed);
+
+        Channel& global = CHANNELS[channel];
+        auto live = global.live.fetch_add(delta, std::memory_order_relaxed) + delta;
+        auto peak = global.peak.load(std::memory_order_relaxed);
+
+        while (peak < live && !global.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+    }
+
+    AllocationStats::Shard* AllocationStats::getShard()
+    {
+        if (THREAD_SHARD) return THREAD_SHARD;
+
+        std::lock_guard<std::mutex> guard(MUTEX);
+
+        // Shards of exited threads are reused: their counters stay in totals
+
+        Shard* shard = SHARDS.load(std::memory_order_relaxed);
+        while (shard != nullptr && shard->used) shard = shard->next;
+
+        if (shard == nullptr)
+        {
+            // Not engine allocators: they could be tracked themselves
+            shard = new (calloc(1, sizeof(Shard))) Shard();
+            shard->next = SHARDS.load(std::memory_order_relaxed);
+            SHARDS.store(shard, std::memory_order_release);
+        }
+
+        shard->used = true;
+
+        // Odr-use of holder registers its destructor for this thread
+        (void) &THREAD_SHARD_HOLDER;
+
+        THREAD_SHARD = shard;
+        return shard;
+    }
+
+    AllocationStats::ShardHolder::~ShardHolder()
+    {
+        if (THREAD_SHARD)
+        {
+            uint32 count = CHANNELS_COUNT.load(std::memory_order_acquire);
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                flush(i, THREAD_SHARD->channels[i]);
+            }
+
+            std::lock_guard<std::mutex> guard(MUTEX);
+            THREAD_SHARD->used = false;
+            THREAD_SHARD = nullptr;
+        }
+
+        THREAD_SHARD_RELEASED = true;
+    }
+
+    std::atomic<bool> AllocationStats::ENABLED(true);
+
+    std::atomic<uint32> AllocationStats::CHANNELS_COUNT(0);
+
+    std::atomic<AllocationStats::Shard*> AllocationStats::SHARDS(nullptr);
+
+    std::mutex AllocationStats::MUTEX;
+
+    std::mutex AllocationStats::OVERFLOW_MUTEX;
+
+    AllocationStats::Channel AllocationStats::CHANNELS[MAX_CHANNELS_COUNT];
+
+    AllocationStats::Shard AllocationStats::OVERFLOW_SHARD;
+
+    thread_local AllocationStats::Shard* AllocationStats::THREAD_SHARD = nullptr;
+
+    thread_local bool AllocationStats::THREAD_SHARD_RELEASED = false;
+
+    thread_local uint32 AllocationStats::THREAD_TAG = AllocationStats::NO_CHANNEL;
+
+    thread_local AllocationStats::ShardHolder AllocationStats::THREAD_SHARD_HOLDER;
+
+} // namespace Berserk
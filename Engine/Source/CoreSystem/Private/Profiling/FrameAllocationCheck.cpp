@@ -0,0 +1,238 @@
+//
+// Created by Egor Orachyov on 27.02.2019.
+//
+
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+#include "Misc/Platform.h"
+#include "Logging/LogMacros.h"
+#include "Profiling/FrameAllocationCheck.h"
+
+#if PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <execinfo.h>
+#endif
+
+namespace Berserk
+{
+
+    void FrameAllocationCheck::enable(uint32 warmUpFrames, bool failOnAllocation)
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+
+        ENABLED = true;
+        FAIL_ON_ALLOCATION = failOnAllocation;
+        WARM_UP_FRAMES = warmUpFrames;
+        FRAMES_COUNT = 0;
+        ALLOCATING_FRAMES_COUNT = 0;
+        CHECKED_FRAMES_COUNT = 0;
+        LAST_FRAME_ALLOCATIONS = 0;
+    }
+
+    void FrameAllocationCheck::disable()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+
+        ENABLED = false;
+        RECORDING.store(false, std::memory_order_relaxed);
+    }
+
+    void FrameAllocationCheck::beginFrame()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+
+        if (!ENABLED) return;
+
+        FRAMES_COUNT += 1;
+        if (FRAMES_COUNT <= WARM_UP_FRAMES) return;
+
+        CALL_SITES_COUNT = 0;
+        OTHER_COUNT = 0;
+        OTHER_BYTES = 0;
+
+        RECORDING.store(true, std::memory_order_relaxed);
+    }
+
+    void FrameAllocationCheck::endFrame()
+    {
+        {
+            std::lock_guard<std::mutex> guard(MUTEX);
+
+            if (!RECORDING.load(std::memory_order_relaxed)) return;
+
+            // Report itself allocates (symbols and log
+            // messages), therefore recording is stopped first
+
+            RECORDING.store(false, std::memory_order_relaxed);
+
+            uint32 allocations = OTHER_COUNT;
+            for (uint32 i = 0; i < CALL_SITES_COUNT; i++) allocations += CALL_SITES[i].count;
+
+            LAST_FRAME_ALLOCATIONS = allocations;
+            CHECKED_FRAMES_COUNT += 1;
+
+            if (allocations == 0) return;
+
+            ALLOCATING_FRAMES_COUNT += 1;
+        }
+
+        report();
+
+        FAIL(!FAIL_ON_ALLOCATION, "FrameAllocationCheck: frame %u made %u allocations after warm-up",
+             FRAMES_COUNT, LAST_FRAME_ALLOCATIONS);
+    }
+
+    bool FrameAllocationCheck::isEnabled()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+        return ENABLED;
+    }
+
+    uint32 FrameAllocationCheck::getLastFrameAllocations()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+        return LAST_FRAME_ALLOCATIONS;
+    }
+
+    uint32 FrameAllocationCheck::getAllocatingFramesCount()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+        return ALLOCATING_FRAMES_COUNT;
+    }
+
+    uint32 FrameAllocationCheck::getCheckedFramesCount()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+        return CHECKED_FRAMES_COUNT;
+    }
+
+    void FrameAllocationCheck::record(uint64 size)
+    {
+        if (THREAD_RECORDING) return;
+        THREAD_RECORDING = true;
+
+        void* stack[SKIPPED_STACK_FRAMES + MAX_STACK_DEPTH];
+
+#if PLATFORM_WINDOWS
+        uint32 captured = CaptureStackBackTrace(0, SKIPPED_STACK_FRAMES + MAX_STACK_DEPTH, stack, nullptr);
+#else
+        uint32 captured = (uint32) backtrace(stack, SKIPPED_STACK_FRAMES + MAX_STACK_DEPTH);
+#endif
+
+        uint32 skipped = (captured > SKIPPED_STACK_FRAMES ? SKIPPED_STACK_FRAMES : captured);
+        uint32 depth = captured - skipped;
+        void** frames = stack + skipped;
+
+        {
+            std::lock_guard<std::mutex> guard(MUTEX);
+
+            // Frame could end while stack was captured
+
+            if (RECORDING.load(std::memory_order_relaxed))
+            {
+                CallSite* site = nullptr;
+
+                for (uint32 i = 0; i < CALL_SITES_COUNT; i++)
+                {
+                    CallSite& current = CALL_SITES[i];
+
+                    if (current.depth == depth && memcmp(current.stack, frames, sizeof(void*) * depth) == 0)
+                    {
+                        site = &current;
+                        break;
+                    }
+                }
+
+                if (site == nullptr && CALL_SITES_COUNT < MAX_CALL_SITES)
+                {
+                    site = &CALL_SITES[CALL_SITES_COUNT];
+                    CALL_SITES_COUNT += 1;
+
+                    memcpy(site->stack, frames, sizeof(void*) * depth);
+                    site->depth = depth;
+                    site->count = 0;
+                    site->bytes = 0;
+                }
+
+                if (site)
+                {
+                    site->count += 1;
+                    site->bytes += size;
+                }
+                else
+                {
+                    OTHER_COUNT += 1;
+                    OTHER_BYTES += size;
+                }
+            }
+        }
+
+        THREAD_RECORDING = false;
+    }
+
+    void FrameAllocationCheck::report()
+    {
+        std::lock_guard<std::mutex> guard(MUTEX);
+
+        WARNING("FrameAllocationCheck: frame %u made %u allocations after warm-up [call sites: %u]",
+                FRAMES_COUNT, LAST_FRAME_ALLOCATIONS, CALL_SITES_COUNT);
+
+        for (uint32 i = 0; i < CALL_SITES_COUNT; i++)
+        {
+            CallSite& site = CALL_SITES[i];
+
+            PUSH("FrameAllocationCheck: call site %u: calls: %u | bytes: %lu", i, site.count, site.bytes);
+
+#if PLATFORM_WINDOWS
+            for (uint32 j = 0; j < site.depth; j++)
+            {
+                PUSH("    [%u] %p", j, site.stack[j]);
+            }
+#else
+            char** symbols = backtrace_symbols(site.stack, (int32) site.depth);
+
+            for (uint32 j = 0; j < site.depth; j++)
+            {
+                PUSH("    [%u] %s", j, (symbols ? symbols[j] : "?"));
+            }
+
+            ::free(symbols);
+#endif
+        }
+
+        if (OTHER_COUNT > 0)
+        {
+            PUSH("FrameAllocationCheck: other call sites: calls: %u | bytes: %lu", OTHER_COUNT, OTHER_BYTES);
+        }
+    }
+
+    std::atomic<bool> FrameAllocationCheck::RECORDING(false);
+
+    std::mutex FrameAllocationCheck::MUTEX;
+
+    bool FrameAllocationCheck::ENABLED = false;
+
+    bool FrameAllocationCheck::FAIL_ON_ALLOCATION = false;
+
+    uint32 FrameAllocationCheck::WARM_UP_FRAMES = 0;
+
+    uint32 FrameAllocationCheck::FRAMES_COUNT = 0;
+
+    FrameAllocationCheck::CallSite FrameAllocationCheck::CALL_SITES[MAX_CALL_SITES];
+
+    uint32 FrameAllocationCheck::CALL_SITES_COUNT = 0;
+
+    uint32 FrameAllocationCheck::OTHER_COUNT = 0;
+
+    uint64 FrameAllocationCheck::OTHER_BYTES = 0;
+
+    uint32 FrameAllocationCheck::LAST_FRAME_ALLOCATIONS = 0;
+
+    uint32 FrameAllocationCheck::ALLOCATING_FRAMES_COUNT = 0;
+
+    uint32 FrameAllocationCheck::CHECKED_FRAMES_COUNT = 0;
+
+    thread_local bool FrameAllocationCheck::THREAD_RECORDING = false;
+
+} // namespace Berserk
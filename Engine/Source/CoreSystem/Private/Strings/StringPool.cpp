@@ -15,7 +15,8 @@ namespace Berserk
 
         for (uint32 i = 0; i < Supported; i++)
         {
-            new(&mPool[i]) PoolAllocator(getChunkSize(POOL_STRING_SIZES[i]), count[i]);
+            new(&mPool[i]) ConcurrentPoolAllocator(getChunkSize(POOL_STRING_SIZES[i]), count[i]);
+            mPool[i].setStatsName("StringPool");
         }
     }
 
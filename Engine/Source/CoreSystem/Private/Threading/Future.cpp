@@ -0,0 +1,254 @@
+//
+// Created by Egor Orachyov on 07.02.2019.
+//
+
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include "Misc/Assert.h"
+#include "Threading/Future.h"
+#include "Threading/ThreadPool.h"
+
+namespace Berserk
+{
+
+    /** Waiting threads of all the futures: completer locks only if there are waiting threads */
+    static std::mutex gWaitMutex;
+    static std::condition_variable gWaitCondition;
+    static std::atomic<uint32> gWaitingThreads(0);
+
+    /** Marks stack of continuations of done future (new continuations are submitted at once) */
+    static uint8 gDoneMarker;
+    static Future* const DONE_MARKER = (Future*) &gDoneMarker;
+
+    void Future::wait() const
+    {
+        if (done()) return;
+
+        // Flag is checked with seq_cst order after counter increment:
+        // completer either sees waiting thread or flag is seen here
+
+        std::unique_lock<std::mutex> lock(gWaitMutex);
+        gWaitingThreads.fetch_add(1);
+        gWaitCondition.wait(lock, [this]() { return mDone.load(); });
+        gWaitingThreads.fetch_sub(1);
+    }
+
+    bool Future::waitFor(float64 seconds) const
+    {
+        if (done()) return true;
+
+        auto timeout = std::chrono::duration<float64>(seconds);
+
+        std::unique_lock<std::mutex> lock(gWaitMutex);
+        gWaitingThreads.fetch_add(1);
+        bool done = gWaitCondition.wait_for(lock, timeout, [this]() { return mDone.load(); });
+        gWaitingThreads.fetch_sub(1);
+
+        return done;
+    }
+
+    void Future::then(IRunnable *runnable, Future &continuation)
+    {
+        FAIL(mPool != nullptr, "Future: future is not submitted in pool");
+
+        continuation.reset(runnable, mPool);
+
+        Future* head = mContinuations.load(std::memory_order_acquire);
+
+        while (head != DONE_MARKER)
+        {
+            continuation.mNext = head;
+
+            if (mContinuations.compare_exchange_weak(head, &continuation, std::memory_order_release, std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+
+        mPool->schedule(&continuation);
+    }
+
+    void Future::whenAll(Future *futures, uint32 count, Future &result)
+    {
+        group(futures, count, result, false);
+    }
+
+    void Future::whenAny(Future *futures, uint32 count, Future &result)
+    {
+        FAIL(count > 0, "Future: no futures in group");
+        group(futures, count, result, true);
+    }
+
+    void Future::waitAll(const Future *futures, uint32 count)
+    {
+        for (uint32 i = 0; i < count; i++)
+        {
+            futures[i].wait();
+        }
+    }
+
+    uint32 Future::waitAny(const Future *futures, uint32 count)
+    {
+        FAIL(count > 0, "Future: no futures to wait");
+
+        uint32 index = 0;
+
+        auto anyDone = [&]()
+        {
+            for (uint32 i = 0; i < count; i++)
+            {
+                if (futures[i].mDone.load())
+                {
+                    index = i;
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+        if (anyDone()) return index;
+
+        std::unique_lock<std::mutex> lock(gWaitMutex);
+        gWaitingThreads.fetch_add(1);
+        gWaitCondition.wait(lock, anyDone);
+        gWaitingThreads.fetch_sub(1);
+
+        return index;
+    }
+
+    void Future::reset(IRunnable *runnable, ThreadPool *pool)
+    {
+        Future* marker = DONE_MARKER;
+
+        mDone.store(false, std::memory_order_relaxed);
+        mResult = 0;
+        mRunnable = runnable;
+        mPool = pool;
+        mContinuations.compare_exchange_strong(marker, nullptr, std::memory_order_relaxed);
+
+        marker = DONE_MARKER;
+        mGroup.compare_exchange_strong(marker, nullptr, std::memory_order_relaxed);
+    }
+
+    void Future::complete(int32 result)
+    {
+        // Continuations are taken before done flag is set: waiting
+        // thread could destroy this future as soon as flag is set
+
+        ThreadPool* pool = mPool;
+        mResult = result;
+
+        Future* continuation = mContinuations.exchange(DONE_MARKER, std::memory_order_acq_rel);
+        Future* group = mGroup.exchange(DONE_MARKER, std::memory_order_acq_rel);
+        uint32 index = mGroupIndex;
+        mDone.store(true);
+
+        if (gWaitingThreads.load() > 0)
+        {
+            std::lock_guard<std::mutex> guard(gWaitMutex);
+            gWaitCondition.notify_all();
+        }
+
+        while (continuation != nullptr)
+        {
+            Future* next = continuation->mNext;
+            pool->schedule(continuation);
+            continuation = next;
+        }
+
+        if (group != nullptr)
+        {
+            group->signal(index);
+        }
+    }
+
+    void Future::group(Future *futures, uint32 count, Future &result, bool any)
+    {
+        FAIL(count == 0 || futures[0].mPool != nullptr, "Future: future is not submitted in pool");
+
+        // Result is prepared before registration: futures
+        // could be done and signal it at once
+
+        result.reset(nullptr, (count > 0 ? futures[0].mPool : nullptr));
+        result.mResult = (int32) count;
+        result.mAny = any;
+        result.mWinner.store(NO_INDEX, std::memory_order_relaxed);
+        result.mMembers = futures;
+        result.mMembersCount = count;
+        result.mRemaining.store(count, std::memory_order_relaxed);
+
+        if (count == 0)
+        {
+            result.complete(result.mResult);
+            return;
+        }
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            Future& future = futures[i];
+            Future* expected = nullptr;
+
+            future.mGroupIndex = i;
+
+            if (future.mGroup.compare_exchange_strong(expected, &result))
+            {
+                // Any-group could be already won: winner does not see this
+                // future, if it checked it before registration
+
+                Future* registered = &result;
+
+                if (any && result.mWinner.load() != NO_INDEX && future.mGroup.compare_exchange_strong(registered, nullptr))
+                {
+                    result.release(1);
+                }
+
+                continue;
+            }
+
+            FAIL(expected == DONE_MARKER, "Future: future is already in group");
+            result.signal(i);
+        }
+    }
+
+    void Future::signal(uint32 index)
+    {
+        uint32 released = 1;
+
+        if (mAny)
+        {
+            uint32 expected = NO_INDEX;
+
+            if (mWinner.compare_exchange_strong(expected, index))
+            {
+                // Not done futures must not signal result after it is
+                // done: it could be destroyed or reused in new group
+
+                for (uint32 i = 0; i < mMembersCount; i++)
+                {
+                    Future* registered = this;
+
+                    if (i != index && mMembers[i].mGroup.compare_exchange_strong(registered, nullptr))
+                    {
+                        released += 1;
+                    }
+                }
+            }
+        }
+
+        release(released);
+    }
+
+    void Future::release(uint32 count)
+    {
+        // Result is done only when no future references it
+        // (done futures of any-group signal it in short time)
+
+        if (mRemaining.fetch_sub(count, std::memory_order_acq_rel) == count)
+        {
+            complete(mAny ? (int32) mWinner.load(std::memory_order_relaxed) : mResult);
+        }
+    }
+
+} // namespace Berserk
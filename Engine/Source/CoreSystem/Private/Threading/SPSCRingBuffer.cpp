@@ -0,0 +1,115 @@
+//
+// Created by Egor Orachyov on 06.03.2019.
+//
+
+#include "Threading/SPSCRingBuffer.h"
+#include "Memory/Allocator.h"
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+
+namespace Berserk
+{
+
+    SPSCRingBuffer::SPSCRingBuffer(uint32 capacity, IAllocator *allocator)
+            : mTail(0),
+              mWritePosition(0),
+              mCachedHead(0),
+              mHead(0)
+    {
+        FAIL(capacity >= MIN_CAPACITY, "Capacity must be more than %u", MIN_CAPACITY);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mCapacity = MIN_CAPACITY;
+        while (mCapacity < capacity) mCapacity *= 2;
+
+        mMask = mCapacity - 1;
+        mBuffer = (uint8*) mAllocator->allocate(mCapacity, CACHE_LINE_SIZE);
+    }
+
+    SPSCRingBuffer::~SPSCRingBuffer()
+    {
+        if (mAllocator)
+        {
+            mAllocator->free(mBuffer);
+            mAllocator = nullptr;
+        }
+    }
+
+    void* SPSCRingBuffer::beginWrite(uint32 size, uint32 tag)
+    {
+        FAIL(size <= getMaxRecordSize(), "SPSCRingBuffer: record size %u is more than %u", size, getMaxRecordSize());
+
+        uint64 tail = mTail.load(std::memory_order_relaxed);
+        uint32 record = getRecordSize(size);
+        uint32 offset = (uint32) (tail & mMask);
+        uint32 padding = (offset + record > mCapacity ? mCapacity - offset : 0);
+        uint64 end = tail + padding + record;
+
+        // Released position is reloaded only when cached one is not enough
+
+        if (end - mCachedHead > mCapacity)
+        {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+            if (end - mCachedHead > mCapacity) return nullptr;
+        }
+
+        if (padding > 0)
+        {
+            auto header = getHeader(tail);
+            header->size = padding - (uint32) sizeof(Header);
+            header->tag = PADDING_TAG;
+            tail += padding;
+        }
+
+        auto header = getHeader(tail);
+        header->size = size;
+        header->tag = tag;
+
+        mWritePosition = end;
+        return (uint8*) header + sizeof(Header);
+    }
+
+    void SPSCRingBuffer::endWrite()
+    {
+        mTail.store(mWritePosition, std::memory_order_release);
+    }
+
+    bool SPSCRingBuffer::write(const void *data, uint32 size, uint32 tag)
+    {
+        auto payload = beginWrite(size, tag);
+        if (payload == nullptr) return false;
+
+        memcpy(payload, data, size);
+        endWrite();
+
+        return true;
+    }
+
+    const void* SPSCRingBuffer::read(uint64 &position, uint32 &size, uint32 &tag) const
+    {
+        uint64 tail = mTail.load(std::memory_order_acquire);
+
+        while (position < tail)
+        {
+            auto header = getHeader(position);
+            position += getRecordSize(header->size);
+
+            if (header->tag != PADDING_TAG)
+            {
+                size = header->size;
+                tag = header->tag;
+                return (uint8*) header + sizeof(Header);
+            }
+        }
+
+        return nullptr;
+    }
+
+    void SPSCRingBuffer::release(uint64 position)
+    {
+        mHead.store(position, std::memory_order_release);
+    }
+
+} // namespace Berserk
@@ -9,15 +9,10 @@ namespace Berserk
 {
 
     ThreadPool::ThreadPool(uint32 size)
-            : mQueue(size),
+            : mJobSystem(0, size),
               mShutdown(false)
     {
-        for (uint32 i = 0; i < THREADS_COUNT; i++)
-        {
-            mWorker.mQueue = &mQueue;
-            mWorker.mShutdown = &mShutdown;
-            mThreads[i].run(&mWorker);
-        }
+        mFrame = mJobSystem.create([](JobSystem&, Job&) {});
     }
 
     ThreadPool::~ThreadPool()
@@ -34,42 +29,53 @@ namespace Berserk
     {
         if (future)
         {
-            future->mDone = false;
-            future->mResult = 0;
-            future->mRunnable = runnable;
+            future->reset(runnable, this);
+            schedule(future);
+            return;
         }
 
-        mQueue.push(TaskInfo(runnable, future));
+        TaskInfo info = { runnable, nullptr };
+        mJobSystem.run(mJobSystem.createChild(mFrame, runTask, info));
     }
 
     void ThreadPool::join()
     {
-        while (true)
-        {
-            auto size = mQueue.getSize();
-            if (size == 0) break;
-            else Thread::yield();
-        }
+        // Frame job is finished when all its tasks are finished:
+        // waiting thread executes tasks or parks
+
+        mJobSystem.run(mFrame);
+        mJobSystem.wait(mFrame);
+
+        mFrame = mJobSystem.create([](JobSystem&, Job&) {});
     }
 
     void ThreadPool::shutdown()
     {
         mShutdown = true;
-
-        for(uint32 i = 0; i < THREADS_COUNT; i++)
-        {
-            mThreads[i].join();
-        }
+        mJobSystem.shutdown();
     }
 
     void ThreadPool::terminate()
     {
-        for(uint32 i = 0; i < THREADS_COUNT; i++)
-        {
-            mThreads[i].daemon(true);
-        }
+        mShutdown = true;
+        mJobSystem.terminate();
     }
 
+    void ThreadPool::schedule(Future *future)
+    {
+        TaskInfo info = { future->mRunnable, future };
+        mJobSystem.run(mJobSystem.createChild(mFrame, runTask, info));
+    }
 
+    void ThreadPool::runTask(JobSystem &, Job &job)
+    {
+        auto& info = job.getData<TaskInfo>();
+        auto result = info.runnable->run();
+
+        if (info.future)
+        {
+            info.future->complete(result);
+        }
+    }
 
 } // namespace Berserk
\ No newline at end of file
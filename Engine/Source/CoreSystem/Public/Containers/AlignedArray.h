@@ -0,0 +1,140 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_ALIGNEDARRAY_H
+#define BERSERK_ALIGNEDARRAY_H
+
+#include <new>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/Alignment.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+
+namespace Berserk
+{
+
+    /** Size of cache line on the target platforms (x86-64, arm64) */
+    static const uint32 CACHE_LINE_SIZE = 64;
+
+    /**
+     * Fixed-size array of elements of type T, which buffer is aligned
+     * on alignment boundary (via aligned allocate of the allocator).
+     * Count of elements is rounded up to fill the last alignment block,
+     * therefore SIMD loops could process the tail without scalar epilogue.
+     *
+     * @tparam T         Type of stored elements
+     * @tparam alignment Power of 2 alignment of buffer
+     */
+    template <typename T, uint32 alignment = MEMORY_ALIGNMENT>
+    class AlignedArray
+    {
+    public:
+
+        /**
+         * Allocates and default constructs elements
+         * @param count     Number of elements to be accessed
+         * @param allocator Allocator for the buffer (must support this alignment)
+         */
+        explicit AlignedArray(uint32 count, IAllocator* allocator = nullptr);
+
+        ~AlignedArray();
+
+        GEN_NEW_DELETE(AlignedArray);
+
+        /**
+         * @warning Assert on range check
+         * @param index Index of desired element
+         * @return Element at index
+         */
+        T& operator [] (uint32 index);
+
+        /** @return Pointer to aligned buffer */
+        T* get() { return mBuffer; }
+
+        /** @return Number of elements, requested on creation */
+        uint32 getCount() const { return mCount; }
+
+        /** @return Number of elements in buffer (with padded tail) */
+        uint32 getCapacity() const { return mCapacity; }
+
+    private:
+
+        T*     mBuffer;
+        uint32 mCount;
+        uint32 mCapacity;
+        IAllocator* mAllocator;
+
+    };
+
+    template <typename T, uint32 alignment>
+    AlignedArray<T,alignment>::AlignedArray(uint32 count, IAllocator *allocator)
+    {
+        static_assert(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment must be power of 2");
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        uint32 perBlock = (sizeof(T) < alignment ? alignment / (uint32)sizeof(T) : 1);
+
+        mCount = count;
+        mCapacity = ((count + perBlock - 1) / perBlock) * perBlock;
+        mBuffer = (T*) mAllocator->allocate(mCapacity * sizeof(T), alignment);
+
+        for (uint32 i = 0; i < mCapacity; i++)
+        { new (&mBuffer[i]) T(); }
+    }
+
+    template <typename T, uint32 alignment>
+    AlignedArray<T,alignment>::~AlignedArray()
+    {
+        if (mBuffer)
+        {
+            for (uint32 i = 0; i < mCapacity; i++)
+            { mBuffer[i].~T(); }
+
+            mAllocator->free(mBuffer);
+            mBuffer = nullptr;
+        }
+    }
+
+    template <typename T, uint32 alignment>
+    T& AlignedArray<T,alignment>::operator[](uint32 index)
+    {
+        FAIL(index < mCapacity, "Index out of range %u", index);
+        return mBuffer[index];
+    }
+
+    /** Buffer for SSE vectors */
+    template <typename T>
+    using AlignedArray16 = AlignedArray<T, 16>;
+
+    /** Buffer for AVX vectors */
+    template <typename T>
+    using AlignedArray32 = AlignedArray<T, 32>;
+
+    /** Buffer aligned on cache line */
+    template <typename T>
+    using AlignedArray64 = AlignedArray<T, CACHE_LINE_SIZE>;
+
+    /**
+     * Wrapper for per-thread data (counters, queues heads), which
+     * occupies the whole cache lines to avoid false sharing
+     *
+     * @warning Must be placed in memory with CACHE_LINE_SIZE alignment
+     *          (static storage or aligned allocate)
+     */
+    template <typename T>
+    struct alignas(CACHE_LINE_SIZE) CacheAligned
+    {
+        T value;
+
+        T& operator * () { return value; }
+        T* operator -> () { return &value; }
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_ALIGNEDARRAY_H
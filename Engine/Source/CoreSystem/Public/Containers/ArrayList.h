@@ -5,8 +5,11 @@
 #ifndef BERSERK_ARRAYLIST_H
 #define BERSERK_ARRAYLIST_H
 
+#include <new>
+#include <utility>
 #include "Misc/Types.h"
 #include "Misc/Assert.h"
+#include "Misc/Relocation.h"
 #include "Object/NewDelete.h"
 #include "Memory/Allocator.h"
 #include "Memory/IAllocator.h"
@@ -22,6 +25,10 @@ namespace Berserk
      * space in the internal buffer. Relies on default platform allocator.
      * Provides iteration mechanism for elements for using in for loop.
      *
+     * Elements are copy (move) constructed in the buffer, on expansion and
+     * removal they are relocated via memcpy only if type is trivially
+     * relocatable (see IsTriviallyRelocatable), otherwise moved.
+     *
      * @tparam T Type of stored elements
      */
     template <typename T>
@@ -80,6 +87,30 @@ namespace Berserk
          */
         void operator +=(const T& element);
 
+        /**
+         * Add element in the end of the list via move
+         * @warning if the expansion is locked and array is full it
+         *          will raise a fatal error an shut down the engine
+         * @param element To add
+         */
+        void operator +=(T&& element);
+
+        /**
+         * Constructs element in the end of the list from arguments
+         * @warning Fails if the expansion is locked and array is full
+         * @param args Arguments of T constructor
+         * @return Constructed element
+         */
+        template <typename ... TArgs>
+        T& emplace(TArgs&& ... args);
+
+        /**
+         * Expands buffer to store count elements without reallocations
+         * (does nothing if expansion is locked)
+         * @param count Desired capacity
+         */
+        void reserve(uint32 count);
+
         /**
          * @warning Assert on range check
          * @param index Index of desired element
@@ -116,7 +147,11 @@ namespace Berserk
 
     private:
 
-        void expand();
+        /** @return Capacity after expansion to store required elements */
+        uint32 getExpandedCapacity(uint32 required) const;
+
+        /** Moves elements in new buffer of capacity size */
+        void reallocate(uint32 capacity);
 
     private:
 
@@ -172,7 +207,7 @@ namespace Berserk
         mSize -= 1;
         mBuffer[index].~T();
         if (index == mSize) return;
-        else memcpy(&mBuffer[index], &mBuffer[mSize], sizeof(T));
+        else relocate(&mBuffer[index], &mBuffer[mSize], 1);
     }
 
     template <typename T>
@@ -193,18 +228,70 @@ namespace Berserk
     template <typename T>
     void ArrayList<T>::operator+=(const T& element)
     {
-        if (mSize >= mCapacity)
+        if (mSize >= mCapacity && mLockExpansion)
+        {
+            WARNING("Array List: Expansion of the internal buffer is locked %p", mBuffer);
+            return;
+        }
+
+        emplace(element);
+    }
+
+    template <typename T>
+    void ArrayList<T>::operator+=(T&& element)
+    {
+        if (mSize >= mCapacity && mLockExpansion)
+        {
+            WARNING("Array List: Expansion of the internal buffer is locked %p", mBuffer);
+            return;
+        }
+
+        emplace(std::move(element));
+    }
+
+    template <typename T>
+    template <typename ... TArgs>
+    T& ArrayList<T>::emplace(TArgs&& ... args)
+    {
+        if (mSize < mCapacity)
         {
-            if (mLockExpansion)
-            {
-                WARNING("Array List: Expansion of the internal buffer is locked %p", mBuffer);
-                return;
-            }
+            auto element = new (&mBuffer[mSize]) T(std::forward<TArgs>(args)...);
+            mSize += 1;
+            return *element;
+        }
+
+        FAIL(!mLockExpansion, "Array List: Expansion of the internal buffer is locked %p", mBuffer);
+
+        // New element is constructed before relocation: arguments
+        // could reference elements of this list
+
+        auto old = mBuffer;
+        auto capacity = getExpandedCapacity(mSize + 1);
+        auto buffer = (T*) mAllocator->allocate(capacity * sizeof(T));
+        auto element = new (&buffer[mSize]) T(std::forward<TArgs>(args)...);
+
+        relocate(buffer, old, mSize);
+        mAllocator->free(old);
+
+        mBuffer = buffer;
+        mCapacity = capacity;
+        mSize += 1;
+
+        return *element;
+    }
 
-            expand();
+    template <typename T>
+    void ArrayList<T>::reserve(uint32 count)
+    {
+        if (count <= mCapacity) return;
+
+        if (mLockExpansion)
+        {
+            WARNING("Array List: Expansion of the internal buffer is locked %p", mBuffer);
+            return;
         }
 
-        memcpy(&mBuffer[mSize++], &element, sizeof(T));
+        reallocate(count);
     }
 
     template <typename T>
@@ -264,20 +351,23 @@ namespace Berserk
     }
 
     template <typename T>
-    void ArrayList<T>::expand()
+    uint32 ArrayList<T>::getExpandedCapacity(uint32 required) const
     {
-        // Save old pointer and its size to
-        // copy data into new allocated buffer of bigger size
+        auto capacity = (uint32)(mExpansionFactor * (float32)mCapacity);
+        return (capacity > required ? capacity : required);
+    }
 
-        auto old = mBuffer;
-        auto size = mCapacity * sizeof(T);
+    template <typename T>
+    void ArrayList<T>::reallocate(uint32 capacity)
+    {
+        // Imitation of realloc method for IAllocator
 
-        mCapacity = (uint32)(mExpansionFactor * (float32)mCapacity);
+        auto old = mBuffer;
 
-        // Imitation of realloc method for IAllocator
+        mBuffer = (T*) mAllocator->allocate(capacity * sizeof(T));
+        mCapacity = capacity;
 
-        mBuffer = (T*) mAllocator->allocate(mCapacity * sizeof(T));
-        memcpy(mBuffer, old, size);
+        relocate(mBuffer, old, mSize);
         mAllocator->free(old);
     }
 
@@ -5,6 +5,7 @@
 #ifndef BERSERK_HASHMAP_H
 #define BERSERK_HASHMAP_H
 
+#include "Misc/Hash.h"
 #include "Misc/Crc32.h"
 #include "Misc/Types.h"
 #include "Misc/Assert.h"
@@ -81,13 +82,10 @@ namespace Berserk
         /** Default range for hashing efficiency */
         static const uint32 DEFAULT_HASH_RANGE = 64;
 
-        /** Default hashing method via casting key to the array of chars */
+        /** Default hashing method of the key type (see HashTraits) */
         static uint32 defaultHashing(const void* key)
         {
-            auto ptr = (char*)(&key);
-            auto hash = Crc32::hash(ptr, sizeof(K));
-
-            return hash;
+            return HashTraits<K>::hashing(key);
         }
 
     public:
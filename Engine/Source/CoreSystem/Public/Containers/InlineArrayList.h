@@ -0,0 +1,233 @@
+//
+// Created by Egor Orachyov on 02.03.2019.
+//
+
+#ifndef BERSERK_INLINEARRAYLIST_H
+#define BERSERK_INLINEARRAYLIST_H
+
+#include <new>
+#include <utility>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/Relocation.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+#include "Logging/LogMacros.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * Array list with small buffer for N elements inside the object itself.
+     * Up to N elements does not allocate memory (elements are in the same
+     * cache lines as the owner), after that expands twice in the allocator
+     * memory as usual array list. Has the same interface as ArrayList.
+     *
+     * @note Could not be copied (elements could be stored inline)
+     *
+     * @tparam T Type of stored elements
+     * @tparam N Number of inline stored elements
+     */
+    template <typename T, uint32 N>
+    class InlineArrayList
+    {
+    public:
+
+        static_assert(N > 0, "Inline capacity must be more than 0");
+
+        /** Number of elements, stored without allocation */
+        static const uint32 INLINE_CAPACITY = N;
+
+        /** @param allocator Allocator for buffer after expansion [or nullptr for default] */
+        explicit InlineArrayList(IAllocator* allocator = nullptr);
+
+        InlineArrayList(const InlineArrayList& other) = delete;
+
+        InlineArrayList& operator = (const InlineArrayList& other) = delete;
+
+        ~InlineArrayList();
+
+        GEN_NEW_DELETE(InlineArrayList);
+
+        /**
+         * Removes element from the list with calling default destructor (breaks the order)
+         * @warning Assert on range check
+         * @param index Element index to be deleted
+         */
+        void remove(uint32 index);
+
+        /** Removes all the elements from list with calling default destructor */
+        void empty();
+
+        /** Removes all the elements from list WITHOUT calling default destructor */
+        void reset() { mSize = 0; }
+
+        /** Add element in the end of the list */
+        void operator +=(const T& element) { emplace(element); }
+
+        /** Add element in the end of the list via move */
+        void operator +=(T&& element) { emplace(std::move(element)); }
+
+        /**
+         * Constructs element in the end of the list from arguments
+         * @param args Arguments of T constructor
+         * @return Constructed element
+         */
+        template <typename ... TArgs>
+        T& emplace(TArgs&& ... args);
+
+        /**
+         * Expands buffer to store count elements without reallocations
+         * @param count Desired capacity
+         */
+        void reserve(uint32 count);
+
+        /**
+         * @warning Assert on range check
+         * @param index Index of desired element
+         * @return Element at index
+         */
+        T& operator [] (uint32 index)
+        {
+            FAIL(index < mSize, "Index out of range %u", index);
+            return mBuffer[index];
+        }
+
+        /** @return First element of array and reset iterator */
+        T* iterate()
+        {
+            mCurrent = 0;
+            return (mCurrent < mSize ? &mBuffer[mCurrent] : nullptr);
+        }
+
+        /** @return Next element in the iteration */
+        T* next()
+        {
+            mCurrent += 1;
+            return (mCurrent < mSize ? &mBuffer[mCurrent] : nullptr);
+        }
+
+        /** @return Pointer to internal buffer */
+        T* get() { return mBuffer; }
+
+        /** @return Current number of elements */
+        uint32 getSize() const { return mSize; }
+
+        /** @return Max number of elements without expansion */
+        uint32 getCapacity() const { return mCapacity; }
+
+        /** @return True if elements are stored inside the object */
+        bool isInline() const { return mBuffer == getInline(); }
+
+        /** @return Memory cost of this resource (heap buffer only) */
+        uint32 getMemoryUsage() const { return (isInline() ? 0 : mCapacity * (uint32) sizeof(T)); }
+
+    private:
+
+        T* getInline() { return (T*) mInline; }
+
+        const T* getInline() const { return (const T*) mInline; }
+
+    private:
+
+        T*      mBuffer;
+        uint32  mSize = 0;
+        uint32  mCapacity = N;
+        uint32  mCurrent = 0;
+        IAllocator* mAllocator;
+
+        alignas(T) uint8 mInline[N * sizeof(T)];
+
+    };
+
+    template <typename T, uint32 N>
+    InlineArrayList<T,N>::InlineArrayList(IAllocator *allocator)
+    {
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mBuffer = getInline();
+    }
+
+    template <typename T, uint32 N>
+    InlineArrayList<T,N>::~InlineArrayList()
+    {
+        empty();
+
+        if (!isInline())
+        {
+#if PROFILE_ARRAY_LIST
+            PUSH("Inline Array List: delete capacity: %u | buffer: %p", mCapacity, mBuffer);
+#endif
+
+            mAllocator->free(mBuffer);
+            mBuffer = getInline();
+        }
+    }
+
+    template <typename T, uint32 N>
+    void InlineArrayList<T,N>::remove(uint32 index)
+    {
+        FAIL(index < mSize, "Index out of range %u", index);
+
+        mSize -= 1;
+        mBuffer[index].~T();
+        if (index != mSize) relocate(&mBuffer[index], &mBuffer[mSize], 1);
+    }
+
+    template <typename T, uint32 N>
+    void InlineArrayList<T,N>::empty()
+    {
+        for (uint32 i = 0; i < mSize; i++)
+        { mBuffer[i].~T(); }
+
+        mSize = 0;
+    }
+
+    template <typename T, uint32 N>
+    template <typename ... TArgs>
+    T& InlineArrayList<T,N>::emplace(TArgs&& ... args)
+    {
+        if (mSize < mCapacity)
+        {
+            auto element = new (&mBuffer[mSize]) T(std::forward<TArgs>(args)...);
+            mSize += 1;
+            return *element;
+        }
+
+        // New element is constructed before relocation: arguments
+        // could reference elements of this list
+
+        auto capacity = mCapacity * 2;
+        auto buffer = (T*) mAllocator->allocate(capacity * sizeof(T));
+        auto element = new (&buffer[mSize]) T(std::forward<TArgs>(args)...);
+
+        relocate(buffer, mBuffer, mSize);
+        if (!isInline()) mAllocator->free(mBuffer);
+
+        mBuffer = buffer;
+        mCapacity = capacity;
+        mSize += 1;
+
+        return *element;
+    }
+
+    template <typename T, uint32 N>
+    void InlineArrayList<T,N>::reserve(uint32 count)
+    {
+        if (count <= mCapacity) return;
+
+        auto buffer = (T*) mAllocator->allocate(count * sizeof(T));
+
+        relocate(buffer, mBuffer, mSize);
+        if (!isInline()) mAllocator->free(mBuffer);
+
+        mBuffer = buffer;
+        mCapacity = count;
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_INLINEARRAYLIST_H
@@ -0,0 +1,435 @@
+//
+// Created by Egor Orachyov on 28.02.2019.
+//
+
+#ifndef BERSERK_OPENHASHMAP_H
+#define BERSERK_OPENHASHMAP_H
+
+#include <new>
+#include "Misc/Hash.h"
+#include "Misc/Crc32.h"
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+#include "Containers/HashMap.h"
+#include "Logging/LogMacros.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * Open addressing hash map with Robin Hood linear probing. Key-value
+     * nodes are stored in one contiguous array (no per-node allocations and
+     * pointer chasing), parallel array of slots keeps full hash of the key and
+     * probe distance of the node from its home slot.
+     *
+     * Insertion moves richer nodes (with smaller probe distance) forward, so
+     * probe sequences are short and lookup stops as soon as met node is closer
+     * to its home than the searched key would be. Removal shifts the following
+     * nodes back by one slot: no tombstones, therefore long runs of add/remove
+     * do not degrade lookup and do not require rehashing.
+     *
+     * Capacity is power of 2, map grows twice when size exceeds max load factor.
+     *
+     * @note Has the same interface as HashMap (could replace it without pool)
+     * @warning Pointers to values and iteration are invalidated by add and remove
+     *
+     * @tparam K Type of key (must be comparable via ==)
+     * @tparam V Type of value
+     */
+    template <typename K, typename V>
+    class OpenHashMap
+    {
+    private:
+
+        typedef HashNode<K,V> Node;
+
+        /** Meta info of one slot */
+        struct Slot
+        {
+            uint32 hash;        // Hash of the key in slot
+            uint32 distance;    // Probe distance from home slot + 1 [or 0 if slot is empty]
+        };
+
+    public:
+
+        /** Min number of slots */
+        static const uint32 MIN_CAPACITY = 16;
+
+        /** Default number of slots */
+        static const uint32 DEFAULT_CAPACITY = 64;
+
+        /** Max load factor (size / capacity) as fraction MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR */
+        static const uint32 MAX_LOAD_NUMERATOR = 7;
+        static const uint32 MAX_LOAD_DENOMINATOR = 8;
+
+        /** Default hashing method of the key type (see HashTraits) */
+        static uint32 defaultHashing(const void* key)
+        {
+            return HashTraits<K>::hashing(key);
+        }
+
+    public:
+
+        /**
+         * Allocates slots and prepares map
+         * @param hashing   Pointer to custom hashing method or nullptr if chosen default
+         * @param capacity  Initial number of slots (rounded up to power of 2)
+         * @param allocator Allocator for nodes and slots [or nullptr for default]
+         */
+        explicit OpenHashMap(Crc32::Hashing hashing = nullptr, uint32 capacity = DEFAULT_CAPACITY, IAllocator* allocator = nullptr);
+
+        ~OpenHashMap();
+
+        GEN_NEW_DELETE(OpenHashMap)
+
+        /**
+         * Removes from map element with key if it exists
+         * @param key
+         */
+        void remove(const K& key);
+
+        /** Deletes all the elements from the map (keeps capacity) */
+        void empty();
+
+        /**
+         * Add element in the map and replace old value whether it exists
+         * @param key   Key of element
+         * @param value New (First) value
+         */
+        void add(const K& key, const V& value);
+
+        /**
+         * Grows map to store count elements without rehashing
+         * @param count Expected number of elements
+         */
+        void reserve(uint32 count);
+
+        /**
+         * @param  key Key of the element
+         * @return Pointer to the element whether it exists or nullptr
+         */
+        V*   operator [] (const K& key);
+
+        /** @return True if element with key exists */
+        bool contains(const K& key) const { return find(key, mHashing((const void*)&key)) != NOT_FOUND; }
+
+        /** @return Start iterating through map an get first element */
+        HashNode<K,V>* iterate();
+
+        /** @return Next element in iteration or nullptr */
+        HashNode<K,V>* next();
+
+        /** @return Key of the current iterable element or nullptr */
+        K* key();
+
+        /** @return Value of the current iterable element or nullptr */
+        V* value();
+
+        /** @return Number of element in the map */
+        uint32 getSize() const { return mSize; }
+
+        /** @return Number of slots */
+        uint32 getRange() const { return mCapacity; }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const { return sizeof(OpenHashMap) + mCapacity * (sizeof(Node) + sizeof(Slot)); }
+
+        /** @return Load factor = mSize / mCapacity */
+        float32 getLoadFactor() const { return (float32)mSize / (float32)mCapacity; }
+
+        /** @return Max probe distance of stored element (for profiling) */
+        uint32 getMaxProbeLength() const;
+
+    private:
+
+        static const uint32 NOT_FOUND = 0xffffffff;
+
+        /** @return Home slot of hash (fibonacci hashing spreads weak hashes) */
+        uint32 home(uint32 hash) const { return (uint32)(hash * 2654435769u) >> mShift; }
+
+        /** @return Slot index of the key or NOT_FOUND */
+        uint32 find(const K& key, uint32 hash) const;
+
+        /** Places node without search of existing key (moves node's content) */
+        void insert(Node* node, uint32 hash);
+
+        /** Allocates new arrays and moves all the nodes in them */
+        void rehash(uint32 capacity);
+
+    private:
+
+        uint32 mSize = 0;
+        uint32 mCapacity = 0;
+        uint32 mShift = 0;                  // 32 - log2(capacity)
+        uint32 mIterator = 0;               // Index of current iterable slot
+        Crc32::Hashing mHashing = nullptr;
+        Node* mNodes = nullptr;
+        Slot* mSlots = nullptr;
+        IAllocator* mAllocator = nullptr;
+
+    };
+
+    template <typename K, typename V>
+    OpenHashMap<K,V>::OpenHashMap(Crc32::Hashing hashing, uint32 capacity, IAllocator *allocator)
+    {
+        if (hashing) mHashing = hashing;
+        else mHashing = defaultHashing;
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        uint32 slots = MIN_CAPACITY;
+        while (slots < capacity) slots *= 2;
+
+        rehash(slots);
+    }
+
+    template <typename K, typename V>
+    OpenHashMap<K,V>::~OpenHashMap()
+    {
+        if (mSlots)
+        {
+#if PROFILE_HASH_MAP
+            PUSH("Open hash map: delete with capacity: %u | size: %u", mCapacity, mSize);
+#endif
+
+            empty();
+            mAllocator->free(mNodes);
+            mAllocator->free(mSlots);
+            mNodes = nullptr;
+            mSlots = nullptr;
+        }
+    }
+
+    template <typename K, typename V>
+    void OpenHashMap<K,V>::remove(const K &key)
+    {
+        uint32 index = find(key, mHashing((const void*)&key));
+        if (index == NOT_FOUND) return;
+
+        mNodes[index].~Node();
+        mSize -= 1;
+
+        // Backward shift: following nodes of the cluster move one slot
+        // closer to their home, until empty slot or node at home is met
+
+        uint32 mask = mCapacity - 1;
+        uint32 next = (index + 1) & mask;
+
+        while (mSlots[next].distance > 1)
+        {
+            memcpy((void*)&mNodes[index], &mNodes[next], sizeof(Node));
+            mSlots[index].hash = mSlots[next].hash;
+            mSlots[index].distance = mSlots[next].distance - 1;
+
+            index = next;
+            next = (next + 1) & mask;
+        }
+
+        mSlots[index].distance = 0;
+    }
+
+    template <typename K, typename V>
+    void OpenHashMap<K,V>::empty()
+    {
+        for (uint32 i = 0; i < mCapacity; i++)
+        {
+            if (mSlots[i].distance != 0)
+            {
+                mNodes[i].~Node();
+                mSlots[i].distance = 0;
+            }
+        }
+
+        mSize = 0;
+    }
+
+    template <typename K, typename V>
+    void OpenHashMap<K,V>::add(const K &key, const V &value)
+    {
+        uint32 hash = mHashing((const void*)&key);
+        uint32 index = find(key, hash);
+
+        if (index != NOT_FOUND)
+        {
+            mNodes[index].update(value);
+            return;
+        }
+
+        if ((mSize + 1) * MAX_LOAD_DENOMINATOR > mCapacity * MAX_LOAD_NUMERATOR)
+        {
+            rehash(mCapacity * 2);
+        }
+
+        alignas(Node) uint8 buffer[sizeof(Node)];
+        new (buffer) Node(key, value);
+
+        insert((Node*) buffer, hash);
+        mSize += 1;
+    }
+
+    template <typename K, typename V>
+    void OpenHashMap<K,V>::reserve(uint32 count)
+    {
+        uint32 slots = mCapacity;
+        while (count * MAX_LOAD_DENOMINATOR > slots * MAX_LOAD_NUMERATOR) slots *= 2;
+
+        if (slots != mCapacity) rehash(slots);
+    }
+
+    template <typename K, typename V>
+    V* OpenHashMap<K,V>::operator[](const K &key)
+    {
+        uint32 index = find(key, mHashing((const void*)&key));
+        return (index != NOT_FOUND ? &mNodes[index].value() : nullptr);
+    }
+
+    template <typename K, typename V>
+    HashNode<K,V>* OpenHashMap<K,V>::iterate()
+    {
+        mIterator = 0;
+
+        while (mIterator < mCapacity && mSlots[mIterator].distance == 0) mIterator += 1;
+
+        return (mIterator < mCapacity ? &mNodes[mIterator] : nullptr);
+    }
+
+    template <typename K, typename V>
+    HashNode<K,V>* OpenHashMap<K,V>::next()
+    {
+        if (mIterator >= mCapacity) return nullptr;
+
+        mIterator += 1;
+        while (mIterator < mCapacity && mSlots[mIterator].distance == 0) mIterator += 1;
+
+        return (mIterator < mCapacity ? &mNodes[mIterator] : nullptr);
+    }
+
+    template <typename K, typename V>
+    K* OpenHashMap<K,V>::key()
+    {
+        return (mIterator < mCapacity ? &mNodes[mIterator].key() : nullptr);
+    }
+
+    template <typename K, typename V>
+    V* OpenHashMap<K,V>::value()
+    {
+        return (mIterator < mCapacity ? &mNodes[mIterator].value() : nullptr);
+    }
+
+    template <typename K, typename V>
+    uint32 OpenHashMap<K,V>::getMaxProbeLength() const
+    {
+        uint32 length = 0;
+
+        for (uint32 i = 0; i < mCapacity; i++)
+        {
+            if (mSlots[i].distance > length) length = mSlots[i].distance;
+        }
+
+        return (length > 0 ? length - 1 : 0);
+    }
+
+    template <typename K, typename V>
+    uint32 OpenHashMap<K,V>::find(const K &key, uint32 hash) const
+    {
+        uint32 mask = mCapacity - 1;
+        uint32 index = home(hash);
+        uint32 distance = 1;
+
+        // Node closer to its home than the key would be (or empty slot)
+        // means that the key is not in the map (it would have displaced that node)
+
+        while (mSlots[index].distance >= distance)
+        {
+            if (mSlots[index].hash == hash && mNodes[index].key() == key) return index;
+
+            index = (index + 1) & mask;
+            distance += 1;
+        }
+
+        return NOT_FOUND;
+    }
+
+    template <typename K, typename V>
+    void OpenHashMap<K,V>::insert(Node *node, uint32 hash)
+    {
+        uint32 mask = mCapacity - 1;
+        uint32 index = home(hash);
+        uint32 distance = 1;
+
+        alignas(Node) uint8 buffer[sizeof(Node)];
+
+        while (true)
+        {
+            Slot& slot = mSlots[index];
+
+            if (slot.distance == 0)
+            {
+                memcpy((void*)&mNodes[index], node, sizeof(Node));
+                slot.hash = hash;
+                slot.distance = distance;
+                return;
+            }
+
+            if (slot.distance < distance)
+            {
+                // Take the slot from richer node and continue to place it
+
+                memcpy(buffer, &mNodes[index], sizeof(Node));
+                memcpy((void*)&mNodes[index], node, sizeof(Node));
+                memcpy((void*)node, buffer, sizeof(Node));
+
+                uint32 tmpHash = slot.hash;
+                uint32 tmpDistance = slot.distance;
+
+                slot.hash = hash;
+                slot.distance = distance;
+
+                hash = tmpHash;
+                distance = tmpDistance;
+            }
+
+            index = (index + 1) & mask;
+            distance += 1;
+        }
+    }
+
+    template <typename K, typename V>
+    void OpenHashMap<K,V>::rehash(uint32 capacity)
+    {
+#if PROFILE_HASH_MAP
+        PUSH("Open hash map: rehash from capacity: %u to: %u | size: %u", mCapacity, capacity, mSize);
+#endif
+
+        Node* nodes = mNodes;
+        Slot* slots = mSlots;
+        uint32 oldCapacity = mCapacity;
+
+        mCapacity = capacity;
+        mShift = 32 - (31 - (uint32) __builtin_clz(capacity));
+        mNodes = (Node*) mAllocator->allocate(capacity * sizeof(Node));
+        mSlots = (Slot*) mAllocator->allocate(capacity * sizeof(Slot));
+        memset(mSlots, 0, capacity * sizeof(Slot));
+
+        if (slots == nullptr) return;
+
+        // Nodes are relocated as raw bytes (as in other engine containers)
+
+        for (uint32 i = 0; i < oldCapacity; i++)
+        {
+            if (slots[i].distance != 0) insert(&nodes[i], slots[i].hash);
+        }
+
+        mAllocator->free(nodes);
+        mAllocator->free(slots);
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_OPENHASHMAP_H
@@ -0,0 +1,326 @@
+//
+// Created by Egor Orachyov on 04.03.2019.
+//
+
+#ifndef BERSERK_SLOTMAP_H
+#define BERSERK_SLOTMAP_H
+
+#include <new>
+#include <utility>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+#include "Misc/Relocation.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+
+namespace Berserk
+{
+
+    /**
+     * Stable reference to element of the SlotMap: index of the slot and
+     * generation of the slot at the moment of insertion. After removal
+     * generation of the slot changes, so old handles become invalid
+     * (even if the slot is reused). Default handle is always invalid.
+     */
+    struct SlotHandle
+    {
+        uint32 index = 0;
+        uint32 generation = 0;
+
+        /** @return True if handle was returned by slot map (could be already removed) */
+        bool isValid() const { return generation != 0; }
+
+        bool operator == (const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+
+        bool operator != (const SlotHandle& other) const { return !(*this == other); }
+    };
+
+    /**
+     * Generational slot map: elements are stored in packed (dense) array and
+     * referenced by handles via sparse array of slots. Add and remove are O(1),
+     * iteration is contiguous (removal moves the last element in place of the
+     * removed one, so the order is not preserved).
+     *
+     * @tparam T Type of stored elements
+     */
+    template <typename T>
+    class SlotMap
+    {
+    public:
+
+        /** Min number of elements */
+        static const uint32 MIN_INITIAL_SIZE = 2;
+
+        /** Default number of elements */
+        static const uint32 DEFAULT_INITIAL_SIZE = 16;
+
+    public:
+
+        /**
+         * @param initialSize Initial capacity
+         * @param allocator   Allocator for internal buffers [or nullptr for default]
+         */
+        explicit SlotMap(uint32 initialSize = DEFAULT_INITIAL_SIZE, IAllocator* allocator = nullptr);
+
+        SlotMap(const SlotMap& other) = delete;
+
+        SlotMap& operator = (const SlotMap& other) = delete;
+
+        ~SlotMap();
+
+        GEN_NEW_DELETE(SlotMap);
+
+        /** Add element in the map @return Handle of the element */
+        SlotHandle add(const T& element) { return emplace(element); }
+
+        /** Add element in the map via move @return Handle of the element */
+        SlotHandle add(T&& element) { return emplace(std::move(element)); }
+
+        /**
+         * Constructs element in the map from arguments
+         * @param args Arguments of T constructor
+         * @return Handle of the element
+         */
+        template <typename ... TArgs>
+        SlotHandle emplace(TArgs&& ... args);
+
+        /**
+         * Removes element (the last element is moved in its place)
+         * @param handle Handle of the element
+         * @return True if element was found and removed
+         */
+        bool remove(SlotHandle handle);
+
+        /** Removes all the elements (all the handles become invalid) */
+        void empty();
+
+        /**
+         * Expands buffers to store count elements without reallocations
+         * @param count Desired capacity
+         */
+        void reserve(uint32 count);
+
+        /** @return True if element with handle is stored in the map */
+        bool contains(SlotHandle handle) const
+        {
+            return handle.index < mCapacity && handle.generation != 0 && mSlots[handle.index].generation == handle.generation;
+        }
+
+        /** @return Pointer to element [or nullptr if handle is invalid] */
+        T* get(SlotHandle handle)
+        {
+            return (contains(handle) ? &mData[mSlots[handle.index].index] : nullptr);
+        }
+
+        /**
+         * @warning Assert on invalid handle
+         * @return Element with handle
+         */
+        T& operator [] (SlotHandle handle)
+        {
+            FAIL(contains(handle), "SlotMap: invalid handle [index: %u][generation: %u]", handle.index, handle.generation);
+            return mData[mSlots[handle.index].index];
+        }
+
+        /** @return Handle of element with packed index */
+        SlotHandle getHandle(uint32 index) const
+        {
+            FAIL(index < mSize, "Index out of range %u", index);
+            SlotHandle handle;
+            handle.index = mDenseToSlot[index];
+            handle.generation = mSlots[handle.index].generation;
+            return handle;
+        }
+
+        /** @return First element of array and reset iterator */
+        T* iterate()
+        {
+            mCurrent = 0;
+            return (mCurrent < mSize ? &mData[mCurrent] : nullptr);
+        }
+
+        /** @return Next element in the iteration */
+        T* next()
+        {
+            mCurrent += 1;
+            return (mCurrent < mSize ? &mData[mCurrent] : nullptr);
+        }
+
+        /** @return Pointer to packed elements */
+        T* getData() { return mData; }
+
+        /** @return Current number of elements */
+        uint32 getSize() const { return mSize; }
+
+        /** @return Max number of elements without expansion */
+        uint32 getCapacity() const { return mCapacity; }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const { return mCapacity * (uint32)(sizeof(T) + sizeof(uint32) + sizeof(Slot)); }
+
+    private:
+
+        /** Busy slot: index of element and its generation, free slot: next free slot */
+        struct Slot
+        {
+            uint32 index;
+            uint32 generation;
+        };
+
+        /** Increments slot generation (skips 0, reserved for invalid handles) */
+        static uint32 nextGeneration(uint32 generation) { return (generation + 1 == 0 ? 1 : generation + 1); }
+
+        static const uint32 INVALID_SLOT = 0xffffffff;
+
+    private:
+
+        T*      mData = nullptr;
+        uint32* mDenseToSlot = nullptr;
+        Slot*   mSlots = nullptr;
+        uint32  mSize = 0;
+        uint32  mCapacity = 0;
+        uint32  mCurrent = 0;
+        uint32  mFreeSlot = INVALID_SLOT;
+        IAllocator* mAllocator = nullptr;
+
+    };
+
+    template <typename T>
+    SlotMap<T>::SlotMap(uint32 initialSize, IAllocator *allocator)
+    {
+        FAIL(initialSize >= MIN_INITIAL_SIZE, "Initial size must be more than %u", MIN_INITIAL_SIZE);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        reserve(initialSize);
+    }
+
+    template <typename T>
+    SlotMap<T>::~SlotMap()
+    {
+        if (mAllocator)
+        {
+            for (uint32 i = 0; i < mSize; i++)
+            { mData[i].~T(); }
+
+            mAllocator->free(mData);
+            mAllocator->free(mDenseToSlot);
+            mAllocator->free(mSlots);
+
+            mAllocator = nullptr;
+        }
+    }
+
+    template <typename T>
+    template <typename ... TArgs>
+    SlotHandle SlotMap<T>::emplace(TArgs&& ... args)
+    {
+        if (mSize == mCapacity)
+        {
+            // Element is created before reallocation: arguments could reference elements of this map
+
+            T element(std::forward<TArgs>(args)...);
+            reserve(mCapacity * 2);
+            return emplace(std::move(element));
+        }
+
+        uint32 slot = mFreeSlot;
+        mFreeSlot = mSlots[slot].index;
+
+        new (&mData[mSize]) T(std::forward<TArgs>(args)...);
+        mDenseToSlot[mSize] = slot;
+        mSlots[slot].index = mSize;
+        mSize += 1;
+
+        SlotHandle handle;
+        handle.index = slot;
+        handle.generation = mSlots[slot].generation;
+        return handle;
+    }
+
+    template <typename T>
+    bool SlotMap<T>::remove(SlotHandle handle)
+    {
+        if (!contains(handle)) return false;
+
+        auto& slot = mSlots[handle.index];
+        uint32 index = slot.index;
+        uint32 last = mSize - 1;
+
+        mData[index].~T();
+
+        if (index != last)
+        {
+            relocate(&mData[index], &mData[last], 1);
+            mDenseToSlot[index] = mDenseToSlot[last];
+            mSlots[mDenseToSlot[index]].index = index;
+        }
+
+        slot.generation = nextGeneration(slot.generation);
+        slot.index = mFreeSlot;
+        mFreeSlot = handle.index;
+        mSize -= 1;
+
+        return true;
+    }
+
+    template <typename T>
+    void SlotMap<T>::empty()
+    {
+        for (uint32 i = mSize; i > 0; i--)
+        {
+            uint32 slot = mDenseToSlot[i - 1];
+
+            mData[i - 1].~T();
+            mSlots[slot].generation = nextGeneration(mSlots[slot].generation);
+            mSlots[slot].index = mFreeSlot;
+            mFreeSlot = slot;
+        }
+
+        mSize = 0;
+    }
+
+    template <typename T>
+    void SlotMap<T>::reserve(uint32 count)
+    {
+        if (count <= mCapacity) return;
+
+        // Number of slots is equal to capacity: slots are
+        // only created when all the previous ones are busy
+
+        auto data = (T*) mAllocator->allocate(count * (uint32) sizeof(T));
+        auto denseToSlot = (uint32*) mAllocator->allocate(count * (uint32) sizeof(uint32));
+        auto slots = (Slot*) mAllocator->allocate(count * (uint32) sizeof(Slot));
+
+        if (mData)
+        {
+            relocate(data, mData, mSize);
+            memcpy(denseToSlot, mDenseToSlot, mSize * sizeof(uint32));
+            memcpy(slots, mSlots, mCapacity * sizeof(Slot));
+
+            mAllocator->free(mData);
+            mAllocator->free(mDenseToSlot);
+            mAllocator->free(mSlots);
+        }
+
+        // New slots are pushed in free list in reverse order (the smallest is taken first)
+
+        for (uint32 i = count; i > mCapacity; i--)
+        {
+            slots[i - 1].index = mFreeSlot;
+            slots[i - 1].generation = 1;
+            mFreeSlot = i - 1;
+        }
+
+        mData = data;
+        mDenseToSlot = denseToSlot;
+        mSlots = slots;
+        mCapacity = count;
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_SLOTMAP_H
@@ -0,0 +1,365 @@
+//
+// Created by Egor Orachyov on 03.03.2019.
+//
+
+#ifndef BERSERK_SOAARRAY_H
+#define BERSERK_SOAARRAY_H
+
+#include <new>
+#include <tuple>
+#include <utility>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+#include "Misc/Relocation.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+#include "Containers/AlignedArray.h"
+
+namespace Berserk
+{
+
+    /** Compile time sequence of column indices (for expansion of columns pack) */
+    template <uint32 ... Is>
+    struct SoAIndices {};
+
+    template <uint32 N, uint32 ... Is>
+    struct SoAMakeIndices : SoAMakeIndices<N - 1, N - 1, Is...> {};
+
+    template <uint32 ... Is>
+    struct SoAMakeIndices<0, Is...> { typedef SoAIndices<Is...> Type; };
+
+    /**
+     * Packed elements of one column for batched (SIMD) processing
+     *
+     * @tparam T Type of column elements
+     */
+    template <typename T>
+    struct SoAView
+    {
+        T* data;                // Aligned on SoAArray::ALIGNMENT
+        uint32 count;           // Number of rows
+        uint32 paddedCount;     // Number of rows rounded up to SoAArray::SIMD_WIDTH (tail has unspecified values)
+
+        T& operator [] (uint32 index) { return data[index]; }
+    };
+
+    /**
+     * Structure of arrays container: each field (column) of the row is stored
+     * in separate aligned array, so batched passes (transformation, culling)
+     * read only needed fields in packed form and feed them in SIMD routines
+     * directly (for example Frustum::inside_SIMD).
+     *
+     * Rows are packed: removal moves the last row in place of removed one.
+     * Each row also has stable id, which is valid until row is removed
+     * (ids of removed rows are reused).
+     *
+     * Capacity is multiple of SIMD_WIDTH, therefore padded views could be
+     * processed without scalar epilogue (results for the tail are ignored).
+     *
+     * @tparam Ts Types of columns
+     */
+    template <typename ... Ts>
+    class SoAArray
+    {
+    public:
+
+        /** Number of columns */
+        static const uint32 COLUMNS_COUNT = sizeof...(Ts);
+
+        /** Number of elements, processed by one SIMD instruction (SSE float32) */
+        static const uint32 SIMD_WIDTH = 4;
+
+        /** Alignment of columns */
+        static const uint32 ALIGNMENT = CACHE_LINE_SIZE;
+
+        /** Default number of rows */
+        static const uint32 DEFAULT_CAPACITY = 64;
+
+        /** Id of not existing row */
+        static const uint32 INVALID_ID = 0xffffffff;
+
+        /** Type of column with index C */
+        template <uint32 C>
+        using Type = typename std::tuple_element<C, std::tuple<Ts...>>::type;
+
+    public:
+
+        /**
+         * Allocates columns
+         * @param capacity  Initial number of rows
+         * @param allocator Allocator for columns (must support ALIGNMENT) [or nullptr for default]
+         */
+        explicit SoAArray(uint32 capacity = DEFAULT_CAPACITY, IAllocator* allocator = nullptr);
+
+        SoAArray(const SoAArray& other) = delete;
+
+        SoAArray& operator = (const SoAArray& other) = delete;
+
+        ~SoAArray();
+
+        GEN_NEW_DELETE(SoAArray);
+
+        /**
+         * Adds row in the end of columns
+         * @warning Values must not reference rows of this array (columns could be reallocated)
+         * @param values Values of columns
+         * @return Stable id of the row
+         */
+        uint32 add(const Ts& ... values);
+
+        /**
+         * Removes row with swap of the last one in its place
+         * @param id Id of the row to remove
+         */
+        void remove(uint32 id);
+
+        /** Removes all the rows */
+        void empty();
+
+        /**
+         * Expands columns to store count rows without reallocations
+         * @param count Desired capacity
+         */
+        void reserve(uint32 count);
+
+        /** @return True if row with id exists */
+        bool contains(uint32 id) const { return id < mIdsCapacity && mIdToIndex[id] < mSize && mIndexToId[mIdToIndex[id]] == id; }
+
+        /** @return Packed index of the row with id */
+        uint32 getIndex(uint32 id) const
+        {
+            FAIL(contains(id), "SoAArray: invalid row id %u", id);
+            return mIdToIndex[id];
+        }
+
+        /** @return Id of the row with packed index */
+        uint32 getId(uint32 index) const
+        {
+            FAIL(index < mSize, "Index out of range %u", index);
+            return mIndexToId[index];
+        }
+
+        /** @return Value of column C in the row with id */
+        template <uint32 C>
+        Type<C>& get(uint32 id) { return column<C>()[getIndex(id)]; }
+
+        /** @return Pointer to packed column C (aligned on ALIGNMENT) */
+        template <uint32 C>
+        Type<C>* column() { return (Type<C>*) mColumns[C]; }
+
+        /** @return View of packed column C */
+        template <uint32 C>
+        SoAView<Type<C>> view() { return { column<C>(), mSize, getPaddedSize() }; }
+
+        /** @return Number of rows */
+        uint32 getSize() const { return mSize; }
+
+        /** @return Number of rows rounded up to SIMD_WIDTH */
+        uint32 getPaddedSize() const { return (mSize + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH; }
+
+        /** @return Max number of rows without expansion */
+        uint32 getCapacity() const { return mCapacity; }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const { return mCapacity * (getRowSize() + 2 * (uint32) sizeof(uint32)); }
+
+        /** @return Size of all the columns of one row */
+        static uint32 getRowSize()
+        {
+            uint32 sizes[] = { (uint32) sizeof(Ts)... };
+            uint32 size = 0;
+            for (auto s : sizes) size += s;
+            return size;
+        }
+
+    private:
+
+        template <uint32 ... Is>
+        void construct(SoAIndices<Is...>, uint32 index, const Ts& ... values)
+        {
+            int32 expansion[] = { (new (&column<Is>()[index]) Ts(values), 0)... };
+            (void) expansion;
+        }
+
+        template <uint32 ... Is>
+        void destroy(SoAIndices<Is...>, uint32 index)
+        {
+            int32 expansion[] = { (column<Is>()[index].~Ts(), 0)... };
+            (void) expansion;
+        }
+
+        template <uint32 ... Is>
+        void move(SoAIndices<Is...>, uint32 destination, uint32 source)
+        {
+            int32 expansion[] = { (relocate(&column<Is>()[destination], &column<Is>()[source], 1), 0)... };
+            (void) expansion;
+        }
+
+        template <uint32 ... Is>
+        void reallocate(SoAIndices<Is...>, uint32 capacity)
+        {
+            int32 expansion[] = { (reallocateColumn<Is>(capacity), 0)... };
+            (void) expansion;
+        }
+
+        /** Moves rows of column in new buffer (padding rows are zero) */
+        template <uint32 C>
+        void reallocateColumn(uint32 capacity)
+        {
+            auto buffer = (Type<C>*) mAllocator->allocate(capacity * (uint32) sizeof(Type<C>), ALIGNMENT);
+            memset((void*) buffer, 0, capacity * sizeof(Type<C>));
+
+            if (mColumns[C])
+            {
+                relocate(buffer, column<C>(), mSize);
+                mAllocator->free(mColumns[C]);
+            }
+
+            mColumns[C] = buffer;
+        }
+
+        /** Expands ids mapping arrays (new ids are added in free list) */
+        void reallocateIds(uint32 capacity);
+
+        typedef typename SoAMakeIndices<sizeof...(Ts)>::Type Columns;
+
+    private:
+
+        uint32 mSize = 0;
+        uint32 mCapacity = 0;
+        uint32 mIdsCapacity = 0;
+        uint32 mFreeId = INVALID_ID;        // Head of the list of free ids (linked via mIdToIndex)
+        uint32* mIdToIndex = nullptr;       // Packed index of row [or next free id]
+        uint32* mIndexToId = nullptr;       // Id of the packed row
+        void* mColumns[sizeof...(Ts)] = {};
+        IAllocator* mAllocator = nullptr;
+
+    };
+
+    template <typename ... Ts>
+    SoAArray<Ts...>::SoAArray(uint32 capacity, IAllocator *allocator)
+    {
+        static_assert(sizeof...(Ts) > 0, "SoAArray must have at least one column");
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        reserve(capacity > SIMD_WIDTH ? capacity : SIMD_WIDTH);
+    }
+
+    template <typename ... Ts>
+    SoAArray<Ts...>::~SoAArray()
+    {
+        if (mAllocator)
+        {
+            empty();
+
+            for (auto buffer : mColumns) mAllocator->free(buffer);
+            mAllocator->free(mIdToIndex);
+            mAllocator->free(mIndexToId);
+
+            mAllocator = nullptr;
+        }
+    }
+
+    template <typename ... Ts>
+    uint32 SoAArray<Ts...>::add(const Ts& ... values)
+    {
+        if (mSize == mCapacity) reserve(mCapacity * 2);
+
+        uint32 index = mSize;
+        uint32 id = mFreeId;
+
+        mFreeId = mIdToIndex[id];
+        mIdToIndex[id] = index;
+        mIndexToId[index] = id;
+
+        construct(Columns(), index, values...);
+        mSize += 1;
+
+        return id;
+    }
+
+    template <typename ... Ts>
+    void SoAArray<Ts...>::remove(uint32 id)
+    {
+        uint32 index = getIndex(id);
+        uint32 last = mSize - 1;
+
+        destroy(Columns(), index);
+
+        if (index != last)
+        {
+            move(Columns(), index, last);
+
+            uint32 movedId = mIndexToId[last];
+            mIdToIndex[movedId] = index;
+            mIndexToId[index] = movedId;
+        }
+
+        mIdToIndex[id] = mFreeId;
+        mFreeId = id;
+        mSize -= 1;
+    }
+
+    template <typename ... Ts>
+    void SoAArray<Ts...>::empty()
+    {
+        // Ids are released in reverse order, so they are reused from 0
+
+        for (uint32 index = mSize; index > 0; index--)
+        {
+            uint32 id = mIndexToId[index - 1];
+
+            destroy(Columns(), index - 1);
+            mIdToIndex[id] = mFreeId;
+            mFreeId = id;
+        }
+
+        mSize = 0;
+    }
+
+    template <typename ... Ts>
+    void SoAArray<Ts...>::reserve(uint32 count)
+    {
+        uint32 capacity = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+        if (capacity <= mCapacity) return;
+
+        reallocate(Columns(), capacity);
+        reallocateIds(capacity);
+
+        mCapacity = capacity;
+    }
+
+    template <typename ... Ts>
+    void SoAArray<Ts...>::reallocateIds(uint32 capacity)
+    {
+        auto idToIndex = (uint32*) mAllocator->allocate(capacity * (uint32) sizeof(uint32));
+        auto indexToId = (uint32*) mAllocator->allocate(capacity * (uint32) sizeof(uint32));
+
+        if (mIdToIndex)
+        {
+            memcpy(idToIndex, mIdToIndex, mIdsCapacity * sizeof(uint32));
+            memcpy(indexToId, mIndexToId, mIdsCapacity * sizeof(uint32));
+            mAllocator->free(mIdToIndex);
+            mAllocator->free(mIndexToId);
+        }
+
+        // New ids are pushed in free list in reverse order (the smallest is taken first)
+
+        for (uint32 id = capacity; id > mIdsCapacity; id--)
+        {
+            idToIndex[id - 1] = mFreeId;
+            mFreeId = id - 1;
+        }
+
+        mIdToIndex = idToIndex;
+        mIndexToId = indexToId;
+        mIdsCapacity = capacity;
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_SOAARRAY_H
@@ -0,0 +1,67 @@
+//
+// Created by Egor Orachyov on 08.03.2019.
+//
+
+#ifndef BERSERK_JOB_H
+#define BERSERK_JOB_H
+
+#include <atomic>
+#include "Misc/Types.h"
+#include "Containers/AlignedArray.h"
+
+namespace Berserk
+{
+
+    class JobSystem;
+
+    /**
+     * Unit of work of the job system: function with small inline data.
+     * Job is finished when its function returned and all its children
+     * are finished (parent counts itself and its unfinished children).
+     *
+     * Jobs are allocated by job system in per-thread pools and occupy
+     * one cache line (no false sharing of counters of different jobs).
+     *
+     * @warning Job memory is reused: finished job must not be accessed
+     *          after the creating thread allocated other jobs
+     */
+    class alignas(CACHE_LINE_SIZE) Job
+    {
+    public:
+
+        /** Job function: executed once by any thread of the job system */
+        typedef void (*Function)(JobSystem& system, Job& job);
+
+        /** Max size of inline job data */
+        static const uint32 DATA_SIZE = CACHE_LINE_SIZE - sizeof(Function) - sizeof(Job*) - sizeof(uint64);
+
+    public:
+
+        /** @return Inline data of the job */
+        template <typename T>
+        T& getData()
+        {
+            static_assert(sizeof(T) <= DATA_SIZE, "Job: data type is too large");
+            return *((T*) mData);
+        }
+
+        /** @return Parent of the job [or nullptr for root job] */
+        Job* getParent() const { return mParent; }
+
+        /** @return True if job and all its children are finished */
+        bool isFinished() const { return mUnfinished.load(std::memory_order_acquire) == 0; }
+
+    private:
+
+        friend class JobSystem;
+
+        Function mFunction = nullptr;
+        Job* mParent = nullptr;
+        std::atomic<int32> mUnfinished{0};  // This job (until function returns) and unfinished children
+        alignas(uint64) uint8 mData[DATA_SIZE];
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_JOB_H
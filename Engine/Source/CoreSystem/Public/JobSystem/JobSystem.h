@@ -0,0 +1,210 @@
+//
+// Created by Egor Orachyov on 08.03.2019.
+//
+
+#ifndef BERSERK_JOBSYSTEM_H
+#define BERSERK_JOBSYSTEM_H
+
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "Misc/Types.h"
+#include "Misc/Include.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "JobSystem/Job.h"
+#include "JobSystem/WorkStealingDeque.h"
+#include "Threading/Thread.h"
+#include "Threading/IRunnable.h"
+#include "Threading/MPMCQueue.h"
+#include "Containers/ArrayList.h"
+
+namespace Berserk
+{
+
+    /**
+     * Work-stealing job scheduler.
+     *
+     * Each thread of the system (workers and the thread created the system)
+     * has its own pool of jobs and Chase-Lev deque: jobs are allocated and
+     * pushed without synchronization, owner executes the newest jobs of its
+     * deque (hot in cache), idle threads steal the oldest jobs from random
+     * victims. Threads outside the system submit jobs via shared queue.
+     *
+     * Worker without jobs spins for a short time and then parks on condition
+     * variable until new jobs are submitted (idle workers do not burn CPU).
+     * Threads waiting for job execute other jobs while there are any and
+     * park otherwise.
+     *
+     * Jobs could create child jobs: parent is finished only when all its
+     * children are finished, therefore waiting for root job waits for the
+     * whole tree of jobs.
+     */
+    class CORE_API JobSystem
+    {
+    public:
+
+        /** Default number of jobs in one page of the jobs pool of each thread */
+        static const uint32 DEFAULT_JOBS_PER_THREAD = Buffers::SIZE_4096;
+
+        /** Number of failed searches for job before worker parks */
+        static const uint32 SPIN_COUNT = 64;
+
+    public:
+
+        /**
+         * Creates system and starts workers
+         * @param workersCount   Number of worker threads [or 0 for number of cores - 1]
+         * @param jobsPerThread  Size of jobs page and deque of each thread (rounded up to power of 2)
+         * @param allocator      Allocator for internal buffers [or nullptr for default]
+         */
+        explicit JobSystem(uint32 workersCount = 0, uint32 jobsPerThread = DEFAULT_JOBS_PER_THREAD, IAllocator* allocator = nullptr);
+
+        JobSystem(const JobSystem& other) = delete;
+
+        JobSystem& operator = (const JobSystem& other) = delete;
+
+        ~JobSystem();
+
+        GEN_NEW_DELETE(JobSystem);
+
+    public:
+
+        /** @return New root job with function (must be run) */
+        Job* create(Job::Function function) { return allocate(function, nullptr, nullptr, 0); }
+
+        /** @return New root job with function and copy of data (must be run) */
+        template <typename T>
+        Job* create(Job::Function function, const T& data)
+        {
+            static_assert(sizeof(T) <= Job::DATA_SIZE, "JobSystem: job data type is too large");
+            return allocate(function, nullptr, &data, sizeof(T));
+        }
+
+        /**
+         * Creates child job (parent is not finished until the child is finished)
+         * @warning Parent must not be finished (create children in parent
+         *          function or before parent is run)
+         * @return New job (must be run)
+         */
+        Job* createChild(Job* parent, Job::Function function) { return allocate(function, parent, nullptr, 0); }
+
+        /** @copydoc createChild() */
+        template <typename T>
+        Job* createChild(Job* parent, Job::Function function, const T& data)
+        {
+            static_assert(sizeof(T) <= Job::DATA_SIZE, "JobSystem: job data type is too large");
+            return allocate(function, parent, &data, sizeof(T));
+        }
+
+        /** @return New job which runs runnable (exit code is ignored) */
+        Job* create(IRunnable* runnable, Job* parent = nullptr);
+
+        /** Submits job for execution (job is executed inline if the deque of the thread or foreign queue is full) */
+        void run(Job* job);
+
+        /** Executes jobs of the system until job is finished */
+        void wait(const Job* job);
+
+        /** Stops and joins workers (not started jobs are not executed) */
+        void shutdown();
+
+        /** Stops workers and detaches their threads */
+        void terminate();
+
+        /** @return Number of worker threads */
+        uint32 getWorkersCount() const { return mWorkersCount; }
+
+        /** @return Approximate number of submitted, not started jobs */
+        uint32 getPendingJobsCount() const
+        {
+            int32 pending = mPendingJobs.load(std::memory_order_relaxed);
+            return (uint32)(pending > 0 ? pending : 0);
+        }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const;
+
+    private:
+
+        class Worker : public IRunnable
+        {
+        public:
+
+            int32 run() override { mSystem->work(mIndex); return 0; }
+
+            JobSystem* mSystem = nullptr;
+            uint32 mIndex = 0;
+
+        };
+
+        /** Jobs of one thread (written by the owner, stolen by others) */
+        struct ThreadContext
+        {
+            ThreadContext(uint32 capacity, IAllocator* allocator) : deque(capacity, allocator), pages(ArrayList<Job*>::MIN_INITIAL_SIZE, allocator) {}
+
+            WorkStealingDeque<Job*> deque;
+            ArrayList<Job*> pages;          // Pages of jobs pool (jobs are never moved)
+            uint32 cursor = 0;              // Next slot of the pool to check
+            uint32 random = 0;              // Xorshift state for victims choice
+            uint8 padding[CACHE_LINE_SIZE];
+        };
+
+        /** Marks thread which does not belong to the system */
+        static const uint32 FOREIGN_THREAD = 0xffffffff;
+
+        /** @return Index of context of calling thread [or FOREIGN_THREAD] */
+        uint32 getThreadIndex() const;
+
+        /** @return Job from the thread pool, initialized for execution */
+        Job* allocate(Job::Function function, Job* parent, const void* data, uint32 size);
+
+        /** @return Finished job of the pool (new page is added if all the jobs are not finished) */
+        Job* acquire(ThreadContext& context);
+
+        /** Adds page of finished jobs in the pool */
+        void expand(ThreadContext& context);
+
+        /** @return Job to execute (own, submitted by foreign thread or stolen) [or nullptr] */
+        Job* find(uint32 index);
+
+        /** Executes job and finishes it */
+        void execute(Job* job);
+
+        /** Decrements unfinished counter of job (and its parent when job is finished) */
+        void finish(Job* job);
+
+        /** Main loop of worker thread */
+        void work(uint32 index);
+
+    private:
+
+        uint32 mWorkersCount;
+        uint32 mContextsCount;              // Workers and the thread created the system
+        uint32 mJobsPerThread;
+        IAllocator* mAllocator;
+
+        ThreadContext* mContexts;
+        Worker* mWorkers;
+        Thread* mThreads;
+
+        std::mutex mForeignMutex;           // Guards pool of jobs of foreign threads
+        ThreadContext* mForeignContext;     // Pool of jobs of foreign threads (deque is not used)
+        MPMCQueue<Job*> mForeignJobs;       // Jobs submitted by foreign threads
+
+        std::atomic<int32> mPendingJobs;
+        std::atomic<bool> mShutdown;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWorkCondition;     // Idle workers wait for new jobs
+        std::condition_variable mDoneCondition;     // Waiting threads wait for finished jobs
+        std::atomic<uint32> mSleepingWorkers;
+        std::atomic<uint32> mWaitingThreads;
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_JOBSYSTEM_H
@@ -0,0 +1,189 @@
+//
+// Created by Egor Orachyov on 08.03.2019.
+//
+
+#ifndef BERSERK_WORKSTEALINGDEQUE_H
+#define BERSERK_WORKSTEALINGDEQUE_H
+
+#include <new>
+#include <atomic>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+#include "Containers/AlignedArray.h"
+
+namespace Berserk
+{
+
+    /**
+     * Bounded Chase-Lev work-stealing deque (with C11 memory model
+     * orders of N. M. Le et al. "Correct and Efficient Work-Stealing
+     * for Weak Memory Models").
+     *
+     * Owner thread pushes and pops elements in the bottom of the deque
+     * (LIFO, no CAS except for the last element), other threads steal
+     * elements from the top (FIFO, one CAS). Does not allocate memory
+     * after creation: push fails if the deque is full.
+     *
+     * @tparam T Type of elements (trivially copyable, e.g. pointer)
+     */
+    template <typename T>
+    class WorkStealingDeque
+    {
+    public:
+
+        /** Default max number of elements */
+        static const uint32 DEFAULT_CAPACITY = 4096;
+
+        /** Min number of elements */
+        static const uint32 MIN_CAPACITY = 2;
+
+    public:
+
+        /**
+         * Allocates cells of the deque
+         * @param capacity  Max number of elements (rounded up to power of 2)
+         * @param allocator Allocator for cells [or nullptr for default]
+         */
+        explicit WorkStealingDeque(uint32 capacity = DEFAULT_CAPACITY, IAllocator* allocator = nullptr);
+
+        WorkStealingDeque(const WorkStealingDeque& other) = delete;
+
+        WorkStealingDeque& operator = (const WorkStealingDeque& other) = delete;
+
+        ~WorkStealingDeque();
+
+        GEN_NEW_DELETE(WorkStealingDeque);
+
+        /** Adds element in the bottom (owner only) @return False if the deque is full */
+        bool push(const T& element);
+
+        /** Removes element from the bottom (owner only) @return False if the deque is empty */
+        bool pop(T& result);
+
+        /** Removes element from the top (any thread) @return False if the deque is empty or other thread took the element */
+        bool steal(T& result);
+
+        /** @return Approximate number of elements */
+        uint32 getSize() const
+        {
+            int64 bottom = mBottom.load(std::memory_order_relaxed);
+            int64 top = mTop.load(std::memory_order_relaxed);
+            return (uint32)(bottom > top ? bottom - top : 0);
+        }
+
+        /** @return Max number of elements in the deque */
+        uint32 getCapacity() const { return mCapacity; }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const { return mCapacity * (uint32) sizeof(std::atomic<T>); }
+
+    private:
+
+        std::atomic<T>* mCells;
+        uint32 mCapacity;
+        uint32 mMask;
+        IAllocator* mAllocator;
+
+        uint8 mPadding0[CACHE_LINE_SIZE];
+        std::atomic<int64> mTop;            // Next position to steal (written by thieves)
+        uint8 mPadding1[CACHE_LINE_SIZE];
+        std::atomic<int64> mBottom;         // Next position to push (written by owner)
+        uint8 mPadding2[CACHE_LINE_SIZE];
+
+    };
+
+    template <typename T>
+    WorkStealingDeque<T>::WorkStealingDeque(uint32 capacity, IAllocator *allocator)
+            : mTop(0), mBottom(0)
+    {
+        FAIL(capacity >= MIN_CAPACITY, "Capacity must be more than %u", MIN_CAPACITY);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mCapacity = MIN_CAPACITY;
+        while (mCapacity < capacity) mCapacity *= 2;
+
+        mMask = mCapacity - 1;
+        mCells = (std::atomic<T>*) mAllocator->allocate(mCapacity * (uint32) sizeof(std::atomic<T>), CACHE_LINE_SIZE);
+
+        for (uint32 i = 0; i < mCapacity; i++)
+        {
+            new (&mCells[i]) std::atomic<T>(T());
+        }
+    }
+
+    template <typename T>
+    WorkStealingDeque<T>::~WorkStealingDeque()
+    {
+        if (mAllocator)
+        {
+            mAllocator->free(mCells);
+            mAllocator = nullptr;
+        }
+    }
+
+    template <typename T>
+    bool WorkStealingDeque<T>::push(const T &element)
+    {
+        int64 bottom = mBottom.load(std::memory_order_relaxed);
+        int64 top = mTop.load(std::memory_order_acquire);
+
+        if (bottom - top >= (int64) mCapacity) return false;
+
+        mCells[bottom & mMask].store(element, std::memory_order_relaxed);
+        mBottom.store(bottom + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template <typename T>
+    bool WorkStealingDeque<T>::pop(T &result)
+    {
+        // Bottom is reserved before top is read: thieves see that the last
+        // element is contested and resolve it via CAS on top
+
+        int64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 top = mTop.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        result = mCells[bottom & mMask].load(std::memory_order_relaxed);
+
+        if (top == bottom)
+        {
+            bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    bool WorkStealingDeque<T>::steal(T &result)
+    {
+        int64 top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64 bottom = mBottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) return false;
+
+        result = mCells[top & mMask].load(std::memory_order_relaxed);
+
+        return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_WORKSTEALINGDEQUE_H
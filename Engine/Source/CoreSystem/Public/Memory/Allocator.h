@@ -5,7 +5,10 @@
 #ifndef BERSERK_ALLOCATOR_H
 #define BERSERK_ALLOCATOR_H
 
+#include <mutex>
+#include <atomic>
 #include "Misc/Types.h"
+#include "Misc/Buffers.h"
 #include "Misc/Include.h"
 #include "Misc/UsageDescriptors.h"
 #include "Memory/IAllocator.h"
@@ -21,31 +24,163 @@ namespace Berserk
      * for acquiring memory from OS for engine specific
      * sub-systems and allocators
      *
+     * Small blocks (up to MAX_SMALL_SIZE) are served by per-thread caches
+     * of size-classed free lists. Caches are refilled from and returned to
+     * the shared central heap in batches, therefore the most of allocate / free
+     * calls do not take any lock. Central heap carves objects from spans
+     * of SPAN_SIZE, acquired via malloc. Bigger blocks go to malloc directly.
+     *
+     * Statistics are collected per thread (each counter has only one writer)
+     * and aggregated in the get* calls.
+     *
      * @note #include <malloc.h>
      *       struct mallinfo mallinfo(void);
      *       http://man7.org/linux/man-pages/man3/mallinfo.3.html
      */
     class MEMORY_API Allocator : public IAllocator
     {
+    public:
+
+        /** Max size of block (with header) served by thread caches */
+        static const uint32 MAX_SMALL_SIZE = Buffers::KiB * 32;
+
+        /** 8 classes with step 16 up to 128 bytes and 4 classes per each next power of 2 */
+        static const uint32 SIZE_CLASSES_COUNT = 40;
+
+        /** Size of memory region, carved by central heap into objects of one class */
+        static const uint32 SPAN_SIZE = Buffers::KiB * 64;
+
+        /** Max number of objects moved between thread cache and central heap at once */
+        static const uint32 MAX_BATCH_COUNT = 32;
+
     private:
 
+        struct Header
+        {
+            uint32 sizeClass;   // Index of size class, LARGE_CLASS or ALIGNED_CLASS
+            uint32 tag;         // Stats tag of allocation (free is attributed to it)
+            uint64 size;        // Total size of block with header
+                                // Total size 16 (multiple of alignment)
+        };
+
+        struct Object
+        {
+            Object* next;       // Next free object of the same class
+        };
+
+        struct Span
+        {
+            Span*  next;        // Next span of the same class
+            uint64 size;        // Size of span
+                                // Total size 16 (multiple of alignment)
+        };
+
+        struct FreeList
+        {
+            Object* head;       // First free object
+            uint32  length;     // Number of objects in the list
+        };
+
+        struct CentralList
+        {
+            std::mutex mutex;   // Guards this class in the central heap
+            Object* head;       // First free object
+            Span*   spans;      // All the spans of this class
+            uint32  length;     // Number of objects in the list
+        };
+
+        struct ThreadCache
+        {
+            FreeList lists[SIZE_CLASSES_COUNT];
+
+            std::atomic<uint64> allocCalls;     // Written only by owner thread
+            std::atomic<uint64> freeCalls;      // Written only by owner thread
+            std::atomic<uint64> totalMemUsage;  // Written only by owner thread
+
+            ThreadCache* prev;  // Registered caches list
+            ThreadCache* next;  // Registered caches list
+        };
+
+        struct ThreadCacheHolder
+        {
+            /** Returns thread cache into the central heap on thread exit */
+            ~ThreadCacheHolder();
+        };
+
+        /** Marks blocks, allocated via malloc directly */
+        static const uint32 LARGE_CLASS = 0xffffffff;
+
+        /** Marks header before aligned pointer (size field keeps original pointer) */
+        static const uint32 ALIGNED_CLASS = 0xfffffffe;
+
         Allocator();
 
         ~Allocator() override;
 
     public:
 
-        /** Wrapper for malloc */
+        /** Allocates block from thread cache or via malloc for big blocks */
         void* allocate(uint32 size) override;
 
-        /** Wrapper for free */
+        /**
+         * Allocates block with extra alignment space and places header before
+         * aligned pointer, which keeps the original one (for free call)
+         */
+        void* allocate(uint32 size, uint32 alignment) override;
+
+        /** Returns block in thread cache or via free for big blocks */
         void  free(void *pointer) override;
 
+        /** @copydoc IAllocator::getFreeCalls() */
+        uint32 getFreeCalls() const override;
+
+        /** @copydoc IAllocator::getAllocateCalls() */
+        uint32 getAllocateCalls() const override;
+
+        /** @copydoc IAllocator::getTotalMemoryUsage() */
+        uint64 getTotalMemoryUsage() const override;
+
         /** Only one instance for the whole engine */
         static Allocator& getSingleton();
 
+    private:
+
+        /** @return Size class index for aligned size (with header) */
+        static uint32 getSizeClass(uint32 size);
+
+        /** @return Cache of the calling thread or nullptr if it is already released */
+        ThreadCache* getThreadCache();
+
+        /** Moves up to batch objects of chosen class from central heap in the list */
+        void fetchFromCentral(uint32 sizeClass, FreeList& list);
+
+        /** Moves count objects of chosen class from the list in the central heap */
+        void releaseToCentral(uint32 sizeClass, FreeList& list, uint32 count);
+
+        /** Returns all the objects of cache in the central heap and folds its stat */
+        void releaseThreadCache(ThreadCache* cache);
+
+        /** Single writer counter increment */
+        static void increment(std::atomic<uint64>& counter, uint64 value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    private:
+
+        uint32 mClassSize[SIZE_CLASSES_COUNT];          // Size of object of each class (with header)
+        uint32 mClassBatch[SIZE_CLASSES_COUNT];         // Number of objects to move between cache and central heap
+        CentralList mCentral[SIZE_CLASSES_COUNT];       // Shared central heap
+
+        mutable std::mutex mCachesMutex;                // Guards caches list and retired stat
+        ThreadCache* mCaches;                           // Currently registered thread caches
+
+        static thread_local ThreadCache* THREAD_CACHE;              // Cache of this thread
+        static thread_local bool THREAD_CACHE_RELEASED;             // Cache was returned on thread exit
+        static thread_local ThreadCacheHolder THREAD_CACHE_HOLDER;  // Releases cache on thread exit
+
     };
 
 }
 
-#endif //BERSERK_ALLOCATOR_H
\ No newline at end of file
+#endif //BERSERK_ALLOCATOR_H
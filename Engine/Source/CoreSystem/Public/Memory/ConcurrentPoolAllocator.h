@@ -0,0 +1,172 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_CONCURRENTPOOLALLOCATOR_H
+#define BERSERK_CONCURRENTPOOLALLOCATOR_H
+
+#include <mutex>
+#include <atomic>
+#include "Memory/PoolAllocator.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Concurrent Pool Allocation
+     *
+     * Thread-safe variant of fixed-size blocks pool allocator with the same
+     * chunk size / chunk count contract, therefore could be passed anywhere
+     * PoolAllocator is expected (HashMap, SharedList, StringPool).
+     *
+     * Each thread works with its own pair of magazines (loaded and previous):
+     * small stacks of up to MAGAZINE_SIZE free chunks. Allocate and free calls
+     * touch only the magazines of the calling thread without any synchronization.
+     * Full magazines are exchanged between threads through the global depot:
+     * lock-free stack with ABA counter in high 16 bits of the pointer. Lock is
+     * taken only to expand the pool with new buffer.
+     *
+     * Threads get magazine slots on the first call (up to MAX_THREADS_COUNT);
+     * the slot is returned on thread exit and the chunks, cached in it,
+     * are reused by the next thread with that slot. Extra threads share
+     * one slot, guarded by mutex.
+     *
+     * @note Pointer tag relies on 48-bit user space virtual addresses
+     */
+    class MEMORY_API ConcurrentPoolAllocator : public PoolAllocator
+    {
+    public:
+
+        /** Max number of chunks in one magazine */
+        static const uint32 MAGAZINE_SIZE = Buffers::SIZE_32;
+
+        /** Max number of threads with own magazines */
+        static const uint32 MAX_THREADS_COUNT = Buffers::SIZE_32;
+
+    private:
+
+        struct Chunk
+        {
+            Chunk* next;            // Next chunk in the magazine
+            Chunk* nextMagazine;    // Next magazine in the depot (only for the first chunk)
+                                    // Total size 16 (multiple of alignment)
+        };
+
+        struct Slot
+        {
+            Chunk* loaded;                      // Magazine for allocate / free calls
+            Chunk* previous;                    // Empty or full magazine to swap with loaded
+            uint32 loadedCount;                 // Chunks in loaded magazine
+            uint32 previousCount;               // Chunks in previous magazine
+            std::atomic<uint64> allocCalls;     // Single writer: owner thread
+            std::atomic<uint64> freeCalls;      // Single writer: owner thread
+            uint64 padding[3];                  // Total size 64 (to avoid false sharing)
+        };
+
+        struct SlotHolder
+        {
+            ~SlotHolder();
+        };
+
+        /** Marks thread without acquired slot */
+        static const uint32 NO_SLOT = 0xffffffff;
+
+        /** Marks slot, shared by threads without own slots */
+        static const uint32 OVERFLOW_SLOT = MAX_THREADS_COUNT;
+
+        /** Tag is stored in bits not used by user space addresses */
+        static const uint32 TAG_SHIFT = 48;
+
+        /** Pointer bits of tagged depot head */
+        static const uint64 POINTER_MASK = (1ull << TAG_SHIFT) - 1;
+
+    public:
+
+        ConcurrentPoolAllocator();
+
+        GEN_NEW_DELETE(ConcurrentPoolAllocator);
+
+    public:
+
+        /**
+         * Creates pool for blocks of chunkSize size
+         * @note The first buffer is created by the first allocate call
+         *       (its chunks are loaded in the calling thread's magazine)
+         * @param chunkSize  Size for one block which could be allocated
+         * @param chunkCount Count of chunks in one expand buffer
+         * @param allocator  Allocator, which allocates memory for this one
+         * @param alignment  Power of 2 alignment of each chunk
+         */
+        ConcurrentPoolAllocator(uint32 chunkSize, uint32 chunkCount, IAllocator* allocator = nullptr, uint32 alignment = MEMORY_ALIGNMENT);
+
+        /** Aligned allocate of pool (checks alignment and calls allocate) */
+        using PoolAllocator::allocate;
+
+        ~ConcurrentPoolAllocator() override = default;
+
+        /**
+         * Takes chunk from the thread's magazine. If magazines are empty,
+         * loads full magazine from depot or expands the pool
+         *
+         * @return Pointer to free chunk
+         */
+        void *allocate(uint32 size) override;
+
+        /**
+         * Returns chunk in the thread's magazine. If magazines are full,
+         * moves one of them in the depot
+         *
+         * @warning Does not check whether the range of the freed pointer belongs to the pool
+         */
+        void free(void *pointer) override;
+
+        /** @return Total number of free calls of all threads */
+        uint32 getFreeCalls() const override;
+
+        /** @return Total number of allocate calls of all threads */
+        uint32 getAllocateCalls() const override;
+
+        /** @return Total size of chunks in buffers */
+        uint64 getTotalMemoryUsage() const override;
+
+        /** @return Number of allocated bytes */
+        uint32 getUsage() const override;
+
+    private:
+
+        /** Takes chunk from slot's magazines */
+        void* allocateChunk(Slot& slot);
+
+        /** Returns chunk in slot's magazines */
+        void freeChunk(Slot& slot, Chunk* chunk);
+
+        /** Creates new buffer and loads its chunks in the slot and the depot */
+        void expand(Slot& slot);
+
+        /** Lock-free push of full magazine in the depot */
+        void push(Chunk* magazine);
+
+        /** Lock-free pop of full magazine from the depot [or nullptr] */
+        Chunk* pop();
+
+        /** @return Index of the calling thread slot (acquires on the first call) */
+        static uint32 getThreadSlot();
+
+    private:
+
+        uint32 mMagazineSize;                       // Chunks in full magazine
+        std::atomic<uint64> mDepot;                 // ABA counter (high 16 bits) and first full magazine
+        mutable std::mutex mBufferMutex;            // Guards buffers list and expand
+        std::mutex mOverflowMutex;                  // Guards shared slot
+        Slot mSlots[MAX_THREADS_COUNT + 1];         // Magazines of threads (last is shared)
+
+        static std::atomic<uint32> SLOTS_MASK;      // Acquired slot indices
+        static thread_local uint32 THREAD_SLOT;
+        static thread_local bool THREAD_SLOT_RELEASED;
+        static thread_local SlotHolder THREAD_SLOT_HOLDER;
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_CONCURRENTPOOLALLOCATOR_H
@@ -0,0 +1,170 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_FRAMEALLOCATOR_H
+#define BERSERK_FRAMEALLOCATOR_H
+
+#include <atomic>
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Frame Allocator
+     *
+     * Transient memory for data, which lives at most a few frames: ring of
+     * N linear arenas of the same size, one arena per frame. Memory of frame K
+     * is valid until frame K + N begins, therefore data, produced by game code
+     * in frame K, could be handed to render thread without any free calls.
+     *
+     * Frames are started via beginFrame() (by the system, which drives the
+     * frame cycle) and retired via retireFrame() (by the last consumer of
+     * frame data). Arena of frame K is reset only when frame K - N was
+     * retired: beginFrame() waits for that.
+     *
+     * @note In the engine loop rendering is synchronous: RenderSystem retires
+     *       the rendered frame and begins the next one in postUpdate, therefore
+     *       only one frame is alive. More frames in flight are used only by
+     *       consumers, which retire frames asynchronously (other threads)
+     *
+     * Allocate calls are lock-free and could be done from any thread
+     * (atomic bump of the current arena offset).
+     *
+     * @warning Data of the frame must not be accessed after the frame is retired
+     */
+    class MEMORY_API FrameAllocator : public IAllocator
+    {
+    public:
+
+        /** Default number of frames in flight */
+        static const uint32 DEFAULT_FRAMES_COUNT = 3;
+
+        /** Max number of arenas in ring */
+        static const uint32 MAX_FRAMES_COUNT = 8;
+
+        /** Because of the efficiency does not allow to create small buffers */
+        static const uint32 MIN_FRAME_SIZE = Buffers::KiB;
+
+    private:
+
+        struct Arena
+        {
+            std::atomic<uint64> offset;     // Bump offset in arena (could be more than size on overflow)
+            uint8* buffer;                  // Memory of arena
+            uint64 frame;                   // Number of frame, which uses arena
+            uint64 peak;                    // Max usage of arena
+            uint64 padding[4];              // Total size 64 (to avoid false sharing)
+        };
+
+    public:
+
+        /**
+         * Creates ring of arenas
+         * @param frameSize     Size of memory for one frame
+         * @param framesCount   Number of frames in flight (arenas in the ring)
+         * @param allocator     Allocator, which allocates memory for this one
+         */
+        explicit FrameAllocator(uint32 frameSize, uint32 framesCount = DEFAULT_FRAMES_COUNT, IAllocator* allocator = nullptr);
+
+        ~FrameAllocator() override;
+
+        GEN_NEW_DELETE(FrameAllocator);
+
+        /**
+         * Allocates block in the arena of current frame (thread-safe)
+         * @warning Fails if frame memory is exhausted
+         *
+         * @param size Chunk to be allocated
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size) override;
+
+        /**
+         * Allocates block with address, multiple of alignment (thread-safe)
+         *
+         * @param size      Chunk to be allocated
+         * @param alignment Power of 2 alignment of returned pointer
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size, uint32 alignment) override;
+
+        /** Memory is freed only when frame arena is reused */
+        void free(void*) override { mFrameFreeCalls.fetch_add(1, std::memory_order_relaxed); }
+
+        /**
+         * Starts next frame: resets and activates its arena. Waits while
+         * frame, which used that arena before (current + 1 - N), is not retired
+         *
+         * @warning Must be called from one thread, which drives the frame cycle
+         * @return Number of started frame
+         */
+        uint64 beginFrame();
+
+        /**
+         * Starts next frame if its arena is free
+         * @return True if frame is started
+         */
+        bool tryBeginFrame();
+
+        /**
+         * Retires the oldest not retired frame: its memory
+         * could be reused by the next frames
+         *
+         * @warning Fails if all started frames are retired
+         */
+        void retireFrame();
+
+        /** @return Number of current frame (the first one is 0) */
+        uint64 getCurrentFrame() const { return mCurrentFrame.load(std::memory_order_acquire); }
+
+        /** @return Number of retired frames */
+        uint64 getRetiredFrames() const { return mRetiredFrames.load(std::memory_order_acquire); }
+
+        /** @return Number of arenas in ring */
+        uint32 getFramesCount() const { return mFramesCount; }
+
+        /** @return Size of arena of one frame */
+        uint32 getFrameSize() const { return mFrameSize; }
+
+        /** @return Bytes allocated in current frame */
+        uint64 getUsage() const;
+
+        /** @return Max bytes allocated in one frame */
+        uint64 getPeakUsage() const;
+
+        /** @return Total number of free calls */
+        uint32 getFreeCalls() const override;
+
+        /** @return Total number of allocate calls */
+        uint32 getAllocateCalls() const override;
+
+    private:
+
+        /** Resets arena and makes it current for frame */
+        void activate(uint64 frame);
+
+    private:
+
+        IAllocator* mAllocator;                 // Allocator, which allocates memory for this one
+        void*  mBuffer;                         // Memory of all arenas
+        uint32 mFrameSize;                      // Size of one arena
+        uint32 mFramesCount;                    // Number of arenas
+        std::atomic<Arena*> mCurrent;           // Arena of current frame
+        std::atomic<uint64> mCurrentFrame;      // Number of current frame
+        std::atomic<uint64> mRetiredFrames;     // Frames [0, retired) are retired
+        std::atomic<uint32> mFrameAllocCalls;   // Allocate calls of all threads
+        std::atomic<uint32> mFrameFreeCalls;    // Free calls of all threads
+        Arena mArenas[MAX_FRAMES_COUNT];        // Ring of arenas
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_FRAMEALLOCATOR_H
@@ -6,6 +6,7 @@
 #define BERSERK_IALLOCATOR_H
 
 #include "Misc/Types.h"
+#include "Profiling/AllocationStats.h"
 
 namespace Berserk
 {
@@ -21,20 +22,64 @@ namespace Berserk
         /** Allocates chosen size of continuous memory block */
         virtual void* allocate(uint32 size) = 0;
 
+        /**
+         * Allocates chosen size of continuous memory block with address,
+         * multiple of alignment. Memory is freed by usual free() call.
+         *
+         * @note Default implementation supports only alignment up to MEMORY_ALIGNMENT
+         *       (the guaranteed alignment of all the allocators)
+         *
+         * @param size      Chunk to be allocated
+         * @param alignment Power of 2 alignment of returned pointer
+         * @return Pointer to the memory
+         */
+        virtual void* allocate(uint32 size, uint32 alignment);
+
         /** Free memory block */
         virtual void free(void *pointer) = 0;
 
         /** @return Total number of memoryFree calls in the engine [in bytes] */
-        uint32 getFreeCalls() const;
+        virtual uint32 getFreeCalls() const;
 
         /** @return Total number of memoryAllocate and memoryCAllocate in the engine [in bytes] */
-        uint32 getAllocateCalls() const;
+        virtual uint32 getAllocateCalls() const;
 
         /** @return Total memory usage for the whole time of engine working [in bytes] */
-        uint64 getTotalMemoryUsage() const;
+        virtual uint64 getTotalMemoryUsage() const;
+
+        /**
+         * Enables runtime statistics of this allocator in AllocationStats
+         * @param name Name of the channel (allocators with the same name share it)
+         */
+        void setStatsName(const char* name) { mStatsChannel = AllocationStats::getChannel(name); }
+
+        /** @return Channel of the allocator in AllocationStats [or NO_CHANNEL] */
+        uint32 getStatsChannel() const { return mStatsChannel; }
+
+    protected:
+
+        /** @return Pointer rounded up to the multiple of power of 2 alignment */
+        static uint8* alignPointer(void* pointer, uint32 alignment)
+        {
+            auto address = (uint64) pointer;
+            return (uint8*)((address + alignment - 1) & ~((uint64)alignment - 1));
+        }
+
+        /** @return True if alignment is not zero power of 2 */
+        static bool isValidAlignment(uint32 alignment)
+        {
+            return (alignment != 0) && ((alignment & (alignment - 1)) == 0);
+        }
+
+        /** Registers allocated block of size bytes in runtime statistics */
+        void trackAllocate(uint64 size) const { AllocationStats::onAllocate(mStatsChannel, size); }
+
+        /** Registers freed block of size bytes in runtime statistics (tag of allocation if known) */
+        void trackFree(uint64 size, uint32 tag = AllocationStats::CURRENT_TAG) const { AllocationStats::onFree(mStatsChannel, size, tag); }
 
     protected:
 
+        uint32 mStatsChannel;   // Channel in runtime statistics [or NO_CHANNEL if not tracked]
         uint32 mFreeCalls;      // Total number of free calls in the engine [in bytes]
         uint32 mAllocCalls;     // Total number of allocate and memoryCAllocate in the engine [in bytes]
         uint64 mTotalMemUsage;  // Total number of allocated mem (this mem actually could be freed)
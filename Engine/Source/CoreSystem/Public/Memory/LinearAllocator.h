@@ -10,6 +10,7 @@
 #include "Misc/UsageDescriptors.h"
 #include "Memory/IAllocator.h"
 #include "Memory/Allocator.h"
+#include "Memory/VirtualArenaAllocator.h"
 #include "Profiling/ProfilingMacro.h"
 
 namespace Berserk
@@ -21,6 +22,10 @@ namespace Berserk
      * List allocator which allocates blocks of chosen size
      * in the buffer of fixed capacity one by one
      *
+     * If allocator is not specified, buffer is virtual arena: capacity is
+     * only reserved and pages are committed on demand (resident memory
+     * follows actual usage, not capacity)
+     *
      * Allows only to free all the allocated chunks at once
      */
     class MEMORY_API LinearAllocator : public IAllocator
@@ -37,6 +42,7 @@ namespace Berserk
          * size of the buffer
          * @param size Total size of the buffer
          * @param allocator  Allocator, which allocates memory for this one
+         *                   [or nullptr to reserve virtual arena]
          */
         explicit LinearAllocator(uint32 size, IAllocator* allocator = nullptr);
 
@@ -50,6 +56,16 @@ namespace Berserk
          */
         void* allocate(uint32 size) override;
 
+        /**
+         * Allocates block in the buffer with address, multiple of alignment
+         * (skipped space before block is lost until clear call)
+         *
+         * @param size      Chunk to be allocated
+         * @param alignment Power of 2 alignment of returned pointer
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size, uint32 alignment) override;
+
         void free(void* pointer) override { mFreeCalls += 1; }
 
         /**
@@ -68,9 +84,10 @@ namespace Berserk
 
     private:
 
-        IAllocator * mAllocator;    // Allocator, which allocates memory for this one
-        void*  mBuffer;             // Pointer to the buffer in the memory
-        uint32 mUsage;              // Currently allocated bytes
+        IAllocator * mAllocator;        // Allocator, which allocates memory for this one
+        VirtualArenaAllocator* mArena;  // Arena of the buffer [or nullptr if allocated via allocator]
+        void*  mBuffer;                 // Pointer to the buffer in the memory [or nullptr if arena]
+        uint32 mUsage;                  // Currently allocated bytes
 
     };
 
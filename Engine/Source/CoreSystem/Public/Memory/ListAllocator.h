@@ -77,6 +77,9 @@ namespace Berserk
             uint64 data;        // Some 8 data to achieve 16 size of structure (ALIGNMENT == 16)
         };
 
+        /** Marks block header before aligned pointer (size field keeps original pointer) */
+        static const uint64 ALIGNED_BLOCK = 0xffffffffffffffff;
+
     public:
 
         /**
@@ -97,6 +100,16 @@ namespace Berserk
          */
         void* allocate(uint32 size) override;
 
+        /**
+         * Allocates block with extra alignment space and places header before
+         * aligned pointer, which keeps the original one (for free call)
+         *
+         * @param size      Chunk to be allocated
+         * @param alignment Power of 2 alignment of returned pointer
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size, uint32 alignment) override;
+
         /**
          * Free allocated chunk of the data
          *
@@ -8,6 +8,7 @@
 #include "Misc/Types.h"
 #include "Misc/Include.h"
 #include "Misc/Buffers.h"
+#include "Misc/Alignment.h"
 #include "Misc/Compilation.h"
 #include "Misc/UsageDescriptors.h"
 #include "Object/NewDelete.h"
@@ -41,7 +42,7 @@ namespace Berserk
         /** Min chunk count (only for huge chunks of data is actual )*/
         static const uint32 MIN_CHUNK_COUNT = 1;
 
-    private:
+    protected:
 
         struct Buffer
         {
@@ -62,6 +63,7 @@ namespace Berserk
         PoolAllocator() : IAllocator(),
                           mChunkSize(0),
                           mChunkCount(0),
+                          mAlignment(0),
                           mUsage(0),
                           mChunk(nullptr),
                           mBuffer(nullptr),
@@ -79,8 +81,10 @@ namespace Berserk
          * free blocks of chunkSize size
          * @param chunkSize  Size for one block which could be allocated
          * @param chunkCount Count of chunks in one expand buffer
+         * @param allocator  Allocator, which allocates memory for this one
+         * @param alignment  Power of 2 alignment of each chunk (chunk size is rounded up to it)
          */
-        PoolAllocator(uint32 chunkSize, uint32 chunkCount, IAllocator* allocator = nullptr);
+        PoolAllocator(uint32 chunkSize, uint32 chunkCount, IAllocator* allocator = nullptr, uint32 alignment = MEMORY_ALIGNMENT);
 
         ~PoolAllocator() override;
 
@@ -88,6 +92,7 @@ namespace Berserk
         {
             mChunkSize = 0;
             mChunkCount = 0;
+            mAlignment = 0;
             mUsage = 0;
             mChunk = nullptr;
             mBuffer = nullptr;
@@ -103,6 +108,12 @@ namespace Berserk
          */
         void *allocate(uint32 size) override;
 
+        /**
+         * Takes free chunk as usual allocate call
+         * @warning Alignment must not be more than pool's chunks alignment
+         */
+        void *allocate(uint32 size, uint32 alignment) override;
+
         /**
          * Try to free chunk with address pointer and return nullptr
          * if succeed
@@ -120,8 +131,16 @@ namespace Berserk
         /** @return Chunks count in one buffer */
         uint32 getChunkCount() const;
 
+        /** @return Alignment of chunks */
+        uint32 getAlignment() const;
+
         /** @return Number of allocated bytes */
-        uint32 getUsage() const;
+        virtual uint32 getUsage() const;
+
+    protected:
+
+        /** @return Offset of the first chunk in buffer (keeps chunks aligned) */
+        uint32 getBufferHeaderSize() const { return (mAlignment > sizeof(Buffer) ? mAlignment : (uint32)sizeof(Buffer)); }
 
     private:
 
@@ -132,10 +151,11 @@ namespace Berserk
         void profile(const char* msg) const;
     #endif
 
-    private:
+    protected:
 
         uint32  mChunkSize;     // Size of one block for allocation
         uint32  mChunkCount;    // Count of chunks in one buffer
+        uint32  mAlignment;     // Alignment of chunks
         uint32  mUsage;         // Currently allocated bytes
         Chunk*  mChunk;         // Pointer to the first free chunk
         Buffer* mBuffer;        // Pointer to currently (last) allocated buffer
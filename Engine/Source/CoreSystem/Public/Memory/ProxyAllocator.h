@@ -5,11 +5,13 @@
 #ifndef BERSERK_PROXYALLOCATOR_H
 #define BERSERK_PROXYALLOCATOR_H
 
+#include <cstdio>
 #include "Misc/Types.h"
 #include "Misc/Buffers.h"
 #include "Misc/Compilation.h"
 #include "Misc/UsageDescriptors.h"
 #include "Memory/IAllocator.h"
+#include "Profiling/ProfilingMacro.h"
 
 namespace Berserk
 {
@@ -18,29 +20,173 @@ namespace Berserk
      * Proxy allocator creates on to of any base allocator class to
      * collect memory resources acquirement and stat. Does not have any
      * memory logic - only redirects allocation calls to profiled allocator object.
+     *
+     * Optionally records allocation trace in the file (one call per line):
+     *   a <pointer> <size>
+     *   f <pointer>
+     * which could be replayed by allocators benchmark.
+     *
+     * Budgeted proxy (created with name and limits) is a budgeting layer of
+     * subsystem: each block gets small header with its size, so live and peak
+     * bytes are known. When live bytes cross soft limit, listeners are notified
+     * (caches could be evicted, streaming slowed down). Allocation over hard
+     * limit notifies listeners once more and returns nullptr, if they could
+     * not free enough memory. Listeners are notified again, when pressure
+     * goes away.
+     *
+     * @warning Not thread-safe
      */
     class MEMORY_API ProxyAllocator : public IAllocator
     {
+    public:
+
+        /** Pressure of live bytes on budget limits */
+        enum PressureLevel : uint32
+        {
+            ePL_Normal = 0,     // Live bytes are under soft limit
+            ePL_Soft,           // Live bytes are over soft limit
+            ePL_Hard            // Allocation would exceed hard limit
+        };
+
+        /**
+         * Called when pressure level changes (memory could be freed in the callback)
+         * @param allocator Budgeted allocator
+         * @param level     New pressure level
+         * @param data      User data of the listener
+         */
+        typedef void (*PressureCallback)(ProxyAllocator& allocator, PressureLevel level, void* data);
+
+        /** Max number of pressure listeners of one allocator */
+        static const uint32 MAX_LISTENERS_COUNT = 4;
+
     public:
 
         /** @param allocator Pointer to allocator object to profile it */
         explicit ProxyAllocator(IAllocator* allocator);
 
+        /**
+         * Creates budgeted proxy
+         * @param allocator Parent allocator
+         * @param name      Name of subsystem (also used as channel in AllocationStats)
+         * @param softLimit Live bytes, which cause soft pressure [or 0 if no limit]
+         * @param hardLimit Max live bytes [or 0 if no limit]
+         */
+        ProxyAllocator(IAllocator* allocator, const char* name, uint64 softLimit, uint64 hardLimit);
+
         ~ProxyAllocator() final = default;
 
         /** @copydoc IAllocator::allocate() */
         void* allocate(uint32 size) final;
 
+        /** @copydoc IAllocator::allocate(uint32,uint32) */
+        void* allocate(uint32 size, uint32 alignment) final;
+
         /** @copydoc IAllocator::free() */
         void free(void *pointer) final;
 
+        /**
+         * Starts [or stops] recording of allocation trace
+         * @param file Opened for writing file [or nullptr to stop recording]
+         */
+        void setTraceFile(FILE* file) { mTraceFile = file; }
+
+        /** Changes limits of budgeted proxy (0 means no limit) */
+        void setLimits(uint64 softLimit, uint64 hardLimit);
+
+        /** Adds listener of pressure level changes */
+        void addPressureListener(PressureCallback callback, void* data = nullptr);
+
+        /** Removes listener with the same callback and data */
+        void removePressureListener(PressureCallback callback, void* data = nullptr);
+
+        /** Starts new high-water mark measurement from current live bytes */
+        void resetPeakUsage() { mPeakUsage = mLiveUsage; }
+
+        /** @return True if proxy tracks live bytes and limits */
+        bool isBudgeted() const { return mIsBudgeted; }
+
+        /** @return Name of budgeted subsystem [or nullptr] */
+        const char* getName() const { return mName; }
+
+        /** @return Bytes of allocated blocks (with headers) */
+        uint64 getLiveUsage() const { return mLiveUsage; }
+
+        /** @return The biggest live bytes since creation or last reset */
+        uint64 getPeakUsage() const { return mPeakUsage; }
+
+        /** @return Soft limit [or 0 if no limit] */
+        uint64 getSoftLimit() const { return mSoftLimit; }
+
+        /** @return Hard limit [or 0 if no limit] */
+        uint64 getHardLimit() const { return mHardLimit; }
+
+        /** @return Current pressure level */
+        PressureLevel getPressureLevel() const { return mPressureLevel; }
+
+        /** @return Number of soft limit crossings */
+        uint32 getSoftPressureCount() const { return mSoftPressureCount; }
+
+        /** @return Number of hard limit hits */
+        uint32 getHardPressureCount() const { return mHardPressureCount; }
+
     private:
 
+        /** Header before each block of budgeted proxy */
+        struct Header
+        {
+            uint64 size;        // Size of block with header and padding
+            uint32 offset;      // Offset of returned pointer from parent's block
+            uint32 data;        // Some data to achieve 16 size of structure (ALIGNMENT == 16)
+        };
+
+        /** Allocates block of budgeted proxy with offset >= header size */
+        void* allocateTracked(uint32 size, uint32 alignment);
+
+        /** Checks hard limit before allocation of size bytes @return False if listeners could not free enough memory */
+        bool reserve(uint64 size);
+
+        /** Updates pressure level after change of live bytes */
+        void updatePressure();
+
+        /** Calls all the listeners */
+        void notify(PressureLevel level);
+
+#if PROFILE_PROXY_ALLOCATOR
+        void profile(const char* msg) const;
+#endif
+
+    private:
+
+        struct Listener
+        {
+            PressureCallback callback;
+            void* data;
+        };
+
         /** Profiled allocator */
         IAllocator* mAllocator;
 
+        /** Allocation trace output [if recorded] */
+        FILE* mTraceFile = nullptr;
+
+        const char* mName = nullptr;            // Name of budgeted subsystem
+        bool mIsBudgeted = false;               // Blocks have headers and live bytes are tracked
+        bool mIsNotifying = false;              // Listeners are called now (no nested notifications)
+
+        uint64 mLiveUsage = 0;                  // Bytes of allocated blocks
+        uint64 mPeakUsage = 0;                  // High-water mark of live bytes
+        uint64 mSoftLimit = 0;                  // Soft pressure threshold
+        uint64 mHardLimit = 0;                  // Max live bytes
+
+        PressureLevel mPressureLevel = ePL_Normal;
+        uint32 mSoftPressureCount = 0;          // Number of soft limit crossings
+        uint32 mHardPressureCount = 0;          // Number of hard limit hits
+
+        uint32 mListenersCount = 0;
+        Listener mListeners[MAX_LISTENERS_COUNT];
+
     };
 
 } // namespace Berserk
 
-#endif //BERSERK_PROXYALLOCATOR_H
\ No newline at end of file
+#endif //BERSERK_PROXYALLOCATOR_H
@@ -0,0 +1,218 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_RELOCATABLEHEAP_H
+#define BERSERK_RELOCATABLEHEAP_H
+
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Relocatable Heap
+     *
+     * Heap for long-living blocks, which are reached only through handles.
+     * Handle stays valid while block is allocated, but block itself could
+     * be moved by the heap, therefore actual pointer must be obtained via
+     * get() and must not be kept across compact() calls.
+     *
+     * Blocks are placed one after another in buffers, mapped directly from
+     * the system. Freed block leaves hole in its buffer. Incremental compactor
+     * (compact() with bytes budget, called once per frame) evacuates the most
+     * fragmented buffer: moves its live blocks in the tail of other buffers.
+     * Empty buffers are unmapped, so resident memory follows live data
+     * instead of creeping up with fragmentation in long sessions.
+     *
+     * Blocks bigger than buffer get dedicated buffers and are never moved.
+     *
+     * @warning Not thread-safe
+     */
+    class MEMORY_API RelocatableHeap
+    {
+    public:
+
+        /** Default size of one buffer */
+        static const uint32 DEFAULT_BUFFER_SIZE = Buffers::MiB;
+
+        /** Min size of one buffer */
+        static const uint32 MIN_BUFFER_SIZE = Buffers::KiB * 64;
+
+        /** Buffer is evacuated if its holes take more than 1 / factor of its used space */
+        static const uint32 DEFAULT_FRAGMENTATION_FACTOR = 4;
+
+        /** Stable reference to the block */
+        struct Handle
+        {
+            uint32 index = INVALID_INDEX;   // Entry in handles table
+            uint32 generation = 0;          // Generation of entry (stale handles are detected)
+
+            bool isNull() const { return index == INVALID_INDEX; }
+
+            bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+
+            bool operator!=(const Handle& other) const { return !(*this == other); }
+        };
+
+    private:
+
+        /** Marks null handle and end of free entries list */
+        static const uint32 INVALID_INDEX = 0xffffffff;
+
+        /** Initial number of entries in handles table */
+        static const uint32 INITIAL_ENTRIES_COUNT = Buffers::SIZE_64;
+
+        struct Buffer
+        {
+            Buffer* prev;       // Previous buffer in the list of all
+            Buffer* next;       // Next buffer in the list of all
+            uint64  size;       // Size of data region of buffer (after header)
+            uint64  offset;     // End of the last block in data region
+            uint64  live;       // Bytes of allocated blocks (with headers)
+            uint64  dead;       // Bytes of holes before offset (with headers)
+        };
+
+        struct Block
+        {
+            uint64 size;        // Size of block data (aligned)
+            uint32 entry;       // Entry of the handle [or INVALID_INDEX if block is free]
+            uint32 data;        // Some data to achieve 16 size of structure (ALIGNMENT == 16)
+        };
+
+        struct Entry
+        {
+            Block*  block;      // Current place of block [or nullptr if entry is free]
+            Buffer* buffer;     // Buffer of the block
+            uint32  generation; // Incremented on each free of the entry
+            uint32  next;       // Next free entry
+        };
+
+    public:
+
+        /**
+         * Creates empty heap (buffers are mapped on demand)
+         * @param bufferSize Size of one buffer (rounded up to page size)
+         * @param allocator  Allocator for handles table [or default engine allocator if nullptr]
+         */
+        explicit RelocatableHeap(uint32 bufferSize = DEFAULT_BUFFER_SIZE, IAllocator* allocator = nullptr);
+
+        ~RelocatableHeap();
+
+        GEN_NEW_DELETE(RelocatableHeap);
+
+        /**
+         * Allocates block (data is aligned on MEMORY_ALIGNMENT)
+         * @param size Size of block in bytes
+         * @return Handle of the block
+         */
+        Handle allocate(uint32 size);
+
+        /** Frees block (handle and all its copies become stale) */
+        void free(Handle handle);
+
+        /** @return Current pointer to block data [or nullptr if handle is stale] */
+        void* get(Handle handle) const;
+
+        /** @return Size of block data [or 0 if handle is stale] */
+        uint32 getSize(Handle handle) const;
+
+        /** @return True if handle references allocated block */
+        bool isValid(Handle handle) const;
+
+        /**
+         * Moves live blocks out of fragmented buffers and unmaps empty ones
+         * @warning Invalidates all the pointers, obtained via get()
+         *
+         * @param budget Max number of bytes to move in this call (at least one block is moved)
+         * @return Number of moved bytes
+         */
+        uint64 compact(uint64 budget);
+
+        /** Moves blocks until all the fragmented buffers are evacuated */
+        void compactAll();
+
+        /** Buffer is evacuated if its holes take more than 1 / factor of its used space */
+        void setFragmentationFactor(uint32 factor) { mFragmentationFactor = (factor > 1 ? factor : 2); }
+
+        /** @return Bytes of allocated blocks (with headers) */
+        uint64 getUsage() const { return mUsage; }
+
+        /** @return Bytes of mapped buffers */
+        uint64 getMappedSize() const { return mMappedSize; }
+
+        /** @return Number of mapped buffers */
+        uint32 getBuffersCount() const { return mBuffersCount; }
+
+        /** @return Total number of bytes moved by compaction */
+        uint64 getMovedBytes() const { return mMovedBytes; }
+
+        /** @return Total number of buffers returned to the system */
+        uint32 getReleasedBuffersCount() const { return mReleasedBuffers; }
+
+        /** @return Number of allocated blocks */
+        uint32 getBlocksCount() const { return mBlocksCount; }
+
+    private:
+
+        /** @return Place for block of size (with header) in buffer other than evacuated one */
+        Block* place(uint64 size, Buffer* &buffer);
+
+        /** @return Buffer with data region of size (at least buffer size) */
+        Buffer* map(uint64 size);
+
+        /** Returns buffer to the system */
+        void unmap(Buffer* buffer);
+
+        /** @return The most fragmented buffer, which is worth evacuation [or nullptr] */
+        Buffer* selectEvacuated() const;
+
+        /** @return Free entry of handles table (expands table if needed) */
+        uint32 acquireEntry();
+
+        /** @return Entry of handle [or nullptr if handle is stale] */
+        Entry* getEntry(Handle handle) const;
+
+        /** @return True if buffer holds single block bigger than buffer size */
+        bool isDedicated(Buffer* buffer) const { return buffer->size > mBufferSize; }
+
+        /** @return Pointer to the first block of buffer */
+        static uint8* getData(Buffer* buffer) { return (uint8*)buffer + sizeof(Buffer); }
+
+#if PROFILE_RELOCATABLE_HEAP
+        void profile(const char* msg) const;
+#endif
+
+    private:
+
+        IAllocator* mAllocator;         // Allocator for handles table
+        Entry*  mEntries;               // Handles table
+        uint32  mEntriesCount;          // Capacity of handles table
+        uint32  mFreeEntry;             // First free entry of handles table
+
+        Buffer* mBuffers;               // List of all buffers
+        Buffer* mCurrent;               // Buffer, which receives new blocks
+        Buffer* mEvacuated;             // Buffer, which is evacuated by compactor [or nullptr]
+        uint64  mCursor;                // Offset of next block to move in evacuated buffer
+
+        uint64  mBufferSize;            // Size of data region of one buffer
+        uint32  mFragmentationFactor;   // Evacuation threshold
+        uint32  mStatsChannel;          // Channel in runtime statistics
+
+        uint64  mUsage;                 // Bytes of allocated blocks (with headers)
+        uint64  mMappedSize;            // Bytes of mapped buffers
+        uint64  mMovedBytes;            // Total moved bytes
+        uint32  mBuffersCount;          // Number of mapped buffers
+        uint32  mReleasedBuffers;       // Total unmapped buffers
+        uint32  mBlocksCount;           // Number of allocated blocks
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_RELOCATABLEHEAP_H
@@ -0,0 +1,150 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_SMALLOBJECTALLOCATOR_H
+#define BERSERK_SMALLOBJECTALLOCATOR_H
+
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/Compilation.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Small Object Allocator
+     *
+     * General purpose allocator for engine objects and small buffers, which
+     * generalizes the StringPool approach. Requests up to MAX_SMALL_SIZE are
+     * rounded up to one of size classes (step 16 up to 128 bytes and 4 classes
+     * per each next power of 2) and served from slabs: SLAB_SIZE regions with
+     * objects of one class. Size class is found via lookup table in O(1).
+     *
+     * Each class keeps partial and full slabs lists. Slab, which becomes empty,
+     * is cached (one per class) or returned to the system. Bigger requests go
+     * to the system heap directly.
+     *
+     * Slabs and large blocks are aligned on SLAB_SIZE and start with common header,
+     * therefore free() finds the owner slab by pointer mask without lookups.
+     *
+     * @warning Not thread-safe: use one allocator per thread (or external lock)
+     */
+    class MEMORY_API SmallObjectAllocator : public IAllocator
+    {
+    public:
+
+        /** Max size of object, served by slabs */
+        static const uint32 MAX_SMALL_SIZE = Buffers::KiB * 4;
+
+        /** 8 classes with step 16 up to 128 bytes and 4 classes per each next power of 2 */
+        static const uint32 SIZE_CLASSES_COUNT = 28;
+
+        /** Size and alignment of one slab (4 pages) */
+        static const uint32 SLAB_SIZE = Buffers::KiB * 16;
+
+    private:
+
+        struct Object
+        {
+            Object* next;       // Next free object in slab
+        };
+
+        struct Slab
+        {
+            uint32 sizeClass;   // Index of size class or LARGE_CLASS
+            uint32 used;        // Number of allocated objects
+            uint32 capacity;    // Max number of objects in slab
+            uint32 carved;      // Number of objects, which were ever allocated
+            Slab*  next;        // Next slab in the class list
+            Slab*  prev;        // Previous slab in the class list
+            Object* free;       // Freed objects (reused before not carved ones)
+            uint64 size;        // Total size of slab or large block
+            uint64 padding[2];  // Total size 64 (objects are cache line aligned)
+        };
+
+        struct SizeClass
+        {
+            Slab*  partial;     // Slabs with free objects
+            Slab*  full;        // Slabs without free objects
+            Slab*  empty;       // Cached empty slab [or nullptr]
+            uint32 size;        // Object size
+            uint32 capacity;    // Objects in one slab
+        };
+
+        /** Marks blocks, allocated in the system heap */
+        static const uint32 LARGE_CLASS = 0xffffffff;
+
+    public:
+
+        SmallObjectAllocator();
+
+        ~SmallObjectAllocator() override;
+
+        GEN_NEW_DELETE(SmallObjectAllocator);
+
+        /**
+         * Allocates object in the slab of suitable size class
+         * (or in the system heap if size is bigger than MAX_SMALL_SIZE)
+         *
+         * @param size Chunk to be allocated
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size) override;
+
+        /** Default aligned allocate (up to MEMORY_ALIGNMENT) */
+        using IAllocator::allocate;
+
+        /**
+         * Returns object in its slab (empty slabs are reclaimed)
+         * @param pointer Pointer to the data to be freed
+         */
+        void free(void* pointer) override;
+
+        /** @return Number of currently allocated bytes (with size class rounding) */
+        uint64 getUsage() const;
+
+        /** @return Number of slabs, acquired from the system */
+        uint32 getSlabsCount() const;
+
+        /** @return Size of class objects for allocations of that size */
+        uint32 getClassSize(uint32 size) const;
+
+    private:
+
+        /** Creates new slab (or takes cached empty one) for size class */
+        Slab* acquireSlab(uint32 sizeClass);
+
+        /** Returns empty slab to the cache or to the system */
+        void releaseSlab(Slab* slab);
+
+        static void insert(Slab* &list, Slab* slab);
+
+        static void remove(Slab* &list, Slab* slab);
+
+        /** Allocates memory aligned on SLAB_SIZE in the system heap */
+        static void* systemAllocate(uint64 size);
+
+        static void systemFree(void* pointer);
+
+#if PROFILE_SMALL_OBJECT_ALLOCATOR
+        void profile(const char* msg) const;
+#endif
+
+    private:
+
+        SizeClass mClasses[SIZE_CLASSES_COUNT];                     // Slabs of each class
+        uint8  mClassIndex[MAX_SMALL_SIZE / Buffers::SIZE_16];      // Class of size for each 16 bytes step
+        Slab*  mLarge;                                              // Blocks in the system heap
+        uint64 mUsage;                                              // Currently allocated bytes
+        uint32 mSlabsCount;                                         // Currently acquired slabs
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_SMALLOBJECTALLOCATOR_H
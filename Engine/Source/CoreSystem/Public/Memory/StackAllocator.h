@@ -10,6 +10,7 @@
 #include "Misc/UsageDescriptors.h"
 #include "Memory/IAllocator.h"
 #include "Memory/Allocator.h"
+#include "Memory/VirtualArenaAllocator.h"
 #include "Profiling/ProfilingMacro.h"
 
 namespace Berserk
@@ -35,6 +36,9 @@ namespace Berserk
      * free(data1)
      *
      * or call free() to free whole stack buffer
+     *
+     * If allocator is not specified, buffer is virtual arena: capacity is
+     * only reserved and pages are committed on demand (free rewinds arena)
      */
     class MEMORY_API StackAllocator : public IAllocator
     {
@@ -48,7 +52,8 @@ namespace Berserk
         struct Data
         {
             Data*  prev;        // Pointer to the previous state of the stack
-            uint64 size;        // Size of that allocated block
+            uint32 size;        // Size of that allocated block (with alignment offset)
+            uint32 offset;      // Offset of aligned pointer from the end of this header
                                 // Total size 16 bytes (multiple of MEMORY_ALIGNMENT)
         };
 
@@ -58,6 +63,7 @@ namespace Berserk
          * Creates and initializes stack allocator with buffer of chosen size
          * @param size Fixed size of buffer for allocating memory
          * @param allocator  Allocator, which allocates memory for this one
+         *                   [or nullptr to reserve virtual arena]
          */
         explicit StackAllocator(uint32 size, IAllocator* allocator = nullptr);
 
@@ -71,6 +77,16 @@ namespace Berserk
          */
         void* allocate(uint32 size) override;
 
+        /**
+         * Allocates block in the buffer with address, multiple of alignment
+         * (header keeps offset of aligned pointer to free it later)
+         *
+         * @param size      Chunk to be allocated
+         * @param alignment Power of 2 alignment of returned pointer
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size, uint32 alignment) override;
+
         /**
          * Free previously allocated chunk of the data
          *
@@ -99,9 +115,10 @@ namespace Berserk
 
     private:
 
-        IAllocator * mAllocator;    // Allocator, which allocates memory for this one
-        Data*  mBuffer;             // Pointer to the buffer in the memory
-        uint32 mUsage;              // Currently allocated bytes
+        IAllocator * mAllocator;        // Allocator, which allocates memory for this one
+        VirtualArenaAllocator* mArena;  // Arena of the buffer [or nullptr if allocated via allocator]
+        Data*  mBuffer;                 // Pointer to the buffer in the memory [top chunk if not empty]
+        uint32 mUsage;                  // Currently allocated bytes
 
     };
 
@@ -0,0 +1,189 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_TLSFALLOCATOR_H
+#define BERSERK_TLSFALLOCATOR_H
+
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/Compilation.h"
+#include "Misc/UsageDescriptors.h"
+#include "Memory/IAllocator.h"
+#include "Memory/Allocator.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Two-Level Segregated Fit Allocator
+     *
+     * General purpose allocator with constant time allocate and free calls.
+     * Free blocks are stored in segregated lists: first level splits sizes by
+     * powers of 2, second level splits each power in 16 linear ranges. Two levels
+     * of bitmaps allow to find not empty list of suitable size via bit scan,
+     * without iterating through blocks.
+     *
+     * Each block has boundary tag (pointer to previous physical block and size
+     * with free flags), therefore freed block is immediately merged with
+     * its free neighbours.
+     *
+     * Memory is acquired from parent allocator in pools of buffer size.
+     * Blocks, which do not fit the pool, are allocated in dedicated pools,
+     * which are returned in parent allocator as soon as the block is freed.
+     *
+     * Implementation:
+     *
+     * Pool:
+     * _________________________________________________________________________
+     * | next | prev | size | dedicated | block | block | ... | block | sentinel |
+     * |______|______|______|___________|_______|_______|_____|_______|__________|
+     *
+     * Block:
+     * _____________________________________________________________
+     * | prev physical | size + flags | next free | prev free | ... |
+     * |_______________|______________|___________|___________|_____|
+     *
+     * @note Free list pointers are stored in the payload of free blocks
+     */
+    class MEMORY_API TLSFAllocator : public IAllocator
+    {
+    public:
+
+        /** Cannot create allocator for buffers less than 1 KiB size (efficiency and usefulness) */
+        static const uint32 MIN_BUFFER_SIZE = Buffers::KiB;
+
+        /** Min size of block payload (to store free list pointers) */
+        static const uint32 MIN_BLOCK_SIZE = Buffers::SIZE_16;
+
+        /** Log2 of number of second level lists for each first level */
+        static const uint32 SL_INDEX_COUNT_LOG2 = 4;
+
+        /** Number of second level lists for each first level */
+        static const uint32 SL_INDEX_COUNT = 1 << SL_INDEX_COUNT_LOG2;
+
+        /** Blocks less than 2^FL_INDEX_SHIFT are stored in the first list with linear step of alignment */
+        static const uint32 FL_INDEX_SHIFT = SL_INDEX_COUNT_LOG2 + 4;
+
+        /** Max first level index (sizes up to 4 GiB) */
+        static const uint32 FL_INDEX_MAX = 32;
+
+        /** Number of first level lists */
+        static const uint32 FL_INDEX_COUNT = FL_INDEX_MAX - FL_INDEX_SHIFT + 1;
+
+    private:
+
+        struct Pool
+        {
+            Pool*  next;        // Next pool in the list
+            Pool*  prev;        // Previous pool in the list
+            uint64 size;        // Total size of the pool
+            uint64 dedicated;   // Pool created for one oversize block
+                                // Total size 32 (multiple of alignment)
+        };
+
+        struct Block
+        {
+            Block* prevPhys;    // Previous physical block (nullptr for the first in pool)
+            uint64 size;        // Size of payload with flags in low bits
+            Block* nextFree;    // Next free block in segregated list (payload of free block)
+            Block* prevFree;    // Previous free block in segregated list (payload of free block)
+        };
+
+        /** Block is free */
+        static const uint64 BLOCK_FREE = 0x1;
+
+        /** Previous physical block is free */
+        static const uint64 BLOCK_PREV_FREE = 0x2;
+
+        /** Size of block header before payload */
+        static const uint32 BLOCK_OVERHEAD = 16;
+
+    public:
+
+        /**
+         * Creates and initializes TLSF allocator
+         * @param bufferSize Size of one internal pool, acquired from parent allocator
+         * @param allocator  Allocator, which allocates memory for this one
+         */
+        explicit TLSFAllocator(uint32 bufferSize, IAllocator* allocator = nullptr);
+
+        ~TLSFAllocator() override;
+
+        /**
+         * Allocates block of the chosen size for constant time
+         * (blocks bigger than buffer size are allocated in dedicated pools)
+         *
+         * @param size Chunk to be allocated
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size) override;
+
+        /** Default aligned allocate (up to MEMORY_ALIGNMENT) */
+        using IAllocator::allocate;
+
+        /**
+         * Free allocated chunk and merge it with free neighbours
+         *
+         * @warning The range and the type of pointer must be checked
+         *          explicitly by the user
+         *
+         * @param pointer Pointer to the data to be freed
+         */
+        void free(void* pointer) override;
+
+        /** @return Size of one internal buffer */
+        uint32 getBufferSize() const;
+
+        /** Currently total allocated memory count [in bytes] */
+        uint64 getUsage() const;
+
+    private:
+
+        /** @return First and second level indices for size */
+        static void mapping(uint64 size, uint32 &fl, uint32 &sl);
+
+        /** @return Indices of the first list, all the blocks of which fit size */
+        static void mappingSearch(uint64 size, uint32 &fl, uint32 &sl);
+
+        /** @return Block in not empty list with indices not less than fl and sl [or nullptr] */
+        Block* findSuitable(uint32 &fl, uint32 &sl);
+
+        /** Add free block in its list */
+        void insert(Block* block);
+
+        /** Remove free block from its list */
+        void remove(Block* block);
+
+        /** Split block and insert the rest (if it is big enough) as free block */
+        void trim(Block* block, uint64 size);
+
+        /** Merge block with its free physical neighbours */
+        Block* merge(Block* block);
+
+        /** Acquires pool in parent allocator and setups its single free block */
+        Block* expand(uint64 size, bool dedicated);
+
+        /** Returns pool in parent allocator */
+        void release(Pool* pool);
+
+        static uint64 getSize(Block* block) { return block->size & ~(BLOCK_FREE | BLOCK_PREV_FREE); }
+
+        static Block* getNext(Block* block) { return (Block*)((uint8*)block + BLOCK_OVERHEAD + getSize(block)); }
+
+    private:
+
+        IAllocator* mAllocator;                             // Allocator, which allocates memory for this one
+        Pool*  mPool;                                       // First pool in the list of pools
+        uint32 mBufferSize;                                 // Size of one pool
+        uint64 mUsage;                                      // Currently allocated and used bytes
+        uint32 mFlBitmap;                                   // Not empty first level lists
+        uint32 mSlBitmap[FL_INDEX_COUNT];                   // Not empty second level lists
+        Block* mBlocks[FL_INDEX_COUNT][SL_INDEX_COUNT];     // Segregated lists of free blocks
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_TLSFALLOCATOR_H
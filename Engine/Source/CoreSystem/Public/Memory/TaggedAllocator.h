@@ -0,0 +1,74 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_TAGGEDALLOCATOR_H
+#define BERSERK_TAGGEDALLOCATOR_H
+
+#include "Misc/Types.h"
+#include "Misc/UsageDescriptors.h"
+#include "Memory/IAllocator.h"
+#include "Memory/TaggedHeap.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Tagged Allocator
+     *
+     * Linear allocator which acquires blocks from tagged heap with its
+     * current tag and allocates chunks in the block one by one. Memory is
+     * returned only when the whole tag is freed in the heap, therefore
+     * free() does nothing.
+     *
+     * @warning Not synchronized: use one instance per thread (or job)
+     */
+    class MEMORY_API TaggedAllocator : public IAllocator
+    {
+    public:
+
+        /**
+         * @param heap Tagged heap to acquire blocks
+         * @param tag  Tag of acquired blocks
+         */
+        TaggedAllocator(TaggedHeap* heap, TaggedHeap::Tag tag);
+
+        ~TaggedAllocator() override = default;
+
+        /**
+         * Allocates chunk in the current block or in new one
+         * @warning Fails if size is more than TaggedHeap::BLOCK_SIZE
+         */
+        void* allocate(uint32 size) override;
+
+        /** Default aligned allocate (up to MEMORY_ALIGNMENT) */
+        using IAllocator::allocate;
+
+        /** Memory is freed only via TaggedHeap::freeTag() */
+        void free(void*) override { mFreeCalls += 1; }
+
+        /**
+         * Starts allocation with new tag
+         * @warning Blocks of previous tag are not freed
+         */
+        void reset(TaggedHeap::Tag tag);
+
+        /** @return Current tag of allocations */
+        TaggedHeap::Tag getTag() const { return mTag; }
+
+        /** @return Bytes allocated with current tag */
+        uint64 getUsage() const { return mUsage; }
+
+    private:
+
+        TaggedHeap* mHeap;          // Source of blocks
+        TaggedHeap::Tag mTag;       // Current tag
+        uint8* mBlock;              // Current block [or nullptr]
+        uint32 mOffset;             // Offset of free region in the block
+        uint64 mUsage;              // Bytes allocated with current tag
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_TAGGEDALLOCATOR_H
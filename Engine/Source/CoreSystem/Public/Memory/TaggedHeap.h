@@ -5,14 +5,142 @@
 #ifndef BERSERK_TAGGEDHEAP_H
 #define BERSERK_TAGGEDHEAP_H
 
+#include <mutex>
+#include <atomic>
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+#include "Profiling/ProfilingMacro.h"
+
 namespace Berserk
 {
 
-}
+    /**
+     * @brief Tagged Heap
+     *
+     * Synchronized allocator of fixed size (2 MiB) blocks. Each acquired block
+     * is marked by category tag (frame number, level load, etc.) and all the
+     * blocks of one tag could be returned at once via freeTag() call.
+     *
+     * Blocks are laid in one virtual memory region, reserved on creation, and
+     * free blocks are kept in lock-free stack with ABA counter, therefore
+     * allocateBlock() does not take any lock (except the first block of new tag,
+     * which registers the tag stat slot). Optionally region could be backed
+     * by huge pages (explicit MAP_HUGETLB with fallback to transparent huge pages).
+     *
+     * @warning The same tag must not be used for allocation while it is freed
+     */
+    class MEMORY_API TaggedHeap
+    {
+    public:
+
+        /** Category of allocated blocks */
+        typedef uint64 Tag;
+
+        /** Size of one block */
+        static const uint32 BLOCK_SIZE = Buffers::MiB * 2;
+
+        /** Max number of tags, which could have acquired blocks at the same time */
+        static const uint32 MAX_TAGS_COUNT = Buffers::SIZE_64;
+
+        /** Marks free block (cannot be used as tag) */
+        static const Tag NO_TAG = 0xffffffffffffffff;
+
+        /** Stat of one tag */
+        struct TagStat
+        {
+            Tag    tag;         // Tag of the blocks
+            uint32 blocks;      // Currently acquired blocks
+            uint32 peak;        // Max number of blocks acquired at once
+            uint64 acquires;    // Total number of allocateBlock calls
+        };
+
+    private:
+
+        struct TagSlot
+        {
+            std::atomic<uint64> tag;
+            std::atomic<uint32> blocks;
+            std::atomic<uint32> peak;
+            std::atomic<uint64> acquires;
+        };
+
+    public:
+
+        /**
+         * Reserves memory region for blocks
+         * @param blocksCount   Max number of blocks, which could be acquired at once
+         * @param useHugePages  Set in true to back blocks by 2 MiB pages (if available)
+         */
+        explicit TaggedHeap(uint32 blocksCount, bool useHugePages = false);
+
+        ~TaggedHeap();
+
+        /**
+         * Acquires free block and marks it by tag (lock-free)
+         * @warning Fails if there is no free blocks
+         * @param tag Category of the block
+         * @return Pointer to the block of BLOCK_SIZE
+         */
+        void* allocateBlock(Tag tag);
+
+        /** Returns all the blocks marked by tag in the heap */
+        void freeTag(Tag tag);
+
+        /** @return Stat of tag (zero counters if tag has no blocks) */
+        TagStat getTagStat(Tag tag) const;
+
+        /**
+         * Writes stat of all the tags with acquired blocks
+         * @param[out] stats Array of MAX_TAGS_COUNT elements
+         * @return Number of written elements
+         */
+        uint32 getTagsStat(TagStat* stats) const;
+
+        /** @return Total number of blocks in the heap */
+        uint32 getBlocksCount() const { return mBlocksCount; }
+
+        /** @return Number of currently free blocks */
+        uint32 getFreeBlocksCount() const { return mFreeBlocks.load(std::memory_order_relaxed); }
+
+        /** @return True if region is backed by huge pages */
+        bool usesHugePages() const { return mUsesHugePages; }
+
+    private:
+
+        /** @return Slot of the tag or nullptr */
+        TagSlot* findSlot(Tag tag) const;
+
+        /** @return Slot of the tag (creates if it does not exist) */
+        TagSlot* acquireSlot(Tag tag);
+
+        /** Lock-free push of block index in the free stack */
+        void push(uint32 index);
+
+        /** Lock-free pop of block index from free stack [or BLOCK_NONE] */
+        uint32 pop();
+
+    private:
+
+        /** Marks empty stack / end of free blocks list */
+        static const uint32 BLOCK_NONE = 0xffffffff;
+
+        uint8* mRegion;                     // Aligned begin of blocks
+        void*  mMapping;                    // Actually reserved memory
+        uint64 mMappingSize;                // Size of reserved memory
+        uint32 mBlocksCount;                // Total number of blocks
+        bool   mUsesHugePages;              // Region is backed by huge pages
+
+        std::atomic<uint64> mFreeHead;      // ABA counter (high 32 bits) and top block index (low 32 bits)
+        std::atomic<uint32> mFreeBlocks;    // Number of free blocks
+        std::atomic<uint32>* mNext;         // Next free block index for each block
+        std::atomic<uint64>* mBlockTag;     // Owner tag of each block
 
-class TaggedHeap {
+        std::mutex mSlotsMutex;             // Guards creation and release of tag slots
+        mutable TagSlot mSlots[MAX_TAGS_COUNT];
 
-};
+    };
 
+} // namespace Berserk
 
 #endif //BERSERK_TAGGEDHEAP_H
@@ -0,0 +1,156 @@
+//
+// Created by Egor Orachyov on 24.01.2019.
+//
+
+#ifndef BERSERK_VIRTUALARENAALLOCATOR_H
+#define BERSERK_VIRTUALARENAALLOCATOR_H
+
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "Profiling/ProfilingMacro.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Virtual Arena Allocator
+     *
+     * Linear allocator, which reserves large range of virtual addresses on
+     * creation (without physical memory) and commits pages on demand, when
+     * the bump pointer crosses committed boundary. Therefore it could be
+     * created with worst case capacity, while resident memory follows
+     * actual usage.
+     *
+     * Allows to free all the allocated chunks at once (clear) or to rewind
+     * to the marker (stack-like frames). If the peak usage since the previous
+     * clear was low, clear returns pages above that peak to the system.
+     *
+     * Optionally the range could be backed by transparent huge pages
+     * (then commit granularity is 2 MiB).
+     *
+     * @note Committed pages are readable / writable, reserved ones are not
+     *       accessible, therefore access outside of allocated range fails
+     */
+    class MEMORY_API VirtualArenaAllocator : public IAllocator
+    {
+    public:
+
+        /** Default number of bytes, committed at once */
+        static const uint32 DEFAULT_COMMIT_SIZE = Buffers::KiB * 64;
+
+        /** Commit granularity with transparent huge pages */
+        static const uint32 HUGE_PAGE_SIZE = Buffers::MiB * 2;
+
+        /** Committed memory is released in clear, if peak usage was less than committed / factor */
+        static const uint32 DECOMMIT_FACTOR = 4;
+
+        /** Position in the arena to rewind to */
+        typedef uint64 Marker;
+
+    public:
+
+        /**
+         * Reserves range of virtual memory
+         * @param reserveSize   Max number of bytes, which could be allocated
+         * @param commitSize    Number of bytes to commit at once (rounded up to page size)
+         * @param useHugePages  Set in true to advise transparent huge pages for the range
+         */
+        explicit VirtualArenaAllocator(uint64 reserveSize,
+                                       uint32 commitSize = DEFAULT_COMMIT_SIZE,
+                                       bool useHugePages = false);
+
+        ~VirtualArenaAllocator() override;
+
+        GEN_NEW_DELETE(VirtualArenaAllocator);
+
+        /**
+         * Allocates block after the previous one (commits pages if needed)
+         * @warning Fails if reserved range is exhausted
+         *
+         * @param size Chunk to be allocated
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size) override;
+
+        /**
+         * Allocates block with address, multiple of alignment
+         *
+         * @param size      Chunk to be allocated
+         * @param alignment Power of 2 alignment of returned pointer
+         * @return Pointer to the memory
+         */
+        void* allocate(uint32 size, uint32 alignment) override;
+
+        /** Memory is freed only via clear() or rewind() */
+        void free(void*) override { mFreeCalls += 1; }
+
+        /**
+         * Marks all the allocated memory as free. Decommits pages above
+         * peak usage of this cycle if it was low
+         *
+         * @warning All the allocated data will be lost
+         */
+        void clear();
+
+        /** @return Marker of current position to rewind to */
+        Marker getMarker() const { return mUsage; }
+
+        /**
+         * Frees all the blocks, allocated after marker (pages stay committed)
+         * @warning Fails if marker is after current position
+         */
+        void rewind(Marker marker);
+
+        /** Returns all the committed pages to the system (arena must be empty) */
+        void decommit();
+
+        /** @return Currently allocated bytes */
+        uint64 getUsage() const { return mUsage; }
+
+        /** @return Max usage since the last clear */
+        uint64 getPeakUsage() const { return mPeakUsage; }
+
+        /** @return Committed bytes (resident memory at most) */
+        uint64 getCommittedSize() const { return mCommitted; }
+
+        /** @return Reserved bytes */
+        uint64 getReservedSize() const { return mReserved; }
+
+        /** @return True if transparent huge pages were advised */
+        bool usesHugePages() const { return mUsesHugePages; }
+
+    private:
+
+        /** Commits pages to cover first size bytes of range */
+        void commit(uint64 size);
+
+        /** Returns pages from offset up to committed boundary to the system */
+        void decommit(uint64 offset);
+
+        /** @return System page size */
+        static uint32 getPageSize();
+
+#if PROFILE_VIRTUAL_ARENA_ALLOCATOR
+        void profile(const char* msg) const;
+#endif
+
+    private:
+
+        uint8* mRegion;             // Reserved range (aligned on commit size)
+        void*  mMapping;            // Start of mapping (for release)
+        uint64 mMappingSize;        // Size of mapping
+        uint64 mReserved;           // Usable size of reserved range
+        uint64 mCommitted;          // Committed bytes from the range start
+        uint64 mUsage;              // Currently allocated bytes
+        uint64 mPeakUsage;          // Max usage since the last clear
+        uint32 mCommitSize;         // Granularity of commit
+        bool   mUsesHugePages;      // Range is advised to be backed by huge pages
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_VIRTUALARENAALLOCATOR_H
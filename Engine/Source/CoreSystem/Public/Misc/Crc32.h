@@ -13,6 +13,14 @@ namespace Berserk
 
     /**
       * CRC hash generation for different types of input data
+      *
+      * Default hash functions compute CRC-32 (IEEE polynomial, compatible
+      * with zlib and previous engine versions) via slicing-by-8 tables
+      * (8 bytes per step instead of one).
+      *
+      * CRC-32C (Castagnoli polynomial) uses SSE 4.2 crc32 instruction, if it is
+      * supported by CPU (detected at runtime), or slicing-by-8 tables otherwise.
+      * Prefer it for new runtime-only hashing: values differ from CRC-32.
       */
     class CORE_API Crc32
     {
@@ -62,6 +70,28 @@ namespace Berserk
          */
         static uint32 hash(const char* buffer, uint32 len);
 
+        /**
+         * CRC-32C hash function for bytes buffer (hardware if supported)
+         *
+         * @param buffer Pointer to buffer
+         * @param len Number of bytes
+         * @return uint32 hash
+         */
+        static uint32 hashCastagnoli(const void* buffer, uint32 len);
+
+        /**
+         * CRC-32C hash function for bytes buffer (software slicing-by-8 only,
+         * for verification and benchmarks)
+         *
+         * @param buffer Pointer to buffer
+         * @param len Number of bytes
+         * @return uint32 hash
+         */
+        static uint32 hashCastagnoliSoftware(const void* buffer, uint32 len);
+
+        /** @return True if CRC-32C is computed by CPU instruction */
+        static bool isHardwareCastagnoli();
+
     };
 }
 
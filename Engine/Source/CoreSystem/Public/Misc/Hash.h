@@ -0,0 +1,143 @@
+//
+// Created by Egor Orachyov on 01.03.2019.
+//
+
+#ifndef BERSERK_HASH_H
+#define BERSERK_HASH_H
+
+#include "Misc/Types.h"
+#include "Misc/Inline.h"
+#include "Misc/UsageDescriptors.h"
+
+namespace Berserk
+{
+
+    /**
+     * Fast non-cryptographic hash functions for hash tables:
+     * wyhash-style hashing of bytes (8-16 bytes per multiply step instead
+     * of byte-at-a-time table lookups of Crc32) and integer mixers for ids.
+     *
+     * @note Values are not stable between engine versions:
+     *       do not store them in files (use Crc32 for that)
+     */
+    class CORE_API Hash
+    {
+    public:
+
+        /** Default seed of bytes hashing */
+        static const uint64 DEFAULT_SEED = 0;
+
+        /**
+         * 64-bit hash of bytes (wyhash algorithm)
+         * @param data   Pointer to the bytes
+         * @param length Number of bytes
+         * @param seed   Seed of hashing
+         * @return uint64 hash
+         */
+        static uint64 hash64(const void* data, uint64 length, uint64 seed = DEFAULT_SEED);
+
+        /**
+         * 32-bit hash of bytes (folded 64-bit hash)
+         * @param data   Pointer to the bytes
+         * @param length Number of bytes
+         * @return uint32 hash
+         */
+        static uint32 hash(const void* data, uint32 length)
+        {
+            uint64 h = hash64(data, length);
+            return (uint32)(h ^ (h >> 32));
+        }
+
+        /** @return Mixed bits of 32-bit integer (bijective, all bits affect each other) */
+        static FORCEINLINE uint32 mix(uint32 value)
+        {
+            value ^= value >> 16;
+            value *= 0x7feb352du;
+            value ^= value >> 15;
+            value *= 0x846ca68bu;
+            value ^= value >> 16;
+            return value;
+        }
+
+        /** @return Mixed bits of 64-bit integer (splitmix64 finalizer, bijective) */
+        static FORCEINLINE uint64 mix(uint64 value)
+        {
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ull;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebull;
+            value ^= value >> 31;
+            return value;
+        }
+
+        /** @return 32-bit hash of 64-bit integer */
+        static FORCEINLINE uint32 mix32(uint64 value)
+        {
+            value = mix(value);
+            return (uint32)(value ^ (value >> 32));
+        }
+
+    };
+
+    /**
+     * Hashing of key type for hash tables. Default version hashes bytes
+     * of the key value, therefore it is valid only for types without
+     * padding and pointers to data (specialize for others).
+     *
+     * @tparam T Type of the key
+     */
+    template <typename T>
+    struct HashTraits
+    {
+        static uint32 hash(const T& key) { return Hash::hash(&key, sizeof(T)); }
+
+        /** Hashing method of the key by pointer (compatible with Crc32::Hashing) */
+        static uint32 hashing(const void* key) { return hash(*(const T*)key); }
+    };
+
+    /** Integer keys (ids, handles, indices) are mixed without bytes hashing */
+    #define HASH_TRAITS_INTEGER(type)                                               \
+        template <>                                                                 \
+        struct HashTraits<type>                                                     \
+        {                                                                           \
+            static uint32 hash(type key) { return Hash::mix32((uint64)key); }       \
+            static uint32 hashing(const void* key) { return hash(*(const type*)key); } \
+        };
+
+    HASH_TRAITS_INTEGER(int8)
+    HASH_TRAITS_INTEGER(int16)
+    HASH_TRAITS_INTEGER(int32)
+    HASH_TRAITS_INTEGER(int64)
+    HASH_TRAITS_INTEGER(uint8)
+    HASH_TRAITS_INTEGER(uint16)
+    HASH_TRAITS_INTEGER(uint32)
+    HASH_TRAITS_INTEGER(uint64)
+
+    #undef HASH_TRAITS_INTEGER
+
+    /** Pointers are hashed by address */
+    template <typename T>
+    struct HashTraits<T*>
+    {
+        static uint32 hash(T* key) { return Hash::mix32((uint64)key); }
+        static uint32 hashing(const void* key) { return hash(*(T* const*)key); }
+    };
+
+    /** Floats are hashed by value (+0 and -0 are the same key) */
+    template <>
+    struct HashTraits<float32>
+    {
+        static uint32 hash(float32 key) { return (key == 0.0f ? 0 : Hash::hash(&key, sizeof(float32))); }
+        static uint32 hashing(const void* key) { return hash(*(const float32*)key); }
+    };
+
+    template <>
+    struct HashTraits<float64>
+    {
+        static uint32 hash(float64 key) { return (key == 0.0 ? 0 : Hash::hash(&key, sizeof(float64))); }
+        static uint32 hashing(const void* key) { return hash(*(const float64*)key); }
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_HASH_H
@@ -0,0 +1,61 @@
+//
+// Created by Egor Orachyov on 02.03.2019.
+//
+
+#ifndef BERSERK_RELOCATION_H
+#define BERSERK_RELOCATION_H
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "Misc/Types.h"
+#include "Misc/Include.h"
+
+namespace Berserk
+{
+
+    /**
+     * True if object of type T could be moved in other memory with memcpy
+     * (old copy is not destroyed after that). Default is trivially copyable
+     * types, specialize for classes without self-references (strings, handles).
+     *
+     * @tparam T Type of object
+     */
+    template <typename T>
+    struct IsTriviallyRelocatable
+    {
+        static const bool value = std::is_trivially_copyable<T>::value;
+    };
+
+    /** Relocation via memcpy (source objects are not destroyed) */
+    template <typename T>
+    void relocate(T* destination, T* source, uint32 count, std::true_type)
+    {
+        memcpy((void*)destination, (const void*)source, count * sizeof(T));
+    }
+
+    /** Relocation via move construction and destruction of source objects */
+    template <typename T>
+    void relocate(T* destination, T* source, uint32 count, std::false_type)
+    {
+        for (uint32 i = 0; i < count; i++)
+        {
+            new (&destination[i]) T(std::move(source[i]));
+            source[i].~T();
+        }
+    }
+
+    /**
+     * Moves count objects from source to destination memory (which do not overlap):
+     * memcpy for trivially relocatable types, otherwise move construction and
+     * destruction of source objects
+     */
+    template <typename T>
+    void relocate(T* destination, T* source, uint32 count)
+    {
+        relocate(destination, source, count, std::integral_constant<bool, IsTriviallyRelocatable<T>::value>());
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_RELOCATION_H
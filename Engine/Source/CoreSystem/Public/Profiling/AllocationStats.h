@@ -0,0 +1,205 @@
+//
+// Created by Egor Orachyov on 27.02.2019.
+//
+
+#ifndef BERSERK_ALLOCATIONSTATS_H
+#define BERSERK_ALLOCATIONSTATS_H
+
+#include <mutex>
+#include <atomic>
+#include <cstdio>
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Allocation Stats
+     *
+     * Runtime allocation instrumentation, available in any build. Statistics are
+     * gathered per channel: named allocator (or group of allocators with the same
+     * name) or tag (subsystem, which makes allocations, marked by TagScope).
+     *
+     * For each channel: allocate / free calls, allocated / freed bytes, histogram
+     * of sizes (power of 2 bins), live bytes and its high-water mark. Free is
+     * attributed to the tag of allocation, if allocator stores it in the block
+     * header (general Allocator), otherwise to the current tag of the thread.
+     *
+     * Counters are kept in per-thread shards (single writer, no atomic RMW on the
+     * hot path). Live bytes of thread are flushed in global channel counter in
+     * portions of FLUSH_BYTES, therefore high-water mark is exact up to
+     * threads count * FLUSH_BYTES.
+     *
+     * Could be disabled / enabled at runtime (enabled by default).
+     */
+    class CORE_API AllocationStats
+    {
+    public:
+
+        /** Max number of registered allocators and tags */
+        static const uint32 MAX_CHANNELS_COUNT = Buffers::SIZE_64;
+
+        /** Max length of channel name (with null-terminator) */
+        static const uint32 MAX_NAME_LENGTH = Buffers::SIZE_32;
+
+        /** Bins of sizes [2^i, 2^(i+1)), the last bin contains all bigger sizes */
+        static const uint32 HISTOGRAM_BINS = 24;
+
+        /** Thread flushes its live bytes delta when it becomes bigger than this */
+        static const int64 FLUSH_BYTES = Buffers::KiB * 64;
+
+        /** Marks untracked allocator */
+        static const uint32 NO_CHANNEL = 0xffffffff;
+
+        /** Marks free attributed to the current tag of the thread */
+        static const uint32 CURRENT_TAG = 0xfffffffe;
+
+        /** Statistics of one channel */
+        struct ChannelStats
+        {
+            const char* name;                   // Name of allocator or tag
+            bool   isTag;                       // Channel is tag (subsystem)
+            uint64 allocCalls;                  // Total allocate calls
+            uint64 freeCalls;                   // Total free calls
+            uint64 allocBytes;                  // Total allocated bytes
+            uint64 freeBytes;                   // Total freed bytes
+            int64  liveBytes;                   // Currently allocated bytes
+            int64  peakBytes;                   // High-water mark of allocated bytes
+            uint64 histogram[HISTOGRAM_BINS];   // Allocate calls per size bin
+        };
+
+        /** Statistics of all the channels at some moment */
+        struct Snapshot
+        {
+            uint32 channelsCount;
+            uint32 threadsCount;
+            ChannelStats channels[MAX_CHANNELS_COUNT];
+        };
+
+        /** Attributes allocations of the calling thread to the tag while alive */
+        class CORE_API TagScope
+        {
+        public:
+
+            explicit TagScope(uint32 tag) : mPrevious(THREAD_TAG) { THREAD_TAG = tag; }
+
+            explicit TagScope(const char* name) : TagScope(getTag(name)) { }
+
+            ~TagScope() { THREAD_TAG = mPrevious; }
+
+        private:
+
+            uint32 mPrevious;
+
+        };
+
+    private:
+
+        struct ShardChannel
+        {
+            std::atomic<uint64> allocCalls;
+            std::atomic<uint64> freeCalls;
+            std::atomic<uint64> allocBytes;
+            std::atomic<uint64> freeBytes;
+            std::atomic<int64>  pending;                    // Not flushed live bytes delta
+            std::atomic<uint32> histogram[HISTOGRAM_BINS];
+        };
+
+        struct Shard
+        {
+            Shard* next;                                    // Next shard in the list of all
+            bool   used;                                    // Shard is owned by thread
+            ShardChannel channels[MAX_CHANNELS_COUNT];
+        };
+
+        struct Channel
+        {
+            char name[MAX_NAME_LENGTH];
+            bool isTag;
+            std::atomic<int64> live;                        // Flushed live bytes of all threads
+            std::atomic<int64> peak;                        // Max of flushed live bytes
+        };
+
+        struct ShardHolder
+        {
+            ~ShardHolder();
+        };
+
+    public:
+
+        /**
+         * @return Channel for allocators with name (registers on the first call)
+         * @warning Returns NO_CHANNEL if all channels are used
+         */
+        static uint32 getChannel(const char* name);
+
+        /** @return Channel of tag with name (registers on the first call) */
+        static uint32 getTag(const char* name);
+
+        /** Enables or disables gathering (counters are not reset) */
+        static void setEnabled(bool enabled) { ENABLED.store(enabled, std::memory_order_relaxed); }
+
+        /** @return True if stats are gathered */
+        static bool isEnabled() { return ENABLED.load(std::memory_order_relaxed); }
+
+        /** Registers allocate of size bytes in channel and in the current tag of thread */
+        static void onAllocate(uint32 channel, uint64 size)
+        {
+            if (channel == NO_CHANNEL || !isEnabled()) return;
+            registerAllocate(channel, size);
+        }
+
+        /** Registers free of size bytes in channel and in the tag of allocation */
+        static void onFree(uint32 channel, uint64 size, uint32 tag = CURRENT_TAG)
+        {
+            if (channel == NO_CHANNEL || !isEnabled()) return;
+            registerFree(channel, size, (tag == CURRENT_TAG ? THREAD_TAG : tag));
+        }
+
+        /** @return Current tag of the calling thread (NO_CHANNEL if not in tag scope) */
+        static uint32 getThreadTag() { return THREAD_TAG; }
+
+        /** Gathers counters of all threads (could be called from any thread) */
+        static void snapshot(Snapshot& snapshot);
+
+        /** Writes snapshot in the file as JSON document */
+        static void exportJson(const Snapshot& snapshot, FILE* file);
+
+        /** @return Size bin of allocation */
+        static uint32 getBin(uint64 size);
+
+    private:
+
+        static void registerAllocate(uint32 channel, uint64 size);
+
+        static void registerFree(uint32 channel, uint64 size, uint32 tag);
+
+        static uint32 registerChannel(const char* name, bool isTag);
+
+        /** Moves thread live bytes delta in the global channel counter */
+        static void flush(uint32 channel, ShardChannel& data);
+
+        /** @return Shard of the calling thread (acquires on the first call) */
+        static Shard* getShard();
+
+    private:
+
+        static std::atomic<bool> ENABLED;
+        static std::atomic<uint32> CHANNELS_COUNT;
+        static std::atomic<Shard*> SHARDS;
+        static std::mutex MUTEX;                            // Guards channels registration and shards acquire
+        static std::mutex OVERFLOW_MUTEX;                   // Guards shard of exited threads
+        static Channel CHANNELS[MAX_CHANNELS_COUNT];
+        static Shard OVERFLOW_SHARD;                        // Shared by threads after their shard release
+        static thread_local Shard* THREAD_SHARD;
+        static thread_local bool THREAD_SHARD_RELEASED;
+        static thread_local uint32 THREAD_TAG;
+        static thread_local ShardHolder THREAD_SHARD_HOLDER;
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_ALLOCATIONSTATS_H
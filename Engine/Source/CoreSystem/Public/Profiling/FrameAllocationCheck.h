@@ -0,0 +1,129 @@
+//
+// Created by Egor Orachyov on 27.02.2019.
+//
+
+#ifndef BERSERK_FRAMEALLOCATIONCHECK_H
+#define BERSERK_FRAMEALLOCATIONCHECK_H
+
+#include <mutex>
+#include <atomic>
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+
+namespace Berserk
+{
+
+    /**
+     * @brief Frame Allocation Check
+     *
+     * Verification mode for steady-state frames: counts calls of general
+     * Allocator::allocate between beginFrame() and endFrame() (made by all
+     * the threads) and captures their call sites (backtraces). After warm-up
+     * frames each frame, which allocated memory, is reported with per call site
+     * counts, or the engine fails, if assert mode is chosen.
+     *
+     * Disabled by default, costs one relaxed atomic load per allocation
+     * while frame is not checked.
+     *
+     * @note Only the general heap is checked: frame, stack and pool
+     *       allocators are expected to be used inside frame
+     */
+    class CORE_API FrameAllocationCheck
+    {
+    public:
+
+        /** Max number of distinct call sites in one frame (others are counted together) */
+        static const uint32 MAX_CALL_SITES = Buffers::SIZE_64;
+
+        /** Max number of captured stack frames of call site */
+        static const uint32 MAX_STACK_DEPTH = 16;
+
+        /**
+         * Stack frames of check itself, which are not captured
+         * (the next ones are Allocator::allocate frames and the caller)
+         */
+        static const uint32 SKIPPED_STACK_FRAMES = 1;
+
+        /** Frames after start, which are allowed to allocate (caches and pools are filled) */
+        static const uint32 DEFAULT_WARM_UP_FRAMES = 8;
+
+        /** Allocations, made from one place */
+        struct CallSite
+        {
+            void*  stack[MAX_STACK_DEPTH];  // Return addresses (from allocator to the callers)
+            uint32 depth;                   // Number of captured addresses
+            uint32 count;                   // Number of allocate calls in frame
+            uint64 bytes;                   // Number of allocated bytes in frame
+        };
+
+    public:
+
+        /**
+         * Starts checking of frames
+         * @param warmUpFrames Number of frames, which are not checked
+         * @param failOnAllocation True to fail the engine on the first allocating frame
+         */
+        static void enable(uint32 warmUpFrames = DEFAULT_WARM_UP_FRAMES, bool failOnAllocation = false);
+
+        /** Stops checking of frames */
+        static void disable();
+
+        /** Marks start of the frame (allocations are recorded after warm-up) */
+        static void beginFrame();
+
+        /** Marks end of the frame and reports its allocations */
+        static void endFrame();
+
+        /** Records allocation of size bytes, if frame is checked (called by Allocator) */
+        static void onAllocate(uint64 size)
+        {
+            if (RECORDING.load(std::memory_order_relaxed)) record(size);
+        }
+
+        /** @return True if frames are checked */
+        static bool isEnabled();
+
+        /** @return Number of allocations in the last checked frame */
+        static uint32 getLastFrameAllocations();
+
+        /** @return Number of checked frames, which allocated memory */
+        static uint32 getAllocatingFramesCount();
+
+        /** @return Number of checked frames */
+        static uint32 getCheckedFramesCount();
+
+    private:
+
+        /** Saves call site of allocation */
+        static void record(uint64 size);
+
+        /** Prints allocations of the frame in log */
+        static void report();
+
+    private:
+
+        static std::atomic<bool> RECORDING;                 // Allocations are recorded now
+        static std::mutex MUTEX;                            // Guards call sites and frame counters
+
+        static bool ENABLED;                                // Frames are checked
+        static bool FAIL_ON_ALLOCATION;                     // Allocating frame fails the engine
+        static uint32 WARM_UP_FRAMES;                       // Number of frames, which are not checked
+        static uint32 FRAMES_COUNT;                         // Number of frames since enable
+
+        static CallSite CALL_SITES[MAX_CALL_SITES];         // Call sites of the current frame
+        static uint32 CALL_SITES_COUNT;
+        static uint32 OTHER_COUNT;                          // Allocations, which did not fit in call sites table
+        static uint64 OTHER_BYTES;
+
+        static uint32 LAST_FRAME_ALLOCATIONS;
+        static uint32 ALLOCATING_FRAMES_COUNT;
+        static uint32 CHECKED_FRAMES_COUNT;
+
+        static thread_local bool THREAD_RECORDING;          // Guards from recursive record in the same thread
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_FRAMEALLOCATIONCHECK_H
@@ -25,6 +25,34 @@
     #define PROFILE_LIST_ALLOCATOR 0
 #endif // PROFILE_LIST_ALLOCATOR
 
+#ifndef PROFILE_TLSF_ALLOCATOR
+    #define PROFILE_TLSF_ALLOCATOR 0
+#endif // PROFILE_TLSF_ALLOCATOR
+
+#ifndef PROFILE_SMALL_OBJECT_ALLOCATOR
+    #define PROFILE_SMALL_OBJECT_ALLOCATOR 0
+#endif // PROFILE_SMALL_OBJECT_ALLOCATOR
+
+#ifndef PROFILE_VIRTUAL_ARENA_ALLOCATOR
+    #define PROFILE_VIRTUAL_ARENA_ALLOCATOR 0
+#endif // PROFILE_VIRTUAL_ARENA_ALLOCATOR
+
+#ifndef PROFILE_FRAME_ALLOCATOR
+    #define PROFILE_FRAME_ALLOCATOR 0
+#endif // PROFILE_FRAME_ALLOCATOR
+
+#ifndef PROFILE_PROXY_ALLOCATOR
+    #define PROFILE_PROXY_ALLOCATOR 0
+#endif // PROFILE_PROXY_ALLOCATOR
+
+#ifndef PROFILE_TAGGED_HEAP
+    #define PROFILE_TAGGED_HEAP 0
+#endif // PROFILE_TAGGED_HEAP
+
+#ifndef PROFILE_RELOCATABLE_HEAP
+    #define PROFILE_RELOCATABLE_HEAP 0
+#endif // PROFILE_RELOCATABLE_HEAP
+
 #ifndef PROFILE_LINKED_LIST
     #define PROFILE_LINKED_LIST 0
 #endif // PROFILE_LINKED_LIST
@@ -37,4 +65,9 @@
     #define PROFILE_HASH_MAP 0
 #endif // PROFILE_HASH_MAP
 
+/** Frame allocation check of rendering system: 0 - off, 1 - report allocating frames, 2 - fail on allocating frame */
+#ifndef CHECK_FRAME_ALLOCATIONS
+    #define CHECK_FRAME_ALLOCATIONS 0
+#endif // CHECK_FRAME_ALLOCATIONS
+
 #endif //BERSERK_PROFILINGMACRO_H
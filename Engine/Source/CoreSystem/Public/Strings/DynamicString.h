@@ -5,7 +5,9 @@
 #ifndef BERSERK_DYNAMICSTRING_H
 #define BERSERK_DYNAMICSTRING_H
 
+#include <Misc/Hash.h>
 #include <Misc/Assert.h>
+#include <Misc/Relocation.h>
 #include <Object/NewDelete.h>
 #include <Logging/LogMacros.h>
 #include <Strings/StringPool.h>
@@ -327,6 +329,21 @@ namespace Berserk
         return StringPool::MAX_BUFFER_SIZE / sizeof(T);
     }
 
+    /** Dynamic strings only point to the pool node (relocation does not change references) */
+    template <typename T, T end>
+    struct IsTriviallyRelocatable<DynamicString<T,end>>
+    {
+        static const bool value = true;
+    };
+
+    /** Dynamic strings are hashed by content (null string has zero hash) */
+    template <typename T, T end>
+    struct HashTraits<DynamicString<T,end>>
+    {
+        static uint32 hash(const DynamicString<T,end>& key) { return (key.get() ? Hash::hash(key.get(), key.length() * sizeof(T)) : 0); }
+        static uint32 hashing(const void* key) { return hash(*(const DynamicString<T,end>*)key); }
+    };
+
     } // namespace Berserk
 
 #endif //BERSERK_DYNAMICSTRING_H
\ No newline at end of file
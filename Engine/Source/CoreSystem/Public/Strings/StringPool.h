@@ -5,7 +5,7 @@
 #ifndef BERSERK_STRINGPOOL_H
 #define BERSERK_STRINGPOOL_H
 
-#include "Memory/PoolAllocator.h"
+#include "Memory/ConcurrentPoolAllocator.h"
 
 namespace Berserk
 {
@@ -77,7 +77,7 @@ namespace Berserk
         static const uint16 POOL_STRING_SIZES[Supported];
 
         PoolNode mCreateNode;                           //
-        PoolAllocator mPool[StringSizes::Supported];    //
+        ConcurrentPoolAllocator mPool[StringSizes::Supported];    // Pools are shared by all threads
 
     };
 
@@ -5,7 +5,9 @@
 #ifndef BERSERK_STRINGSTREAM_H
 #define BERSERK_STRINGSTREAM_H
 
+#include "Misc/Hash.h"
 #include "Misc/Crc32.h"
+#include "Misc/Relocation.h"
 #include "Strings/StringUtility.h"
 
 namespace Berserk
@@ -209,6 +211,21 @@ namespace Berserk
         return mBuffer;
     }
 
+    /** Static strings have no pointers on itself */
+    template <typename T, T end, uint32 size>
+    struct IsTriviallyRelocatable<StringStream<T,end,size>>
+    {
+        static const bool value = true;
+    };
+
+    /** Static strings are hashed by content */
+    template <typename T, T end, uint32 size>
+    struct HashTraits<StringStream<T,end,size>>
+    {
+        static uint32 hash(const StringStream<T,end,size>& key) { return Hash::hash(key.get(), key.length() * sizeof(T)); }
+        static uint32 hashing(const void* key) { return hash(*(const StringStream<T,end,size>*)key); }
+    };
+
 } // namespace Berserk
 
 #endif //BERSERK_STRINGSTREAM_H
@@ -0,0 +1,301 @@
+//
+// Created by Egor Orachyov on 07.03.2019.
+//
+
+#ifndef BERSERK_CONCURRENTHASHMAP_H
+#define BERSERK_CONCURRENTHASHMAP_H
+
+#include <new>
+#include <mutex>
+#include <condition_variable>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "Containers/OpenHashMap.h"
+#include "Containers/AlignedArray.h"
+
+namespace Berserk
+{
+
+    /**
+     * Thread-safe hash map with lock striping: keys are split in shards by
+     * hash, each shard is OpenHashMap with its own mutex, therefore threads
+     * working with different keys rarely wait each other.
+     *
+     * getOrInsert creates value of missing key exactly once: key is placed
+     * in the map as pending, factory is invoked without lock, other threads
+     * requested the same key wait for the factory result (threads working
+     * with other keys of the shard are not blocked by the factory).
+     *
+     * Value V() means 'no value': factory returns it on failure (pending key
+     * is removed and the next request invokes factory again).
+     *
+     * @note Functions passed to the map are invoked under the shard lock
+     *       (except factory) and must not access the map
+     *
+     * @tparam K Type of key (must have HashTraits and be comparable via ==)
+     * @tparam V Type of value (cheap to copy, e.g. pointer)
+     * @tparam SHARDS_COUNT Number of shards (power of 2)
+     */
+    template <typename K, typename V, uint32 SHARDS_COUNT = 16>
+    class ConcurrentHashMap
+    {
+    public:
+
+        static_assert((SHARDS_COUNT & (SHARDS_COUNT - 1)) == 0, "Shards count must be power of 2");
+
+        /** Default number of slots in one shard */
+        static const uint32 DEFAULT_SHARD_CAPACITY = 16;
+
+    public:
+
+        /**
+         * @param shardCapacity Initial number of slots in each shard
+         * @param allocator     Allocator for shards' nodes [or nullptr for default]
+         */
+        explicit ConcurrentHashMap(uint32 shardCapacity = DEFAULT_SHARD_CAPACITY, IAllocator* allocator = nullptr);
+
+        ConcurrentHashMap(const ConcurrentHashMap& other) = delete;
+
+        ConcurrentHashMap& operator = (const ConcurrentHashMap& other) = delete;
+
+        ~ConcurrentHashMap();
+
+        GEN_NEW_DELETE(ConcurrentHashMap);
+
+        /**
+         * Returns value of the key or creates it via factory (once for
+         * all the concurrent requests of the same key)
+         * @param key     Key of the element
+         * @param factory Function V() invoked without lock if key is missing
+         * @param acquire Function void(V&) invoked under lock if value already
+         *                exists (or created by other thread)
+         * @return Value of the key [or V() if factory failed]
+         */
+        template <typename Factory, typename Acquire>
+        V getOrInsert(const K& key, Factory factory, Acquire acquire);
+
+        /** @copydoc getOrInsert() */
+        template <typename Factory>
+        V getOrInsert(const K& key, Factory factory) { return getOrInsert(key, factory, [](V&){}); }
+
+        /**
+         * Finds value of the key (pending values are not found)
+         * @param      key     Key of the element
+         * @param[out] value   Value of the element (if found)
+         * @param      acquire Function void(V&) invoked under lock for found value
+         * @return True if value is found
+         */
+        template <typename Acquire>
+        bool find(const K& key, V& value, Acquire acquire);
+
+        /** @copydoc find() */
+        bool find(const K& key, V& value) { return find(key, value, [](V&){}); }
+
+        /** Adds element if key is missing @return False if key already exists */
+        bool add(const K& key, const V& value);
+
+        /** Removes element with key (pending elements are not removed) @return True if removed */
+        bool remove(const K& key) { return removeIf(key, [](V&){ return true; }); }
+
+        /**
+         * Removes element with key if predicate returns true
+         * @param key       Key of the element
+         * @param predicate Function bool(V&) invoked under lock for found value
+         * @return True if removed
+         */
+        template <typename Predicate>
+        bool removeIf(const K& key, Predicate predicate);
+
+        /** Invokes function void(const K&, V&) for each not pending element (locks shards one by one) */
+        template <typename Function>
+        void forEach(Function function);
+
+        /** @return Number of elements (including pending, exact if there are no concurrent operations) */
+        uint32 getSize();
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage();
+
+    private:
+
+        struct Entry
+        {
+            V value;
+            bool pending;
+        };
+
+        /** Shards do not share cache lines (mutexes are written on each operation) */
+        struct Shard
+        {
+            Shard(uint32 capacity, IAllocator* allocator) : map(nullptr, capacity, allocator) {}
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            OpenHashMap<K, Entry> map;
+            uint8 padding[CACHE_LINE_SIZE];
+        };
+
+        /** @return Shard of the key (low bits of hash, open hash map uses high ones for slots) */
+        Shard& getShard(const K& key) { return getShard(HashTraits<K>::hash(key) & (SHARDS_COUNT - 1)); }
+
+        Shard& getShard(uint32 index) { return ((Shard*) mShards)[index]; }
+
+    private:
+
+        alignas(Shard) uint8 mShards[sizeof(Shard) * SHARDS_COUNT];
+
+    };
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    ConcurrentHashMap<K,V,SHARDS_COUNT>::ConcurrentHashMap(uint32 shardCapacity, IAllocator *allocator)
+    {
+        for (uint32 i = 0; i < SHARDS_COUNT; i++)
+        {
+            new (&getShard(i)) Shard(shardCapacity, allocator);
+        }
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    ConcurrentHashMap<K,V,SHARDS_COUNT>::~ConcurrentHashMap()
+    {
+        for (uint32 i = 0; i < SHARDS_COUNT; i++)
+        {
+            getShard(i).~Shard();
+        }
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    template <typename Factory, typename Acquire>
+    V ConcurrentHashMap<K,V,SHARDS_COUNT>::getOrInsert(const K &key, Factory factory, Acquire acquire)
+    {
+        Shard& shard = getShard(key);
+        std::unique_lock<std::mutex> lock(shard.mutex);
+
+        while (true)
+        {
+            Entry* entry = shard.map[key];
+
+            if (entry == nullptr) break;
+
+            if (!entry->pending)
+            {
+                acquire(entry->value);
+                return entry->value;
+            }
+
+            // Entry pointer is not kept: shard could be rehashed while waiting
+
+            shard.condition.wait(lock);
+        }
+
+        Entry pending = { V(), true };
+        shard.map.add(key, pending);
+        lock.unlock();
+
+        V value = factory();
+
+        lock.lock();
+
+        if (value == V()) shard.map.remove(key);
+        else *shard.map[key] = { value, false };
+
+        lock.unlock();
+        shard.condition.notify_all();
+
+        return value;
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    template <typename Acquire>
+    bool ConcurrentHashMap<K,V,SHARDS_COUNT>::find(const K &key, V &value, Acquire acquire)
+    {
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+
+        Entry* entry = shard.map[key];
+        if (entry == nullptr || entry->pending) return false;
+
+        acquire(entry->value);
+        value = entry->value;
+        return true;
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    bool ConcurrentHashMap<K,V,SHARDS_COUNT>::add(const K &key, const V &value)
+    {
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+
+        if (shard.map.contains(key)) return false;
+
+        Entry entry = { value, false };
+        shard.map.add(key, entry);
+        return true;
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    template <typename Predicate>
+    bool ConcurrentHashMap<K,V,SHARDS_COUNT>::removeIf(const K &key, Predicate predicate)
+    {
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+
+        Entry* entry = shard.map[key];
+        if (entry == nullptr || entry->pending) return false;
+        if (!predicate(entry->value)) return false;
+
+        shard.map.remove(key);
+        return true;
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    template <typename Function>
+    void ConcurrentHashMap<K,V,SHARDS_COUNT>::forEach(Function function)
+    {
+        for (uint32 i = 0; i < SHARDS_COUNT; i++)
+        {
+            Shard& shard = getShard(i);
+            std::lock_guard<std::mutex> guard(shard.mutex);
+
+            for (auto node = shard.map.iterate(); node != nullptr; node = shard.map.next())
+            {
+                if (!node->value().pending) function(node->key(), node->value().value);
+            }
+        }
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    uint32 ConcurrentHashMap<K,V,SHARDS_COUNT>::getSize()
+    {
+        uint32 size = 0;
+
+        for (uint32 i = 0; i < SHARDS_COUNT; i++)
+        {
+            Shard& shard = getShard(i);
+            std::lock_guard<std::mutex> guard(shard.mutex);
+            size += shard.map.getSize();
+        }
+
+        return size;
+    }
+
+    template <typename K, typename V, uint32 SHARDS_COUNT>
+    uint32 ConcurrentHashMap<K,V,SHARDS_COUNT>::getMemoryUsage()
+    {
+        uint32 usage = sizeof(ConcurrentHashMap);
+
+        for (uint32 i = 0; i < SHARDS_COUNT; i++)
+        {
+            Shard& shard = getShard(i);
+            std::lock_guard<std::mutex> guard(shard.mutex);
+            usage += shard.map.getMemoryUsage() - (uint32) sizeof(OpenHashMap<K, Entry>);
+        }
+
+        return usage;
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_CONCURRENTHASHMAP_H
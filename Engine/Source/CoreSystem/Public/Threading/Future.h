@@ -5,42 +5,144 @@
 #ifndef BERSERK_FUTURE_H
 #define BERSERK_FUTURE_H
 
-#include "IRunnable.h"
+#include <atomic>
+#include "Misc/Types.h"
+#include "Misc/UsageDescriptors.h"
+#include "Threading/IRunnable.h"
 
 namespace Berserk
 {
 
+    class ThreadPool;
+
     /**
-     * Allows to know whether submitted runnable was finished and get
-     * pointer to this runnable
+     * Allows to know whether submitted runnable was finished, get
+     * pointer to this runnable and block until it is finished.
+     *
+     * Result and side effects of runnable are published with release
+     * order: they are visible after done() returned true (or wait).
+     * Waiting threads are parked (do not spin).
+     *
+     * Continuations (then) are stored in the continuation futures
+     * themselves: future does not allocate memory.
+     *
+     * Groups (whenAll, whenAny) complete result future, when all (any)
+     * of the futures are done: continuations of the result are submitted
+     * in the pool, therefore frame code does not block on dependencies.
+     *
+     * @warning Do not wait inside tasks of the pool (worker is blocked):
+     *          use continuations instead
      */
-    class Future
+    class CORE_API Future
     {
     public:
 
-        Future() : mDone(false), mResult(0), mRunnable(nullptr) {}
+        Future() : mDone(false), mResult(0), mRunnable(nullptr), mPool(nullptr), mContinuations(nullptr), mNext(nullptr),
+                   mGroup(nullptr), mGroupIndex(0), mRemaining(0), mAny(false), mWinner(NO_INDEX),
+                   mMembers(nullptr), mMembersCount(0) {}
+
+        Future(const Future& other) = delete;
+
+        Future& operator = (const Future& other) = delete;
 
         ~Future() = default;
 
         /** @return True whether the runnable is done */
-        bool done() const { return mDone; }
+        bool done() const { return mDone.load(std::memory_order_acquire); }
 
-        /** @return Exit code of runnable function run */
+        /** @return Exit code of runnable function run (valid when done) */
         int32 result() const { return mResult; }
 
         /** @return Pointer to submitted runnable object */
         IRunnable* runnable() const { return mRunnable; }
 
+        /** Blocks calling thread until the runnable is done */
+        void wait() const;
+
+        /**
+         * Blocks calling thread until the runnable is done or timeout expired
+         * @param seconds Max time to wait
+         * @return True if the runnable is done
+         */
+        bool waitFor(float64 seconds) const;
+
+        /**
+         * Submits runnable in the pool of this future when this future is done
+         * (at once if it is already done)
+         * @param runnable     Continuation task
+         * @param continuation Future of the continuation (stores it until submit)
+         * @warning This future must be submitted in pool before
+         */
+        void then(IRunnable* runnable, Future& continuation);
+
+        /**
+         * Completes result future when all the futures are done
+         * (result is number of futures)
+         * @param futures Futures submitted in pool
+         * @param count   Number of futures
+         * @param result  Future of the group (could be used with then and wait)
+         * @warning Future could be in one group at a time
+         */
+        static void whenAll(Future* futures, uint32 count, Future& result);
+
+        /**
+         * Completes result future when any of the futures is done
+         * (result is index of the first done future). Other futures are
+         * unregistered before result is done, therefore they could be
+         * added to new group and result could be reused or destroyed
+         * @copydetails whenAll()
+         * @warning Futures array must be alive until result is done
+         */
+        static void whenAny(Future* futures, uint32 count, Future& result);
+
+        /** Blocks calling thread until all the futures are done */
+        static void waitAll(const Future* futures, uint32 count);
+
+        /** Blocks calling thread until any of the futures is done @return Index of done future */
+        static uint32 waitAny(const Future* futures, uint32 count);
+
     private:
 
         friend class ThreadPool;
 
-        volatile bool mDone;
+        /** Prepares future for new task of the pool (continuations registered before are kept) */
+        void reset(IRunnable* runnable, ThreadPool* pool);
+
+        /** Publishes result, wakes waiting threads and submits continuations */
+        void complete(int32 result);
+
+        /** Prepares result of the group and registers it in the futures */
+        static void group(Future* futures, uint32 count, Future& result, bool any);
+
+        /** Notifies result of the group, that future with index is done */
+        void signal(uint32 index);
+
+        /** Releases count references of futures to this result (completes it on the last one) */
+        void release(uint32 count);
+
+    private:
+
+        /** Index of the first done future of any-group is not known yet */
+        static const uint32 NO_INDEX = 0xffffffff;
+
+    private:
+
+        std::atomic<bool> mDone;
         int32 mResult;
         IRunnable* mRunnable;
+        ThreadPool* mPool;
+        std::atomic<Future*> mContinuations;    // Stack of continuations [or marker if done]
+        Future* mNext;                          // Next continuation in the stack of other future
+        std::atomic<Future*> mGroup;            // Result of the group of this future [or marker if done]
+        uint32 mGroupIndex;                     // Index of this future in the group
+        std::atomic<uint32> mRemaining;         // Number of futures registered in this group result
+        bool mAny;                              // Group result is completed by the first done future
+        std::atomic<uint32> mWinner;            // Index of the first done future of any-group [or NO_INDEX]
+        Future* mMembers;                       // Futures of this group result
+        uint32 mMembersCount;                   // Number of futures of this group result
 
     };
 
 } // namespace Berserk
 
-#endif //BERSERK_FUTURE_H
\ No newline at end of file
+#endif //BERSERK_FUTURE_H
@@ -0,0 +1,283 @@
+//
+// Created by Egor Orachyov on 05.03.2019.
+//
+
+#ifndef BERSERK_MPMCQUEUE_H
+#define BERSERK_MPMCQUEUE_H
+
+#include <new>
+#include <atomic>
+#include <utility>
+#include "Misc/Types.h"
+#include "Misc/Assert.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/Allocator.h"
+#include "Memory/IAllocator.h"
+#include "Containers/AlignedArray.h"
+
+namespace Berserk
+{
+
+    /**
+     * Bounded lock-free multi-producer multi-consumer queue (D. Vyukov's ring
+     * with per-cell sequence numbers). Push and pop do not allocate memory and
+     * do not block: each operation claims position with one CAS on the tail
+     * (or head) counter and then waits only for its own cell.
+     *
+     * Cell of position pos is ready for push when its sequence is pos and
+     * ready for pop when its sequence is pos + 1. After pop sequence is set
+     * to pos + capacity (cell is free for the next lap).
+     *
+     * @note Push and pop counters are placed in different cache lines
+     * @tparam T Type of elements (moved in and out of the queue)
+     */
+    template <typename T>
+    class MPMCQueue
+    {
+    public:
+
+        /** Default number of elements in the queue */
+        static const uint32 DEFAULT_CAPACITY = 1024;
+
+        /** Min number of elements in the queue */
+        static const uint32 MIN_CAPACITY = 2;
+
+    public:
+
+        /**
+         * Allocates cells of the queue
+         * @param capacity  Max number of elements (rounded up to power of 2)
+         * @param allocator Allocator for cells [or nullptr for default]
+         */
+        explicit MPMCQueue(uint32 capacity = DEFAULT_CAPACITY, IAllocator* allocator = nullptr);
+
+        MPMCQueue(const MPMCQueue& other) = delete;
+
+        MPMCQueue& operator = (const MPMCQueue& other) = delete;
+
+        ~MPMCQueue();
+
+        GEN_NEW_DELETE(MPMCQueue);
+
+        /** Adds element in the end of the queue @return False if the queue is full */
+        bool tryPush(const T& element) { return emplace(element); }
+
+        /** Adds element in the end of the queue via move @return False if the queue is full */
+        bool tryPush(T&& element) { return emplace(std::move(element)); }
+
+        /**
+         * Removes first element of the queue
+         * @param[out] result Moved element (if the queue was not empty)
+         * @return False if the queue is empty
+         */
+        bool tryPop(T& result);
+
+        /**
+         * Adds up to count elements with one claim of positions
+         * (elements of one batch are consecutive in the queue)
+         * @param elements Elements to copy in the queue
+         * @param count    Number of elements
+         * @return Number of pushed elements (from the beginning of elements)
+         */
+        uint32 tryPushBatch(const T* elements, uint32 count);
+
+        /**
+         * Removes up to count elements with one claim of positions
+         * @param[out] results Buffer for count moved elements
+         * @param      count   Max number of elements to pop
+         * @return Number of popped elements
+         */
+        uint32 tryPopBatch(T* results, uint32 count);
+
+        /** @return Approximate number of elements (exact if there are no concurrent operations) */
+        uint32 getSize() const
+        {
+            uint64 head = mHead.load(std::memory_order_acquire);
+            uint64 tail = mTail.load(std::memory_order_acquire);
+            return (uint32)(tail > head ? tail - head : 0);
+        }
+
+        /** @return Max number of elements in the queue */
+        uint32 getCapacity() const { return mCapacity; }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const { return mCapacity * (uint32) sizeof(Cell); }
+
+    private:
+
+        struct Cell
+        {
+            std::atomic<uint64> sequence;
+            alignas(T) uint8 data[sizeof(T)];
+
+            T* get() { return (T*) data; }
+        };
+
+        template <typename ... TArgs>
+        bool emplace(TArgs&& ... args);
+
+        /**
+         * Claims up to count positions from counter, ready for operation
+         * (cell sequence is position + offset)
+         * @return Number of claimed positions (first one is written in position)
+         */
+        uint32 claim(std::atomic<uint64>& counter, uint64 offset, uint32 count, uint64& position);
+
+    private:
+
+        Cell*  mCells;
+        uint32 mCapacity;
+        uint32 mMask;
+        IAllocator* mAllocator;
+
+        uint8 mPadding0[CACHE_LINE_SIZE];
+        std::atomic<uint64> mTail;          // Next position to push
+        uint8 mPadding1[CACHE_LINE_SIZE];
+        std::atomic<uint64> mHead;          // Next position to pop
+        uint8 mPadding2[CACHE_LINE_SIZE];
+
+    };
+
+    template <typename T>
+    MPMCQueue<T>::MPMCQueue(uint32 capacity, IAllocator *allocator)
+            : mTail(0), mHead(0)
+    {
+        FAIL(capacity >= MIN_CAPACITY, "Capacity must be more than %u", MIN_CAPACITY);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mCapacity = MIN_CAPACITY;
+        while (mCapacity < capacity) mCapacity *= 2;
+
+        mMask = mCapacity - 1;
+        mCells = (Cell*) mAllocator->allocate(mCapacity * (uint32) sizeof(Cell), CACHE_LINE_SIZE);
+
+        for (uint32 i = 0; i < mCapacity; i++)
+        {
+            new (&mCells[i].sequence) std::atomic<uint64>(i);
+        }
+    }
+
+    template <typename T>
+    MPMCQueue<T>::~MPMCQueue()
+    {
+        if (mAllocator)
+        {
+            uint64 head = mHead.load(std::memory_order_relaxed);
+            uint64 tail = mTail.load(std::memory_order_relaxed);
+
+            for (uint64 position = head; position < tail; position++)
+            {
+                mCells[position & mMask].get()->~T();
+            }
+
+            mAllocator->free(mCells);
+            mAllocator = nullptr;
+        }
+    }
+
+    template <typename T>
+    template <typename ... TArgs>
+    bool MPMCQueue<T>::emplace(TArgs&& ... args)
+    {
+        uint64 position;
+        if (claim(mTail, 0, 1, position) == 0) return false;
+
+        auto& cell = mCells[position & mMask];
+        new (cell.data) T(std::forward<TArgs>(args)...);
+        cell.sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template <typename T>
+    bool MPMCQueue<T>::tryPop(T &result)
+    {
+        uint64 position;
+        if (claim(mHead, 1, 1, position) == 0) return false;
+
+        auto& cell = mCells[position & mMask];
+        result = std::move(*cell.get());
+        cell.get()->~T();
+        cell.sequence.store(position + mCapacity, std::memory_order_release);
+
+        return true;
+    }
+
+    template <typename T>
+    uint32 MPMCQueue<T>::tryPushBatch(const T *elements, uint32 count)
+    {
+        uint64 position;
+        uint32 claimed = claim(mTail, 0, count, position);
+
+        for (uint32 i = 0; i < claimed; i++)
+        {
+            auto& cell = mCells[(position + i) & mMask];
+            new (cell.data) T(elements[i]);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+
+        return claimed;
+    }
+
+    template <typename T>
+    uint32 MPMCQueue<T>::tryPopBatch(T *results, uint32 count)
+    {
+        uint64 position;
+        uint32 claimed = claim(mHead, 1, count, position);
+
+        for (uint32 i = 0; i < claimed; i++)
+        {
+            auto& cell = mCells[(position + i) & mMask];
+            results[i] = std::move(*cell.get());
+            cell.get()->~T();
+            cell.sequence.store(position + i + mCapacity, std::memory_order_release);
+        }
+
+        return claimed;
+    }
+
+    template <typename T>
+    uint32 MPMCQueue<T>::claim(std::atomic<uint64> &counter, uint64 offset, uint32 count, uint64 &position)
+    {
+        uint64 current = counter.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            // Sequence of the cell could be changed only by owner of its position,
+            // therefore ready cells stay ready until the counter is moved past them
+
+            uint32 ready = 0;
+
+            while (ready < count &&
+                   mCells[(current + ready) & mMask].sequence.load(std::memory_order_acquire) == current + ready + offset)
+            {
+                ready += 1;
+            }
+
+            if (ready > 0)
+            {
+                if (counter.compare_exchange_weak(current, current + ready, std::memory_order_relaxed))
+                {
+                    position = current;
+                    return ready;
+                }
+
+                continue;
+            }
+
+            // Cell is from the previous lap: queue is full (empty), otherwise
+            // the counter was moved by other thread
+
+            uint64 sequence = mCells[current & mMask].sequence.load(std::memory_order_acquire);
+            if ((int64)(sequence - (current + offset)) < 0) return 0;
+
+            current = counter.load(std::memory_order_relaxed);
+        }
+    }
+
+} // namespace Berserk
+
+#endif //BERSERK_MPMCQUEUE_H
@@ -0,0 +1,147 @@
+//
+// Created by Egor Orachyov on 06.03.2019.
+//
+
+#ifndef BERSERK_SPSCRINGBUFFER_H
+#define BERSERK_SPSCRINGBUFFER_H
+
+#include <atomic>
+#include "Misc/Types.h"
+#include "Misc/Buffers.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+#include "Containers/AlignedArray.h"
+
+namespace Berserk
+{
+
+    /**
+     * Wait-free single-producer single-consumer byte ring for streams of
+     * variable-length records (commands, debug draw requests, log records).
+     * Does not allocate memory after creation.
+     *
+     * Producer writes record in place: beginWrite returns contiguous memory
+     * for payload, endWrite publishes it. Records are never split: if record
+     * does not fit in the end of the buffer, the rest of the buffer is skipped
+     * (with padding record) and record is written from the beginning.
+     * Therefore consumer reads each record in place as contiguous memory,
+     * while the stream itself wraps around the buffer.
+     *
+     * Consumer reads records by positions (could read the same records
+     * several times) and releases memory of read records explicitly.
+     *
+     * @note Positions are monotonic byte counters (never wrap)
+     */
+    class CORE_API SPSCRingBuffer
+    {
+    public:
+
+        /** Alignment of records (and payloads) in the buffer */
+        static const uint32 RECORD_ALIGNMENT = 8;
+
+        /** Default size of the buffer */
+        static const uint32 DEFAULT_CAPACITY = Buffers::KiB * 64;
+
+        /** Min size of the buffer */
+        static const uint32 MIN_CAPACITY = Buffers::SIZE_64;
+
+    public:
+
+        /**
+         * Allocates buffer
+         * @param capacity  Size of the buffer in bytes (rounded up to power of 2)
+         * @param allocator Allocator for buffer [or nullptr for default]
+         */
+        explicit SPSCRingBuffer(uint32 capacity = DEFAULT_CAPACITY, IAllocator* allocator = nullptr);
+
+        SPSCRingBuffer(const SPSCRingBuffer& other) = delete;
+
+        SPSCRingBuffer& operator = (const SPSCRingBuffer& other) = delete;
+
+        ~SPSCRingBuffer();
+
+        GEN_NEW_DELETE(SPSCRingBuffer);
+
+    public:
+
+        /**
+         * Reserves memory for record (producer only)
+         * @param size Size of the payload in bytes
+         * @param tag  User defined type of the record
+         * @return Pointer to size bytes for payload [or nullptr if there is no free space]
+         */
+        void* beginWrite(uint32 size, uint32 tag = 0);
+
+        /** Publishes record, reserved by the last beginWrite (producer only) */
+        void endWrite();
+
+        /** Copies record in the buffer (producer only) @return False if there is no free space */
+        bool write(const void* data, uint32 size, uint32 tag = 0);
+
+        /**
+         * Reads record in place (consumer only)
+         * @param[in,out] position Position of record, moved to the next record
+         * @param[out]    size     Size of the payload
+         * @param[out]    tag      Type of the record
+         * @return Pointer to payload [or nullptr if there are no records published after position]
+         */
+        const void* read(uint64& position, uint32& size, uint32& tag) const;
+
+        /** Frees memory of all records before position (consumer only) */
+        void release(uint64 position);
+
+        /** @return Position after the last published record */
+        uint64 getWritePosition() const { return mTail.load(std::memory_order_acquire); }
+
+        /** @return Position of the first not released record (consumer only) */
+        uint64 getReadPosition() const { return mHead.load(std::memory_order_relaxed); }
+
+        /** @return True if there are no published not released records */
+        bool isEmpty() const { return getReadPosition() == getWritePosition(); }
+
+        /** @return Max size of one record payload */
+        uint32 getMaxRecordSize() const { return mCapacity / 2 - (uint32) sizeof(Header); }
+
+        /** @return Size of the buffer in bytes */
+        uint32 getCapacity() const { return mCapacity; }
+
+        /** @return Memory cost of this resource (on CPU side only) */
+        uint32 getMemoryUsage() const { return mCapacity; }
+
+    private:
+
+        struct Header
+        {
+            uint32 size;    // Size of the payload
+            uint32 tag;     // User tag [or PADDING_TAG]
+        };
+
+        /** Marks skipped end of the buffer */
+        static const uint32 PADDING_TAG = 0xffffffff;
+
+        /** @return Size of the whole record (header and payload) with alignment */
+        static uint32 getRecordSize(uint32 size) { return ((uint32) sizeof(Header) + size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1); }
+
+        Header* getHeader(uint64 position) const { return (Header*) (mBuffer + (position & mMask)); }
+
+    private:
+
+        uint8* mBuffer;
+        uint32 mCapacity;
+        uint32 mMask;
+        IAllocator* mAllocator;
+
+        uint8 mPadding0[CACHE_LINE_SIZE];
+        std::atomic<uint64> mTail;          // Published position (written by producer)
+        uint64 mWritePosition;              // Position after reserved record (producer only)
+        uint64 mCachedHead;                 // Last seen released position (producer only)
+        uint8 mPadding1[CACHE_LINE_SIZE];
+        std::atomic<uint64> mHead;          // Released position (written by consumer)
+        uint8 mPadding2[CACHE_LINE_SIZE];
+
+    };
+
+} // namespace Berserk
+
+#endif //BERSERK_SPSCRINGBUFFER_H
@@ -6,6 +6,7 @@
 #define BERSERK_THREAD_H
 
 #include <thread>
+#include <atomic>
 #include "Misc/Assert.h"
 #include "Threading/IRunnable.h"
 
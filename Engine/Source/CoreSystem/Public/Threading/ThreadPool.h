@@ -7,13 +7,11 @@
 
 #include "Misc/Types.h"
 #include "Misc/Buffers.h"
-#include "Misc/Platform.h"
 #include "Misc/UsageDescriptors.h"
-#include "Memory/LinearAllocator.h"
+#include "JobSystem/JobSystem.h"
 #include "Threading/Thread.h"
 #include "Threading/Future.h"
 #include "Threading/IRunnable.h"
-#include "Threading/ConcurrentLinkedQueue.h"
 
 namespace Berserk
 {
@@ -22,22 +20,26 @@ namespace Berserk
      * Frame based thread pool for executing task in one frame specialization.
      * Allows to wait until all submitted task are completed to start submitting
      * new ones in the next frame.
+     *
+     * Tasks are executed as jobs of work-stealing job system
+     * (idle threads of the pool are parked, not spinning).
+     * Tasks of the frame (including continuations of futures)
+     * are children of the frame job, which join waits for.
+     *
+     * @warning Submit tasks of the next frame after join returned
      */
     class CORE_API ThreadPool
     {
     public:
 
-        /** Initial number of tasks to preallocate in the queue */
-        static const uint32 INITIAL_TASKS_COUNT = Buffers::SIZE_128;
-
-        /** Number of thread to employ in the pool - hardcoded */
-        static const uint32 THREADS_COUNT = TARGET_PHYSICAL_CORES_COUNT - 1;
+        /** Max number of not started tasks submitted by one thread (submit executes task inline while it is exceeded) */
+        static const uint32 INITIAL_TASKS_COUNT = Buffers::SIZE_1024;
 
     public:
 
         /**
-         * Creates pool, initializes threads
-         * @param size Initial queue size for tasks
+         * Creates pool, initializes threads (number of cores - 1)
+         * @param size Max number of not started tasks of one thread
          */
         explicit ThreadPool(uint32 size = INITIAL_TASKS_COUNT);
 
@@ -52,7 +54,7 @@ namespace Berserk
          */
         void submit(IRunnable* runnable, Future* future = nullptr);
 
-        /** Wait until all submitted tasks will be finished */
+        /** Wait until all submitted tasks (and their continuations) will be finished */
         void join();
 
         /** Finish all tasks and close pool */
@@ -61,69 +63,33 @@ namespace Berserk
         /** Close pool immediately without waiting for finishing submitted task */
         void terminate();
 
+        /** @return Number of threads in the pool */
+        uint32 getThreadsCount() const { return mJobSystem.getWorkersCount(); }
+
+        /** @return Job system of the pool (to submit jobs with children) */
+        JobSystem& getJobSystem() { return mJobSystem; }
+
     private:
 
         struct TaskInfo
         {
-            TaskInfo() : runnable(nullptr), future(nullptr) { }
-
-            TaskInfo(IRunnable* runnable, Future* future)
-                    : runnable(runnable), future(future) { }
-
             IRunnable* runnable;
             Future* future;
         };
 
-        typedef ConcurrentLinkedQueue<TaskInfo> TaskQueue;
-
-        class Worker : public IRunnable
-        {
-        public:
-
-            Worker()
-                : mQueue(nullptr) , mShutdown(nullptr) { }
+        friend class Future;
 
-            int32 run() override
-            {
-                while (!(*mShutdown))
-                {
-                    TaskInfo info;
-                    bool notEmpty;
+        /** Submits task of the future (prepared via reset) in the current frame */
+        void schedule(Future* future);
 
-                    mQueue->pop(&info, &notEmpty);
-
-                    if (notEmpty)
-                    {
-                        auto result = info.runnable->run();
-
-                        if (info.future)
-                        {
-                            info.future->mDone = true;
-                            info.future->mResult = result;
-                        }
-                    }
-                    else
-                    {
-                        Thread::yield();
-                    }
-                }
-
-                return 0;
-            }
-
-        public:
-
-            volatile bool* mShutdown;
-            TaskQueue* mQueue;
-
-        };
+        /** Job function of submitted task */
+        static void runTask(JobSystem& system, Job& job);
 
     private:
 
-        Worker mWorker;                     // Worker instace of
-        TaskQueue mQueue;                   //
-        volatile bool mShutdown;            //
-        Thread mThreads[THREADS_COUNT];     //
+        JobSystem mJobSystem;
+        Job* mFrame;                // Parent of the tasks of the current frame
+        bool mShutdown;
 
     };
 
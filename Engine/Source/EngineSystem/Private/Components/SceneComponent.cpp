@@ -10,7 +10,7 @@ namespace Berserk::Engine
 
     SceneComponent::SceneComponent(const IObjectInitializer &objectInitializer)
             : IEntityComponent(objectInitializer),
-              mAttachedComponents(INITIAL_COMPONENTS_COUNT, objectInitializer.getAllocator())
+              mAttachedComponents(objectInitializer.getAllocator())
     {
 
     }
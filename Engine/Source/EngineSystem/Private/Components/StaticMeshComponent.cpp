@@ -29,12 +29,25 @@ namespace Berserk::Engine
         {
             getBufferManager()->deleteGPUBuffer(mSubMeshSet[i].mGeometryBuffer);
         }
+
+        /** Free Render System resources [Source data] */
+        for (uint32 i = 0; i < mSourceData.getSize(); i++)
+        {
+            getResourceHeap()->free(mSourceData[i]);
+        }
     }
 
-    void StaticMeshComponent::addRawData(IGPUBuffer *buffer, IMaterial *material, void* data)
+    void StaticMeshComponent::addRawData(IGPUBuffer *buffer, IMaterial *material, const void* data, uint32 size)
     {
         mSubMeshSet += MeshComponent(buffer, material);
 
+        if (data)
+        {
+            auto handle = getResourceHeap()->allocate(size);
+            memcpy(getResourceHeap()->get(handle), data, size);
+            mSourceData += handle;
+        }
+
         for (uint32 i = 0; i < mUsedMaterials.getSize(); i++)
         {
             if (material == mUsedMaterials[i])
@@ -44,11 +57,6 @@ namespace Berserk::Engine
         }
 
         mUsedMaterials += material;
-
-        if (data)
-        {
-            mSourceData += data;
-        }
     }
 
 } // namespace Berserk::EntitySystem
\ No newline at end of file
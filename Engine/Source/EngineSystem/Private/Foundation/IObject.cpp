@@ -9,7 +9,8 @@ namespace Berserk::Engine
 
     IObject::IObject(const IObjectInitializer& objectInitializer)
             : mObjectName(objectInitializer.getName()),
-              mGeneralAllocator(objectInitializer.getAllocator())
+              mGeneralAllocator(objectInitializer.getAllocator()),
+              mObjectAllocator(objectInitializer.getObjectAllocator())
     {
         mIsInitialized       = FIELD_OFF;
         mIsDestroyed         = FIELD_OFF;
@@ -38,7 +39,7 @@ namespace Berserk::Engine
         /** It is the last action in the procedure of objects destructing */
         mObjectName.~DynamicString();
         mObjectName.nullify();
-        mGeneralAllocator->free(this);
+        mObjectAllocator->free(this);
     }
 
     void IObject::rename(const char *name)
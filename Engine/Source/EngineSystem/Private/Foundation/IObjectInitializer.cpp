@@ -8,8 +8,9 @@
 namespace Berserk::Engine
 {
 
-    IObjectInitializer::IObjectInitializer(const char *name, IAllocator *allocator)
-            : mObjectName(name)
+    IObjectInitializer::IObjectInitializer(const char *name, IAllocator *allocator,
+                                           SmallObjectAllocator *objects, FrameAllocator *frames)
+            : mObjectName(name), mObjectSmallAllocator(objects), mFrameAllocator(frames)
     {
         FAIL(name, "Null pointer name for object initializer");
 
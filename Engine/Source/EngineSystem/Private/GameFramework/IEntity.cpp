@@ -9,8 +9,8 @@ namespace Berserk::Engine
 
     IEntity::IEntity(const IObjectInitializer &objectInitializer)
             : IObject(objectInitializer),
-              mAttachedEntities(DEFAULT_ATTACHED_ENTITIES_COUNT, objectInitializer.getAllocator()),
-              mAttachedComponents(DEFAULT_ATTACHED_COMPONENTS_COUNT, objectInitializer.getAllocator())
+              mAttachedEntities(objectInitializer.getAllocator()),
+              mAttachedComponents(objectInitializer.getAllocator())
     {
 
     }
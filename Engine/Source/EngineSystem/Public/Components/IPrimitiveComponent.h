@@ -7,6 +7,7 @@
 
 #include <Foundation/RenderBase.h>
 #include <Components/SceneComponent.h>
+#include <Containers/SlotMap.h>
 
 namespace Berserk::Engine
 {
@@ -100,11 +101,8 @@ namespace Berserk::Engine
         /** Draw bounding box */
         bool mDrawBoundingBox : 1;
 
-        /** Previous registered component in render system  */
-        IPrimitiveComponent* mPrev = nullptr;
-
-        /** Next registered component in render system  */
-        IPrimitiveComponent* mNext = nullptr;
+        /** Handle of the component in render system registry [invalid if not registered] */
+        SlotHandle mRenderHandle;
 
     };
 
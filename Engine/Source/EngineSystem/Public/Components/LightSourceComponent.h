@@ -7,6 +7,7 @@
 
 #include <Foundation/RenderBase.h>
 #include <Components/SceneComponent.h>
+#include <Containers/SlotMap.h>
 
 namespace Berserk::Engine
 {
@@ -118,11 +119,8 @@ namespace Berserk::Engine
         /** Pointer to relevant shadow map buffer */
         class IDepthBuffer* mShadowMap = nullptr;
 
-        /** Previous registered component in render system  */
-        LightSourceComponent* mPrev = nullptr;
-
-        /** Next registered component in render system  */
-        LightSourceComponent* mNext = nullptr;
+        /** Handle of the component in render system registry [invalid if not registered] */
+        SlotHandle mRenderHandle;
 
     };
 
@@ -8,6 +8,7 @@
 #include <Components/IEntityComponent.h>
 #include <Math/MathInclude.h>
 #include <Containers/ArrayList.h>
+#include <Containers/InlineArrayList.h>
 
 namespace Berserk::Engine
 {
@@ -47,6 +48,12 @@ namespace Berserk::Engine
         /** Do actually nothing */
         ~SceneComponent() override = default;
 
+        /** Number of attached components, stored inside this component without allocation */
+        static const uint32 INITIAL_COMPONENTS_COUNT = 4;
+
+        /** List of attached components */
+        typedef InlineArrayList<SceneComponent*, INITIAL_COMPONENTS_COUNT> ComponentsList;
+
     public:
 
         /**
@@ -130,12 +137,10 @@ namespace Berserk::Engine
         const Mat4x4f& toGlobalSpace() { return mGlobalTransform; }
 
         /** @return Attached to this scene components */
-        ArrayList<SceneComponent*> &getAttachedComponents() { return mAttachedComponents; }
+        ComponentsList &getAttachedComponents() { return mAttachedComponents; }
 
     private:
 
-        static const uint32 INITIAL_COMPONENTS_COUNT = 4;
-
         /** Scale factor around x,y,z axes */
         float32 mScale = 1.0f;
 
@@ -155,7 +160,7 @@ namespace Berserk::Engine
         class SceneComponent* mOwnerComponent = nullptr;
 
         /** Attached to this transformation components (they relative to this) */
-        ArrayList<SceneComponent*> mAttachedComponents;
+        ComponentsList mAttachedComponents;
 
     };
 
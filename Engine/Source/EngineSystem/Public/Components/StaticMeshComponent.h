@@ -38,11 +38,18 @@ namespace Berserk::Engine
          * Adds new mesh from raw buffer and material data
          * @warning Debug purpose only
          * @note Reference count to used resource will decremented in destructor
+         * @note Data is copied in the resource heap [if not null]
          */
-        void addRawData(IGPUBuffer* buffer, IMaterial* material, void* data);
+        void addRawData(IGPUBuffer* buffer, IMaterial* material, const void* data, uint32 size);
 
     #endif
 
+        /** @return Number of source data blocks of meshes */
+        uint32 getNumOfSourceData()                     { return mSourceData.getSize(); }
+
+        /** @return Source data of mesh [pointer is valid until the end of frame] */
+        void* getSourceData(uint32 index)               { return getResourceHeap()->get(mSourceData[index]); }
+
         uint32 getNumOfMaterials() override             { return mUsedMaterials.getSize(); }
 
         void setBoundingBox(const AABB &box) override   { mBoundingBox = box; }
@@ -58,8 +65,8 @@ namespace Berserk::Engine
         /** Pairs of material and geometry */
         ArrayList<MeshComponent> mSubMeshSet;
 
-        /** Raw data of mesh components */
-        ArrayList<void*> mSourceData;
+        /** Raw data of mesh components (blocks of resource heap, could be moved between frames) */
+        ArrayList<RelocatableHeap::Handle> mSourceData;
 
         /** All the materials used by this mesh */
         ArrayList<IMaterial*> mUsedMaterials;
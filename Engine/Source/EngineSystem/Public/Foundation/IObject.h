@@ -54,7 +54,7 @@ namespace Berserk::Engine
         static T* createObject(const IObjectInitializer& objectInitializer)
         {
             uint32 size = sizeof(T);
-            IAllocator* allocator = objectInitializer.getAllocator();
+            IAllocator* allocator = objectInitializer.getObjectAllocator();
 
             return new(allocator->allocate(size)) T(objectInitializer);
         }
@@ -176,6 +176,9 @@ namespace Berserk::Engine
         /** Allocator used to allocate memory for this object components */
         IAllocator* mGeneralAllocator = nullptr;
 
+        /** Allocator used to allocate memory for this object (frees it on destruction) */
+        IAllocator* mObjectAllocator = nullptr;
+
 
     };
 
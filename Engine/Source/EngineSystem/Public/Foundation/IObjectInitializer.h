@@ -13,6 +13,8 @@
 #include <Memory/PoolAllocator.h>
 #include <Memory/StackAllocator.h>
 #include <Memory/LinearAllocator.h>
+#include <Memory/FrameAllocator.h>
+#include <Memory/SmallObjectAllocator.h>
 
 namespace Berserk::Engine
 {
@@ -27,8 +29,15 @@ namespace Berserk::Engine
     {
     public:
 
-        /** Default object initializer from string name */
-        explicit IObjectInitializer(const char *name, IAllocator *general);
+        /**
+         * Default object initializer from string name
+         * @param name    Object name
+         * @param general General purpose allocator [or default engine allocator if nullptr]
+         * @param objects Allocator for objects memory [or general allocator if nullptr]
+         * @param frames  Allocator for transient per-frame data [or nullptr]
+         */
+        explicit IObjectInitializer(const char *name, IAllocator *general,
+                                    SmallObjectAllocator *objects = nullptr, FrameAllocator *frames = nullptr);
 
         virtual ~IObjectInitializer() = default;
 
@@ -41,6 +50,12 @@ namespace Berserk::Engine
         /** @return General purpose allocator for objects tasks */
         virtual IAllocator* getAllocator() const             { return mGenPurposeAllocator; }
 
+        /** @return Allocator for object memory: small object allocator if chosen, otherwise general one */
+        virtual IAllocator* getObjectAllocator() const       { return (mObjectSmallAllocator ? mObjectSmallAllocator : mGenPurposeAllocator); }
+
+        /** @return Small Object Allocator [or nullptr] */
+        virtual SmallObjectAllocator* getSmallObjectAllocator() const { return mObjectSmallAllocator; }
+
         /** @return Pool Allocator [or nullptr] */
         virtual PoolAllocator* getPoolAllocator() const      { return mObjectPool; }
 
@@ -50,6 +65,9 @@ namespace Berserk::Engine
         /** @return Linear Allocator [or nullptr] */
         virtual LinearAllocator* getLinearAllocator() const  { return mObjectLinearAllocator; }
 
+        /** @return Frame Allocator for data, which lives few frames [or nullptr] */
+        virtual FrameAllocator* getFrameAllocator() const    { return mFrameAllocator; }
+
         /** @return Object name */
         virtual const char* getName() const                  { return mObjectName.get(); }
 
@@ -62,6 +80,8 @@ namespace Berserk::Engine
         PoolAllocator* mObjectPool              = nullptr;  //! Pool allocator for object tasks [if needed]
         StackAllocator* mObjectStack            = nullptr;  //! Stack allocator for object tasks [if needed]
         LinearAllocator* mObjectLinearAllocator = nullptr;  //! Linear allocator for object tasks [if needed]
+        SmallObjectAllocator* mObjectSmallAllocator = nullptr; //! Slab allocator for objects memory [if needed]
+        FrameAllocator* mFrameAllocator         = nullptr;  //! Ring of per-frame arenas for transient data [if needed]
 
     };
 
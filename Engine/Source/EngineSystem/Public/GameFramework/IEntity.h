@@ -7,6 +7,7 @@
 
 #include <Foundation/IObject.h>
 #include <Containers/ArrayList.h>
+#include <Containers/InlineArrayList.h>
 #include <Containers/SharedList.h>
 #include <Components/SceneComponent.h>
 #include <Components/IInputComponent.h>
@@ -37,12 +38,18 @@ namespace Berserk::Engine
         /** Show, that entity has no life time limit */
         static const int32 LIFE_TIME_FOREVER = -1;
 
-        /** Default number of child entities to preallocate */
+        /** Number of child entities, stored inside entity without allocation */
         static const uint32 DEFAULT_ATTACHED_ENTITIES_COUNT = 4;
 
-        /** Default number of components to preallocate */
+        /** Number of components, stored inside entity without allocation */
         static const uint32 DEFAULT_ATTACHED_COMPONENTS_COUNT = 4;
 
+        /** List of child entities */
+        typedef InlineArrayList<IEntity*, DEFAULT_ATTACHED_ENTITIES_COUNT> EntitiesList;
+
+        /** List of attached components */
+        typedef InlineArrayList<IEntityComponent*, DEFAULT_ATTACHED_COMPONENTS_COUNT> ComponentsList;
+
     public:
 
         /** Call after component registration */
@@ -137,10 +144,10 @@ namespace Berserk::Engine
         IEntity* getGroupEntity()                           { return mGroupEntity; }
 
         /** @return List of entities, which owner this entity (ECS) */
-        ArrayList<IEntity*> &getEntitiesList()              { return mAttachedEntities; }
+        EntitiesList &getEntitiesList()                     { return mAttachedEntities; }
 
         /** @return List of attached to this entity components (ECS) */
-        ArrayList<IEntityComponent*> &getComponentsList()   { return mAttachedComponents; }
+        ComponentsList &getComponentsList()                 { return mAttachedComponents; }
 
     private:
 
@@ -166,10 +173,10 @@ namespace Berserk::Engine
         class IEntity* mGroupEntity = nullptr;
 
         /** List of layers to which this object is attached */
-        ArrayList<IEntity*> mAttachedEntities;
+        EntitiesList mAttachedEntities;
 
         /** Components, attached to this entity */
-        ArrayList<IEntityComponent*> mAttachedComponents;
+        ComponentsList mAttachedComponents;
 
     };
 
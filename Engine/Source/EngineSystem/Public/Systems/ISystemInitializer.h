@@ -15,8 +15,9 @@ namespace Berserk::Engine
     public:
 
         /** Default system initializer from string name */
-        explicit ISystemInitializer(const char *name, IAllocator *general = nullptr)
-                : IObjectInitializer(name, general)
+        explicit ISystemInitializer(const char *name, IAllocator *general = nullptr,
+                                    SmallObjectAllocator *objects = nullptr, FrameAllocator *frames = nullptr)
+                : IObjectInitializer(name, general, objects, frames)
         {
 
         }
@@ -4,6 +4,8 @@
 
 #include "Managers/GLBufferManager.h"
 #include "Platform/GLProfile.h"
+#include "Platform/GLInclude.h"
+#include "Memory/Allocator.h"
 
 namespace Berserk::Resources
 {
@@ -11,7 +13,8 @@ namespace Berserk::Resources
     GLBufferManager::GLBufferManager() : mGPUBuffers(INITIAL_GPUBUFFERS_COUNT),
                                          mFrameBuffers(INITIAL_FRAMEBUFFERS_COUNT),
                                          mDepthBuffers(INITIAL_DEPTHBUFFERS_COUNT),
-                                         mUniformBuffers(INITIAL_UNIFORMBUFFERS_COUNT)
+                                         mUniformBuffers(INITIAL_UNIFORMBUFFERS_COUNT),
+                                         mPages(INITIAL_PAGES_COUNT)
     {
         PUSH("GLBufferManager: initialize");
     }
@@ -77,6 +80,16 @@ namespace Berserk::Resources
             }
         }
 
+        {
+            // Gpu buffers' ranges are freed above,
+            // shared buffers could be deleted now
+
+            for (uint32 i = 0; i < mPages.getSize(); i++)
+            {
+                if (mPages[i].handle) releasePage(i);
+            }
+        }
+
         PUSH("GLBufferManager: de-initialize");
     }
 
@@ -87,6 +100,14 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLGPUBuffer*>(buffer);
+
+        if (!mGPUBuffersMap.add(CText(name), renamed))
+        {
+            WARNING("GLBufferManager: gpu buffer already exist [name: '%s']", name);
+            return;
+        }
+
+        mGPUBuffersMap.removeIf(CText(renamed->getName()), [renamed](GLGPUBuffer*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
@@ -97,6 +118,14 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLFrameBuffer*>(buffer);
+
+        if (!mFrameBuffersMap.add(CText(name), renamed))
+        {
+            WARNING("GLBufferManager: frame buffer already exist [name: '%s']", name);
+            return;
+        }
+
+        mFrameBuffersMap.removeIf(CText(renamed->getName()), [renamed](GLFrameBuffer*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
@@ -107,6 +136,14 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLDepthBuffer*>(buffer);
+
+        if (!mDepthBuffersMap.add(CText(name), renamed))
+        {
+            WARNING("GLBufferManager: depth buffer already exist [name: '%s']", name);
+            return;
+        }
+
+        mDepthBuffersMap.removeIf(CText(renamed->getName()), [renamed](GLDepthBuffer*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
@@ -117,110 +154,157 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLUniformBuffer*>(buffer);
+
+        if (!mUniformBuffersMap.add(CText(name), renamed))
+        {
+            WARNING("GLBufferManager: uniform buffer already exist [name: '%s']", name);
+            return;
+        }
+
+        mUniformBuffersMap.removeIf(CText(renamed->getName()), [renamed](GLUniformBuffer*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
     void GLBufferManager::deleteGPUBuffer(IGPUBuffer *buffer)
     {
         CText name(buffer->getName());
-        buffer->release();
+        auto target = (GLGPUBuffer*) buffer;
 
-        if (buffer->getReferenceCount() == 0)
+        auto deleted = mGPUBuffersMap.removeIf(name, [target](GLGPUBuffer*& found)
+        {
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
+
+        if (deleted)
         {
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: delete buffer [name: '%s']", name.get());
 #endif
-            mGPUBuffers.remove((GLGPUBuffer*)buffer);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mGPUBuffers.remove(target);
         }
     }
 
     void GLBufferManager::deleteFrameBuffer(IFrameBuffer *buffer)
     {
         CText name(buffer->getName());
-        buffer->release();
+        auto target = (GLFrameBuffer*) buffer;
+
+        auto deleted = mFrameBuffersMap.removeIf(name, [target](GLFrameBuffer*& found)
+        {
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
 
-        if (buffer->getReferenceCount() == 0)
+        if (deleted)
         {
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: delete frame buffer [name: '%s']", name.get());
 #endif
-            mFrameBuffers.remove((GLFrameBuffer*)buffer);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mFrameBuffers.remove(target);
         }
     }
 
     void GLBufferManager::deleteDepthBuffer(IDepthBuffer *buffer)
     {
         CText name(buffer->getName());
-        buffer->release();
+        auto target = (GLDepthBuffer*) buffer;
+
+        auto deleted = mDepthBuffersMap.removeIf(name, [target](GLDepthBuffer*& found)
+        {
+            if (found != target) return false;
 
-        if (buffer->getReferenceCount() == 0)
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
+
+        if (deleted)
         {
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: delete depth buffer [name: '%s']", name.get());
 #endif
-            mDepthBuffers.remove((GLDepthBuffer*)buffer);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mDepthBuffers.remove(target);
         }
     }
 
     void GLBufferManager::deleteUniformBuffer(IUniformBuffer *buffer)
     {
         CText name(buffer->getName());
-        buffer->release();
+        auto target = (GLUniformBuffer*) buffer;
 
-        if (buffer->getReferenceCount() == 0)
+        auto deleted = mUniformBuffersMap.removeIf(name, [target](GLUniformBuffer*& found)
+        {
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
+
+        if (deleted)
         {
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: delete uniform buffer [name: '%s']", name.get());
 #endif
-            mUniformBuffers.remove((GLUniformBuffer*)buffer);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mUniformBuffers.remove(target);
         }
     }
 
     IGPUBuffer* GLBufferManager::createGPUBuffer(const char *name)
     {
-        IGPUBuffer* found = findGPUBuffer(name);
+        bool created = false;
+
+        auto buffer = mGPUBuffersMap.getOrInsert(CText(name), [&]() -> GLGPUBuffer*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
 
-        if (found)
+            auto resource = new(mGPUBuffers.preallocate()) GLGPUBuffer;
+            resource->initialize(name);
+            resource->addReference();
+            resource->mManager = this;
+
+            created = true;
+            return resource;
+        });
+
+        if (!created)
         {
             WARNING("GLBufferManager: gpu buffer already exist [name: '%s']", name);
             return nullptr;
         }
 
-        {
-            GLGPUBuffer buffer;
-            buffer.initialize(name);
-            buffer.addReference();
-
-            mGPUBuffers += buffer;
-
 #if PROFILE_GL_BUFFER_MANAGER
-            PUSH("GLBufferManager: create gpu buffer [name: '%s'][ref: %u]", buffer.getName(), buffer.getReferenceCount());
+        PUSH("GLBufferManager: create gpu buffer [name: '%s'][ref: %u]", buffer->getName(), buffer->getReferenceCount());
 #endif
-        }
 
-        return mGPUBuffers.getLast();
+        return buffer;
     }
 
     IGPUBuffer* GLBufferManager::findGPUBuffer(const char *name)
     {
-        for (auto current = mGPUBuffers.iterate(); current != nullptr; current = mGPUBuffers.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        GLGPUBuffer* found = nullptr;
+        mGPUBuffersMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     IGPUBuffer* GLBufferManager::getGPUBuffer(const char *name)
     {
-        IGPUBuffer* found = findGPUBuffer(name);
+        GLGPUBuffer* found = nullptr;
 
-        if (found)
+        if (mGPUBuffersMap.find(CText(name), found, [](GLGPUBuffer*& buffer) { buffer->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: find gpu buffer [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -232,49 +316,47 @@ namespace Berserk::Resources
 
     IFrameBuffer* GLBufferManager::createFrameBuffer(const char *name)
     {
-        IFrameBuffer* found = findFrameBuffer(name);
+        bool created = false;
+
+        auto buffer = mFrameBuffersMap.getOrInsert(CText(name), [&]() -> GLFrameBuffer*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
 
-        if (found)
+            auto resource = new(mFrameBuffers.preallocate()) GLFrameBuffer;
+            resource->initialize(name);
+            resource->addReference();
+
+            created = true;
+            return resource;
+        });
+
+        if (!created)
         {
             WARNING("GLBufferManager: frame buffer already exist [name: '%s']", name);
             return nullptr;
         }
 
-        {
-            GLFrameBuffer buffer;
-            buffer.initialize(name);
-            buffer.addReference();
-
-            mFrameBuffers += buffer;
-
 #if PROFILE_GL_BUFFER_MANAGER
-            PUSH("GLBufferManager: create frame buffer [name: '%s'][ref: %u]", buffer.getName(), buffer.getReferenceCount());
+        PUSH("GLBufferManager: create frame buffer [name: '%s'][ref: %u]", buffer->getName(), buffer->getReferenceCount());
 #endif
-        }
 
-        return mFrameBuffers.getLast();
+        return buffer;
     }
 
     IFrameBuffer* GLBufferManager::findFrameBuffer(const char *name)
     {
-        for (auto current = mFrameBuffers.iterate(); current != nullptr; current = mFrameBuffers.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        GLFrameBuffer* found = nullptr;
+        mFrameBuffersMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     IFrameBuffer* GLBufferManager::getFrameBuffer(const char *name)
     {
-        IFrameBuffer* found = findFrameBuffer(name);
+        GLFrameBuffer* found = nullptr;
 
-        if (found)
+        if (mFrameBuffersMap.find(CText(name), found, [](GLFrameBuffer*& buffer) { buffer->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: find frame buffer [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -286,49 +368,47 @@ namespace Berserk::Resources
 
     IDepthBuffer* GLBufferManager::createDepthBuffer(const char *name)
     {
-        IDepthBuffer* found = findDepthBuffer(name);
+        bool created = false;
 
-        if (found)
+        auto buffer = mDepthBuffersMap.getOrInsert(CText(name), [&]() -> GLDepthBuffer*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+
+            auto resource = new(mDepthBuffers.preallocate()) GLDepthBuffer;
+            resource->initialize(name);
+            resource->addReference();
+
+            created = true;
+            return resource;
+        });
+
+        if (!created)
         {
             WARNING("GLBufferManager: depth buffer already exist [name: '%s']", name);
             return nullptr;
         }
 
-        {
-            GLDepthBuffer buffer;
-            buffer.initialize(name);
-            buffer.addReference();
-
-            mDepthBuffers += buffer;
-
 #if PROFILE_GL_BUFFER_MANAGER
-            PUSH("GLBufferManager: create depth buffer [name: '%s'][ref: %u]", buffer.getName(), buffer.getReferenceCount());
+        PUSH("GLBufferManager: create depth buffer [name: '%s'][ref: %u]", buffer->getName(), buffer->getReferenceCount());
 #endif
-        }
 
-        return mDepthBuffers.getLast();
+        return buffer;
     }
 
     IDepthBuffer* GLBufferManager::findDepthBuffer(const char *name)
     {
-        for (auto current = mDepthBuffers.iterate(); current != nullptr; current = mDepthBuffers.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        GLDepthBuffer* found = nullptr;
+        mDepthBuffersMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     IDepthBuffer* GLBufferManager::getDepthBuffer(const char *name)
     {
-        IDepthBuffer* found = findDepthBuffer(name);
+        GLDepthBuffer* found = nullptr;
 
-        if (found)
+        if (mDepthBuffersMap.find(CText(name), found, [](GLDepthBuffer*& buffer) { buffer->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_GL_BUFFER_MANAGER
             PUSH("GLBufferManager: find depth buffer [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -340,65 +420,215 @@ namespace Berserk::Resources
 
     IUniformBuffer* GLBufferManager::createUniformBuffer(const char *name)
     {
-        IUniformBuffer* found = findUniformBuffer(name);
+        bool created = false;
+
+        auto buffer = mUniformBuffersMap.getOrInsert(CText(name), [&]() -> GLUniformBuffer*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+
+            auto resource = new(mUniformBuffers.preallocate()) GLUniformBuffer;
+            resource->initialize(name);
+            resource->addReference();
+
+            created = true;
+            return resource;
+        });
 
-        if (found)
+        if (!created)
         {
             WARNING("GLBufferManager: uniform buffer already exist [name: '%s']", name);
             return nullptr;
         }
 
-        {
-            GLUniformBuffer buffer;
-            buffer.initialize(name);
-            buffer.addReference();
+#if PROFILE_GL_BUFFER_MANAGER
+        PUSH("GLBufferManager: create uniform buffer [name: '%s'][ref: %u]", buffer->getName(), buffer->getReferenceCount());
+#endif
 
-            mUniformBuffers += buffer;
+        return buffer;
+    }
+
+    IUniformBuffer* GLBufferManager::findUniformBuffer(const char *name)
+    {
+        GLUniformBuffer* found = nullptr;
+        mUniformBuffersMap.find(CText(name), found);
+
+        return found;
+    }
+
+    IUniformBuffer* GLBufferManager::getUniformBuffer(const char *name)
+    {
+        GLUniformBuffer* found = nullptr;
 
+        if (mUniformBuffersMap.find(CText(name), found, [](GLUniformBuffer*& buffer) { buffer->addReference(); }))
+        {
 #if PROFILE_GL_BUFFER_MANAGER
-            PUSH("GLBufferManager: create uniform buffer [name: '%s'][ref: %u]", buffer.getName(), buffer.getReferenceCount());
+            PUSH("GLBufferManager: find uniform buffer [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
+            return found;
         }
 
-        return mUniformBuffers.getLast();
+        return nullptr;
     }
 
-    IUniformBuffer* GLBufferManager::findUniformBuffer(const char *name)
+    bool GLBufferManager::allocateRange(uint32 size, uint32 alignment, GPUBufferRange &range)
     {
-        for (auto current = mUniformBuffers.iterate(); current != nullptr; current = mUniformBuffers.next())
+        uint32 offset = BuddyRangeAllocator::INVALID_OFFSET;
+        uint32 index = 0;
+
+        for (; index < mPages.getSize(); index++)
         {
-            if (current->mResourceName == name)
+            Page& page = mPages[index];
+
+            if (page.handle && page.allocator->canAllocate(size, alignment))
             {
-                return current;
+                offset = page.allocator->allocate(size, alignment);
+                break;
             }
         }
 
-        return nullptr;
+        if (offset == BuddyRangeAllocator::INVALID_OFFSET)
+        {
+            index = createPage(size);
+            offset = mPages[index].allocator->allocate(size, alignment);
+        }
+
+        if (offset == BuddyRangeAllocator::INVALID_OFFSET)
+        {
+            WARNING("GLBufferManager: cannot allocate range [size: %u][alignment: %u]", size, alignment);
+            return false;
+        }
+
+        Page& page = mPages[index];
+
+        range.buffer = page.handle;
+        range.page = index;
+        range.offset = offset;
+        range.size = page.allocator->getBlockSize(offset);
+
+#if PROFILE_GL_BUFFER_MANAGER
+        PUSH("GLBufferManager: allocate range [page: %u][offset: %u][size: %u]", index, offset, range.size);
+#endif
+
+        return true;
     }
 
-    IUniformBuffer* GLBufferManager::getUniformBuffer(const char *name)
+    void GLBufferManager::freeRange(GPUBufferRange &range)
     {
-        IUniformBuffer* found = findUniformBuffer(name);
+        if (range.isNull()) return;
+
+        Page& page = mPages[range.page];
+        page.allocator->free(range.offset);
 
-        if (found)
-        {
-            found->addReference();
 #if PROFILE_GL_BUFFER_MANAGER
-            PUSH("GLBufferManager: find uniform buffer [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
+        PUSH("GLBufferManager: free range [page: %u][offset: %u][size: %u]", range.page, range.offset, range.size);
 #endif
-            return found;
+
+        // The first page is kept: meshes are often reloaded
+        // and its buffer must not be re-created each time
+
+        if (range.page != 0 && page.allocator->getAllocationsCount() == 0) releasePage(range.page);
+
+        range = GPUBufferRange();
+    }
+
+    void GLBufferManager::getRangeStats(BuddyRangeAllocator::Stats &stats)
+    {
+        stats.size = 0;
+        stats.usedSize = 0;
+        stats.freeSize = 0;
+        stats.largestFreeBlock = 0;
+        stats.allocationsCount = 0;
+
+        for (uint32 i = 0; i < mPages.getSize(); i++)
+        {
+            if (mPages[i].handle == 0) continue;
+
+            BuddyRangeAllocator::Stats page;
+            mPages[i].allocator->getStats(page);
+
+            stats.size += page.size;
+            stats.usedSize += page.usedSize;
+            stats.freeSize += page.freeSize;
+            stats.allocationsCount += page.allocationsCount;
+            stats.largestFreeBlock = (page.largestFreeBlock > stats.largestFreeBlock ? page.largestFreeBlock : stats.largestFreeBlock);
         }
 
-        return nullptr;
+        stats.fragmentation = (stats.freeSize > 0 ? 1.0f - (float)stats.largestFreeBlock / (float)stats.freeSize : 0.0f);
+    }
+
+    uint32 GLBufferManager::createPage(uint32 size)
+    {
+        uint32 pageSize = PAGE_SIZE;
+        while (pageSize < size) pageSize *= 2;
+
+        uint32 index = 0;
+        while (index < mPages.getSize() && mPages[index].handle != 0) index += 1;
+
+        if (index == mPages.getSize())
+        {
+            Page page = { 0, nullptr };
+            mPages += page;
+        }
+
+        Page& page = mPages[index];
+
+        // Storage of shared buffer is allocated once,
+        // ranges are filled later via glBufferSubData
+
+        glGenBuffers(1, &page.handle);
+        glBindBuffer(GL_ARRAY_BUFFER, page.handle);
+        glBufferData(GL_ARRAY_BUFFER, pageSize, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        IAllocator* allocator = &Allocator::getSingleton();
+        page.allocator = new (allocator->allocate(sizeof(BuddyRangeAllocator))) BuddyRangeAllocator(pageSize, BuddyRangeAllocator::DEFAULT_MIN_BLOCK_SIZE, allocator);
+
+#if PROFILE_GL_BUFFER_MANAGER
+        PUSH("GLBufferManager: create page [index: %u][size: %u]", index, pageSize);
+#endif
+
+        return index;
+    }
+
+    void GLBufferManager::releasePage(uint32 index)
+    {
+        Page& page = mPages[index];
+
+#if PROFILE_GL_BUFFER_MANAGER
+        PUSH("GLBufferManager: release page [index: %u][size: %u]", index, page.allocator->getSize());
+#endif
+
+        glDeleteBuffers(1, &page.handle);
+
+        delete (page.allocator);
+        Allocator::getSingleton().free(page.allocator);
+
+        page.handle = 0;
+        page.allocator = nullptr;
     }
 
     uint32 GLBufferManager::getMemoryUsage()
     {
-        return sizeof(GLBufferManager)          +
-               mGPUBuffers.getMemoryUsage()     +
-               mFrameBuffers.getMemoryUsage()   +
-               mDepthBuffers.getMemoryUsage()   +
-               mUniformBuffers.getMemoryUsage() ;
+        uint32 pagesUsage = 0;
+
+        for (uint32 i = 0; i < mPages.getSize(); i++)
+        {
+            if (mPages[i].allocator) pagesUsage += mPages[i].allocator->getMemoryUsage();
+        }
+
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
+        return sizeof(GLBufferManager)              +
+               mGPUBuffers.getMemoryUsage()         +
+               mFrameBuffers.getMemoryUsage()       +
+               mDepthBuffers.getMemoryUsage()       +
+               mUniformBuffers.getMemoryUsage()     +
+               mGPUBuffersMap.getMemoryUsage()      +
+               mFrameBuffersMap.getMemoryUsage()    +
+               mDepthBuffersMap.getMemoryUsage()    +
+               mUniformBuffersMap.getMemoryUsage()  +
+               mPages.getMemoryUsage()              +
+               pagesUsage;
 
     }
 
@@ -406,6 +636,8 @@ namespace Berserk::Resources
     {
         auto root = sizer->addObject("BufferManager", getMemoryUsage());
 
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
         for (auto current = mGPUBuffers.iterate(); current != nullptr; current = mGPUBuffers.next())
         {
             sizer->addChild(root, current->getName(), current->getMemoryUsage(), current->getGPUMemoryUsage());
@@ -425,6 +657,24 @@ namespace Berserk::Resources
         {
             sizer->addChild(root, current->getName(), current->getMemoryUsage(), current->getGPUMemoryUsage());
         }
+
+        {
+            // Sizer keeps pointers to names, therefore
+            // all the shared buffers are reported as one node
+
+            uint32 cpuUsage = mPages.getMemoryUsage();
+            uint32 gpuUsage = 0;
+
+            for (uint32 i = 0; i < mPages.getSize(); i++)
+            {
+                if (mPages[i].handle == 0) continue;
+
+                cpuUsage += mPages[i].allocator->getMemoryUsage();
+                gpuUsage += mPages[i].allocator->getSize();
+            }
+
+            sizer->addChild(root, "SharedBuffers", cpuUsage, gpuUsage);
+        }
     }
 
 } // namespace Berserk::Resources
\ No newline at end of file
@@ -10,8 +10,7 @@ namespace Berserk::Resources
 {
 
     GLShaderManager::GLShaderManager(const char *path) : mPath(path),
-                                                         mShaders(INITIAL_SHADERS_COUNT),
-                                                         mShadersUniformsPool(HashMap<CName,uint32>::getNodeSize(), PoolAllocator::INITIAL_CHUNK_COUNT)
+                                                         mShaders(INITIAL_SHADERS_COUNT)
     {
         PUSH("GLShaderManager: initialize");
     }
@@ -43,65 +42,83 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLShader*>(shader);
+
+        if (!mShadersMap.add(CText(name), renamed))
+        {
+            WARNING("GLShaderManager: shader already exist [name: '%s']", name);
+            return;
+        }
+
+        mShadersMap.removeIf(CText(renamed->getName()), [renamed](GLShader*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
     void GLShaderManager::deleteShader(IShader *shader)
     {
         CText name(shader->getName());
-        shader->release();
+        auto target = (GLShader*) shader;
 
-        if (shader->getReferenceCount() == 0)
+        auto deleted = mShadersMap.removeIf(name, [target](GLShader*& found)
+        {
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
+
+        if (deleted)
         {
 #if PROFILE_GL_SHADER_MANAGER
             PUSH("GLShaderManager: delete shader [name: '%s']", name.get());
 #endif
-            mShaders.remove((GLShader*)shader);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mShaders.remove(target);
         }
     }
 
     IShader* GLShaderManager::createShader(const char *name)
     {
-        IShader* found = findShader(name);
+        bool created = false;
 
-        if (found)
+        auto shader = mShadersMap.getOrInsert(CText(name), [&]() -> GLShader*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+
+            auto shader = new(mShaders.preallocate()) GLShader(name);
+            shader->addReference();
+
+            created = true;
+            return shader;
+        });
+
+        if (!created)
         {
             WARNING("GLShaderManager: shader already exist [name: '%s']", name);
             return nullptr;
         }
 
-        auto shader = new(mShaders.preallocate()) GLShader(name);
-
-        {
-            shader->addReference();
 #if PROFILE_GL_SHADER_MANAGER
-            PUSH("GLShaderManager: create shader [name: '%s'][ref: %u]", shader->getName(), shader->getReferenceCount());
+        PUSH("GLShaderManager: create shader [name: '%s'][ref: %u]", shader->getName(), shader->getReferenceCount());
 #endif
-        }
 
         return shader;
     }
 
     IShader* GLShaderManager::findShader(const char *name)
     {
-        for (auto current = mShaders.iterate(); current != nullptr; current = mShaders.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        GLShader* found = nullptr;
+        mShadersMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     IShader* GLShaderManager::getShader(const char *name)
     {
-        IShader* found = findShader(name);
+        GLShader* found = nullptr;
 
-        if (found)
+        if (mShadersMap.find(CText(name), found, [](GLShader*& shader) { shader->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_GL_SHADER_MANAGER
             PUSH("GLShaderManager: find shader [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -131,11 +148,10 @@ namespace Berserk::Resources
     {
         if (name != nullptr)
         {
-            auto found = findShader(name);
+            GLShader* found = nullptr;
 
-            if (found)
+            if (mShadersMap.find(CText(name), found, [](GLShader*& shader) { shader->addReference(); }))
             {
-                found->addReference();
 #if PROFILE_GL_SHADER_MANAGER
                 PUSH("GLShaderManager: find shader [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -145,23 +161,58 @@ namespace Berserk::Resources
 
         const char* program = node.getAttribute("name").getValue();
 
+        auto shader = mShadersMap.getOrInsert(CText(program), [&]()
+        {
+            return importShader(program, node);
+        },
+        [](GLShader*& found)
         {
-            auto found = findShader(program);
+            found->addReference();
+        });
 
-            if (found)
-            {
-                found->addReference();
 #if PROFILE_GL_SHADER_MANAGER
-                PUSH("GLShaderManager: find shader [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
+        if (shader)
+        {
+            PUSH("GLShaderManager: load shader [name: '%s'][ref: %u]", shader->getName(), shader->getReferenceCount());
+        }
 #endif
-                return found;
-            }
+
+        return shader;
+    }
+
+    uint32 GLShaderManager::getMemoryUsage()
+    {
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
+        return sizeof(GLShaderManager)       +
+               mShaders.getMemoryUsage()     +
+               mShadersMap.getMemoryUsage()  ;
+    }
+
+    void GLShaderManager::getMemoryUsage(MemorySizer *sizer)
+    {
+        auto root = sizer->addObject("ShaderManager", getMemoryUsage());
+
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
+        for (auto current = mShaders.iterate(); current != nullptr; current = mShaders.next())
+        {
+            sizer->addChild(root, current->getName(), current->getMemoryUsage(), current->getGPUMemoryUsage());
+        }
+    }
+
+    GLShader* GLShaderManager::importShader(const char *program, XMLNode &node)
+    {
+        GLShader* shader;
+
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            shader = new(mShaders.preallocate()) GLShader(program);
         }
 
-        auto shader = new(mShaders.preallocate()) GLShader(program);
-        shader->createProgram(&mShadersUniformsPool);
+        shader->createProgram();
 
-        bool loaded = false;
+        bool found = false;
 
         for (auto platform = node.getChild(); !platform.isEmpty(); platform = platform.getNext())
         {
@@ -169,46 +220,32 @@ namespace Berserk::Resources
             {
                 auto success = ShaderManagerHelper::import(shader, platform, mPath);
 
-                if (!success)
+                if (success)
                 {
-                    WARNING("Cannot load shader program from xml node [name: '%s']", program);
-
-                    shader->release();
-                    mShaders.remove(shader);
-                    return nullptr;
+                    shader->addReference();
+                    return shader;
                 }
 
-                loaded = true;
+                WARNING("Cannot load shader program from xml node [name: '%s']", program);
+
+                found = true;
                 break;
             }
         }
 
-        if (!loaded)
+        if (!found)
         {
             WARNING("Non-exhaustive meta-inf.xml for OpenGL platform [name: '%s']", program);
-            return nullptr;
         }
 
-        shader->addReference();
+        // Failed program is removed: the next load tries to import it again
 
-        return shader;
-    }
-
-    uint32 GLShaderManager::getMemoryUsage()
-    {
-        return sizeof(GLShaderManager)                             +
-               mShaders.getMemoryUsage()                           +
-               (uint32) mShadersUniformsPool.getTotalMemoryUsage() ;
-    }
+        shader->release();
 
-    void GLShaderManager::getMemoryUsage(MemorySizer *sizer)
-    {
-        auto root = sizer->addObject("ShaderManager", getMemoryUsage());
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+        mShaders.remove(shader);
 
-        for (auto current = mShaders.iterate(); current != nullptr; current = mShaders.next())
-        {
-            sizer->addChild(root, current->getName(), current->getMemoryUsage(), current->getGPUMemoryUsage());
-        }
+        return nullptr;
     }
 
 } // namespace Berserk::Resources
\ No newline at end of file
@@ -80,6 +80,17 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLTexture*>(texture);
+
+        // New name is added first: resource keeps old name and
+        // entry if the new name is taken
+
+        if (!mTexturesMap.add(CText(name), renamed))
+        {
+            WARNING("GLTextureManager: texture already exist [name: '%s']", name);
+            return;
+        }
+
+        mTexturesMap.removeIf(CText(renamed->getName()), [renamed](GLTexture*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
@@ -90,6 +101,14 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<GLSampler*>(sampler);
+
+        if (!mSamplersMap.add(CText(name), renamed))
+        {
+            WARNING("GLTextureManager: sampler already exist [name: '%s']", name);
+            return;
+        }
+
+        mSamplersMap.removeIf(CText(renamed->getName()), [renamed](GLSampler*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
@@ -118,10 +137,23 @@ namespace Berserk::Resources
 
     void GLTextureManager::deleteTexture(ITexture *texture)
     {
+        // Reference is released under lookup lock: concurrent
+        // loads could not get texture which is being deleted
+
         CText name(texture->getName());
-        texture->release();
+        auto target = (GLTexture*) texture;
+
+        auto deleted = mTexturesMap.removeIf(name, [target](GLTexture*& found)
+        {
+            // Other resource could be registered with the same name
 
-        if (texture->getReferenceCount() == 0)
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
+
+        if (deleted)
         {
             auto sampler = texture->getSampler();
 
@@ -133,69 +165,79 @@ namespace Berserk::Resources
 #if PROFILE_GL_TEXTURE_MANAGER
             PUSH("GLTextureManager: delete texture [name: '%s']", name.get());
 #endif
-            mTextures.remove((GLTexture*)texture);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mTextures.remove(target);
         }
     }
 
     void GLTextureManager::deleteSampler(ISampler *sampler)
     {
         CText name(sampler->getName());
-        sampler->release();
+        auto target = (GLSampler*) sampler;
 
-        if (sampler->getReferenceCount() == 0)
+        auto deleted = mSamplersMap.removeIf(name, [target](GLSampler*& found)
+        {
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
+
+        if (deleted)
         {
 #if PROFILE_GL_TEXTURE_MANAGER
             PUSH("GLTextureManager: delete sampler [name: '%s']", name.get());
 #endif
-            mSamplers.remove((GLSampler*)sampler);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mSamplers.remove(target);
         }
     }
 
     ITexture* GLTextureManager::createTexture(const char *name)
     {
-        ITexture* found = findTexture(name);
+        bool created = false;
+
+        auto texture = mTexturesMap.getOrInsert(CText(name), [&]() -> GLTexture*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+
+            auto resource = new(mTextures.preallocate()) GLTexture;
+            resource->initialize(name);
+            resource->addReference();
+
+            created = true;
+            return resource;
+        });
 
-        if (found)
+        if (!created)
         {
             WARNING("GLTextureManager: texture already exist [name: '%s']", name);
             return nullptr;
         }
 
-        {
-            GLTexture texture;
-            texture.initialize(name);
-            texture.addReference();
-
-            mTextures += texture;
-
 #if PROFILE_GL_TEXTURE_MANAGER
-            PUSH("GLTextureManager: create texture [name: '%s'][ref: %u]", texture.getName(), texture.getReferenceCount());
+        PUSH("GLTextureManager: create texture [name: '%s'][ref: %u]", texture->getName(), texture->getReferenceCount());
 #endif
-        }
 
-        return mTextures.getLast();
+        return texture;
     }
 
     ITexture* GLTextureManager::findTexture(const char *name)
     {
-        for (auto current = mTextures.iterate(); current != nullptr; current = mTextures.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        GLTexture* found = nullptr;
+        mTexturesMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     ITexture* GLTextureManager::getTexture(const char *name)
     {
-        ITexture* found = findTexture(name);
+        GLTexture* found = nullptr;
 
-        if (found)
+        if (mTexturesMap.find(CText(name), found, [](GLTexture*& texture) { texture->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_GL_TEXTURE_MANAGER
             PUSH("GLTextureManager: find texture [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -205,58 +247,37 @@ namespace Berserk::Resources
         return nullptr;
     }
 
-    ITexture * GLTextureManager::loadTexture(const char *path, const char *name)
+    ITexture* GLTextureManager::loadTexture(const char *path, const char *name)
     {
-        ITexture* found = findTexture(name);
-
-        if (found)
+        auto texture = mTexturesMap.getOrInsert(CText(name), [&]()
+        {
+            return importTexture(path, name);
+        },
+        [](GLTexture*& found)
         {
             found->addReference();
-#if PROFILE_GL_TEXTURE_MANAGER
-            PUSH("GLTextureManager: load texture [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
-#endif
-            return found;
-        }
+        });
 
+        if (texture == nullptr)
         {
-            CPath filename(path);
-            filename = filename.replace(CPath("{TEXTURES}"), CPath(mTexturesPath.get()));
-            filename += name;
-
-            Importers::IImageImporter::ImageData data;
-
-            auto loaded = mImageImporter->import(filename.get(), data);
-
-            if (!loaded)
-            {
-                WARNING("GLTextureManager: failed to load texture [name: '%s']", filename.get());
-                return getDefaultHelperTexture();
-            }
-
-            auto texture = new(mTextures.preallocate()) GLTexture;
-            texture->initialize(name);
-            texture->addReference();
-            texture->create(data.width, data.height, data.storageFormat, data.pixelFormat, data.pixelType, data.buffer, true);
-            texture->mSampler = getSamplerLinear();
+            return getDefaultHelperTexture();
+        }
 
 #if PROFILE_GL_TEXTURE_MANAGER
-            PUSH("GLTextureManager: load texture [name: '%s'][ref: %u]", texture->getName(), texture->getReferenceCount());
+        PUSH("GLTextureManager: load texture [name: '%s'][ref: %u]", texture->getName(), texture->getReferenceCount());
 #endif
 
-            return texture;
-        }
-
+        return texture;
     }
 
     ITexture* GLTextureManager::loadTextureFromXML(const char *name, XMLNode &node)
     {
         if (name)
         {
-            ITexture* found = findTexture(name);
+            GLTexture* found = nullptr;
 
-            if (found)
+            if (mTexturesMap.find(CText(name), found, [](GLTexture*& texture) { texture->addReference(); }))
             {
-                found->addReference();
 #if PROFILE_GL_TEXTURE_MANAGER
                 PUSH("GLTextureManager: find texture [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -310,49 +331,47 @@ namespace Berserk::Resources
 
     ISampler* GLTextureManager::createSampler(const char *name)
     {
-        ISampler* found = findSampler(name);
+        bool created = false;
+
+        auto sampler = mSamplersMap.getOrInsert(CText(name), [&]() -> GLSampler*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
 
-        if (found)
+            auto resource = new(mSamplers.preallocate()) GLSampler;
+            resource->initialize(name);
+            resource->addReference();
+
+            created = true;
+            return resource;
+        });
+
+        if (!created)
         {
             WARNING("GLTextureManager: sampler already exist [name: '%s']", name);
             return nullptr;
         }
 
-        {
-            GLSampler sampler;
-            sampler.initialize(name);
-            sampler.addReference();
-
-            mSamplers += sampler;
-
 #if PROFILE_GL_TEXTURE_MANAGER
-            PUSH("GLTextureManager: create sampler [name: '%s'][ref: %u]", sampler.getName(), sampler.getReferenceCount());
+        PUSH("GLTextureManager: create sampler [name: '%s'][ref: %u]", sampler->getName(), sampler->getReferenceCount());
 #endif
-        }
 
-        return mSamplers.getLast();
+        return sampler;
     }
 
     ISampler* GLTextureManager::findSampler(const char *name)
     {
-        for (auto current = mSamplers.iterate(); current != nullptr; current = mSamplers.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        GLSampler* found = nullptr;
+        mSamplersMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     ISampler* GLTextureManager::getSampler(const char *name)
     {
-        ISampler* found = findSampler(name);
+        GLSampler* found = nullptr;
 
-        if (found)
+        if (mSamplersMap.find(CText(name), found, [](GLSampler*& sampler) { sampler->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_GL_TEXTURE_MANAGER
             PUSH("GLTextureManager: find sampler [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -376,9 +395,13 @@ namespace Berserk::Resources
 
     uint32 GLTextureManager::getMemoryUsage()
     {
-        return sizeof(GLTextureManager)   +
-               mTextures.getMemoryUsage() +
-               mSamplers.getMemoryUsage() ;
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
+        return sizeof(GLTextureManager)         +
+               mTextures.getMemoryUsage()       +
+               mSamplers.getMemoryUsage()       +
+               mTexturesMap.getMemoryUsage()    +
+               mSamplersMap.getMemoryUsage()    ;
 
     }
 
@@ -386,10 +409,43 @@ namespace Berserk::Resources
     {
         auto root = sizer->addObject("TextureManager", getMemoryUsage());
 
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
         for (auto current = mTextures.iterate(); current != nullptr; current = mTextures.next())
         {
             sizer->addChild(root, current->getName(), current->getMemoryUsage(), current->getGPUMemoryUsage());
         }
     }
 
+    GLTexture* GLTextureManager::importTexture(const char *path, const char *name)
+    {
+        CPath filename(path);
+        filename = filename.replace(CPath("{TEXTURES}"), CPath(mTexturesPath.get()));
+        filename += name;
+
+        Importers::IImageImporter::ImageData data;
+
+        auto loaded = mImageImporter->import(filename.get(), data);
+
+        if (!loaded)
+        {
+            WARNING("GLTextureManager: failed to load texture [name: '%s']", filename.get());
+            return nullptr;
+        }
+
+        GLTexture* texture;
+
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            texture = new(mTextures.preallocate()) GLTexture;
+        }
+
+        texture->initialize(name);
+        texture->addReference();
+        texture->create(data.width, data.height, data.storageFormat, data.pixelFormat, data.pixelType, data.buffer, true);
+        texture->mSampler = getSamplerLinear();
+
+        return texture;
+    }
+
 } // namespace Berserk::Resources
\ No newline at end of file
@@ -30,6 +30,11 @@ namespace Berserk
             mReferenceCount = 0;
             mIndicesCount = 0;
             mVerticesCount = 0;
+            mIndicesOffset = 0;
+
+            mManager = nullptr;
+            mVertexRange = GPUBufferRange();
+            mIndexRange = GPUBufferRange();
 
             new(&mResourceName) CString(name);
         }
@@ -53,8 +58,14 @@ namespace Berserk
 #endif
 
                 if (mVertexArrayObject) glDeleteVertexArrays(1, &mVertexArrayObject);
-                if (mElementBufferObject) glDeleteBuffers(1, &mElementBufferObject);
-                if (mVertexBufferObject) glDeleteBuffers(1, &mVertexBufferObject);
+
+                // Shared buffers are owned by the manager: only ranges are freed
+
+                if (!mIndexRange.isNull()) mManager->freeRange(mIndexRange);
+                else if (mElementBufferObject) glDeleteBuffers(1, &mElementBufferObject);
+
+                if (!mVertexRange.isNull()) mManager->freeRange(mVertexRange);
+                else if (mVertexBufferObject) glDeleteBuffers(1, &mVertexBufferObject);
 
                 mVertexArrayObject   = 0;
                 mElementBufferObject = 0;
@@ -89,89 +100,87 @@ namespace Berserk
             glGenVertexArrays(1, &mVertexArrayObject);
             glBindVertexArray(mVertexArrayObject);
 
-            glGenBuffers(1, &mVertexBufferObject);
-            glBindBuffer(GL_ARRAY_BUFFER, mVertexBufferObject);
+            uint64 base = 0;
 
             if (vertexType == eVT_Vertex)
             {
-                glBufferData(GL_ARRAY_BUFFER, sizeof(Vertf) * verticesCount, vertices, GL_STATIC_DRAW);
+                base = upload(GL_ARRAY_BUFFER, mVertexBufferObject, mVertexRange, sizeof(Vertf) * verticesCount, VERTEX_ALIGNMENT, vertices);
 
                 glEnableVertexAttribArray(0);
                 glVertexAttribPointer(0, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(Vertf), (void*)0);
+                                      GL_FALSE, sizeof(Vertf), (void*) base);
             }
             else if (vertexType == eVT_VertexPN)
             {
-                glBufferData(GL_ARRAY_BUFFER, sizeof(VertPNf) * verticesCount, vertices, GL_STATIC_DRAW);
+                base = upload(GL_ARRAY_BUFFER, mVertexBufferObject, mVertexRange, sizeof(VertPNf) * verticesCount, VERTEX_ALIGNMENT, vertices);
 
                 glEnableVertexAttribArray(0);
                 glVertexAttribPointer(0, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNf), (void*)0);
+                                      GL_FALSE, sizeof(VertPNf), (void*) base);
 
                 glEnableVertexAttribArray(1);
                 glVertexAttribPointer(1, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNf), (void*) sizeof(Vec3f));
+                                      GL_FALSE, sizeof(VertPNf), (void*) (base + sizeof(Vec3f)));
             }
             else if (vertexType == eVT_VertexPT)
             {
-                glBufferData(GL_ARRAY_BUFFER, sizeof(VertPTf) * verticesCount, vertices, GL_STATIC_DRAW);
+                base = upload(GL_ARRAY_BUFFER, mVertexBufferObject, mVertexRange, sizeof(VertPTf) * verticesCount, VERTEX_ALIGNMENT, vertices);
 
                 glEnableVertexAttribArray(0);
                 glVertexAttribPointer(0, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPTf), (void*)0);
+                                      GL_FALSE, sizeof(VertPTf), (void*) base);
 
                 glEnableVertexAttribArray(1);
                 glVertexAttribPointer(1, 2, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPTf), (void*) sizeof(Vec3f));
+                                      GL_FALSE, sizeof(VertPTf), (void*) (base + sizeof(Vec3f)));
             }
             else if (vertexType == eVT_VertexPNT)
             {
-                glBufferData(GL_ARRAY_BUFFER, sizeof(VertPNTf) * verticesCount, vertices, GL_STATIC_DRAW);
+                base = upload(GL_ARRAY_BUFFER, mVertexBufferObject, mVertexRange, sizeof(VertPNTf) * verticesCount, VERTEX_ALIGNMENT, vertices);
 
                 glEnableVertexAttribArray(0);
                 glVertexAttribPointer(0, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTf), (void*)0);
+                                      GL_FALSE, sizeof(VertPNTf), (void*) base);
 
                 glEnableVertexAttribArray(1);
                 glVertexAttribPointer(1, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTf), (void*) sizeof(Vec3f));
+                                      GL_FALSE, sizeof(VertPNTf), (void*) (base + sizeof(Vec3f)));
 
                 glEnableVertexAttribArray(2);
                 glVertexAttribPointer(2, 2, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTf), (void*) (2 * sizeof(Vec3f)));
+                                      GL_FALSE, sizeof(VertPNTf), (void*) (base + 2 * sizeof(Vec3f)));
             }
             else if (vertexType == eVT_VertexPNTBT)
             {
-                glBufferData(GL_ARRAY_BUFFER, sizeof(VertPNTBTf) * verticesCount, vertices, GL_STATIC_DRAW);
+                base = upload(GL_ARRAY_BUFFER, mVertexBufferObject, mVertexRange, sizeof(VertPNTBTf) * verticesCount, VERTEX_ALIGNMENT, vertices);
 
                 glEnableVertexAttribArray(0);
                 glVertexAttribPointer(0, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTBTf), (void*)0);
+                                      GL_FALSE, sizeof(VertPNTBTf), (void*) base);
 
                 glEnableVertexAttribArray(1);
                 glVertexAttribPointer(1, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTBTf), (void*) sizeof(Vec3f));
+                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (base + sizeof(Vec3f)));
 
                 glEnableVertexAttribArray(2);
                 glVertexAttribPointer(2, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (2 * sizeof(Vec3f)));
+                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (base + 2 * sizeof(Vec3f)));
 
                 glEnableVertexAttribArray(3);
                 glVertexAttribPointer(3, 3, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (3 * sizeof(Vec3f)));
+                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (base + 3 * sizeof(Vec3f)));
 
                 glEnableVertexAttribArray(4);
                 glVertexAttribPointer(4, 2, GL_FLOAT,
-                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (4 * sizeof(Vec3f)));
+                                      GL_FALSE, sizeof(VertPNTBTf), (void*) (base + 4 * sizeof(Vec3f)));
             }
             else
             {
                 FAIL(false, "Unknown vertex format [name: '%s']", mResourceName.get());
             }
 
-            glGenBuffers(1, &mElementBufferObject);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementBufferObject);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16) * indicesCount, indices, GL_STATIC_DRAW);
+            mIndicesOffset = (uint32) upload(GL_ELEMENT_ARRAY_BUFFER, mElementBufferObject, mIndexRange,
+                                             sizeof(uint16) * indicesCount, INDEX_ALIGNMENT, indices);
 
             glBindVertexArray(0);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -193,13 +202,35 @@ namespace Berserk
             glDrawElements(GLRenderDriver::getPrimitiveType(primitiveType),
                            count,
                            GLRenderDriver::getDataType(indicesType),
-                           nullptr);
+                           (void*) (uint64) mIndicesOffset);
         }
 
         void GLGPUBuffer::draw()
         {
             glBindVertexArray(mVertexArrayObject);
-            glDrawElements(mPrimitiveMode, mIndicesCount, mIndicesType, nullptr);
+            glDrawElements(mPrimitiveMode, mIndicesCount, mIndicesType, (void*) (uint64) mIndicesOffset);
+        }
+
+        uint64 GLGPUBuffer::upload(uint32 target, uint32 &object, GPUBufferRange &range,
+                                   uint32 size, uint32 alignment, const void *data)
+        {
+            // Sub-range of manager's shared buffer, if it is possible,
+            // otherwise (no manager or no space) own buffer object
+
+            if (mManager && mManager->allocateRange(size, alignment, range))
+            {
+                object = range.buffer;
+                glBindBuffer(target, object);
+                glBufferSubData(target, range.offset, size, data);
+
+                return range.offset;
+            }
+
+            glGenBuffers(1, &object);
+            glBindBuffer(target, object);
+            glBufferData(target, size, data, GL_STATIC_DRAW);
+
+            return 0;
         }
 
         IGPUBuffer::VertexType GLGPUBuffer::getVertexType()
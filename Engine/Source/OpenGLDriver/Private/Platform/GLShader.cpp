@@ -77,9 +77,9 @@ namespace Berserk
             return mResourceName.get();
         }
 
-        void GLShader::createProgram(PoolAllocator *pool)
+        void GLShader::createProgram(IAllocator *allocator)
         {
-            new(&mUniformMap) HashMap<CName,uint32>(CName::Hashing, pool);
+            new(&mUniformMap) OpenHashMap<CName,uint32>(HashTraits<CName>::hashing, OpenHashMap<CName,uint32>::DEFAULT_CAPACITY, allocator);
             mProgram = glCreateProgram();
             FAIL(mProgram, "Cannot create GL GPU program [name: '%s']", mResourceName.get());
         }
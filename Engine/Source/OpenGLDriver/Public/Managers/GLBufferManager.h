@@ -5,18 +5,27 @@
 #ifndef BERSERK_GLBUFFERMANAGER_H
 #define BERSERK_GLBUFFERMANAGER_H
 
+#include <mutex>
 #include "Platform/GLGPUBuffer.h"
 #include "Platform/GLDepthBuffer.h"
 #include "Platform/GLFrameBuffer.h"
 #include "Platform/GLUniformBuffer.h"
+#include "Misc/Buffers.h"
+#include "Containers/ArrayList.h"
 #include "Containers/LinkedList.h"
 #include "Managers/IBufferManager.h"
+#include "Threading/ConcurrentHashMap.h"
+#include "Strings/StaticString.h"
 
 namespace Berserk::Resources
 {
 
     /**
      * OpenGL platform bu manager implementation
+     *
+     * Lookup of buffers by name is thread-safe
+     *
+     * @warning Buffers are created on the calling thread (must have GL context)
      */
     class ENGINE_API GLBufferManager : public IBufferManager
     {
@@ -91,6 +100,15 @@ namespace Berserk::Resources
         /** @copydoc IBufferManager::getUniformBuffer() */
         IUniformBuffer* getUniformBuffer(const char* name) override;
 
+        /** @copydoc IBufferManager::allocateRange() */
+        bool allocateRange(uint32 size, uint32 alignment, GPUBufferRange& range) override;
+
+        /** @copydoc IBufferManager::freeRange() */
+        void freeRange(GPUBufferRange& range) override;
+
+        /** @copydoc IBufferManager::getRangeStats() */
+        void getRangeStats(BuddyRangeAllocator::Stats& stats) override;
+
         /** @copydoc IBufferManager::getMemoryUsage() */
         uint32 getMemoryUsage() override;
 
@@ -99,6 +117,27 @@ namespace Berserk::Resources
 
     private:
 
+        /** Shared gpu buffer, which is split in ranges */
+        struct Page
+        {
+            uint32 handle;                      // GL buffer object [or 0 if page is released]
+            BuddyRangeAllocator* allocator;     // Ranges of the buffer
+        };
+
+        /** @return Index of new page with at least size bytes */
+        uint32 createPage(uint32 size);
+
+        /** Deletes GL buffer and allocator of page (slot is reused later) */
+        void releasePage(uint32 index);
+
+    private:
+
+        /** Default size of shared gpu buffer for ranges */
+        static const uint32 PAGE_SIZE = Buffers::MiB * 16;
+
+        /** Number of pages slots to preallocate */
+        static const uint32 INITIAL_PAGES_COUNT = Buffers::SIZE_16;
+
         /** Number of gpu buffers to preallocate in buffer (and the expand by that value) */
         static const uint32 INITIAL_GPUBUFFERS_COUNT     = 100;
 
@@ -111,11 +150,22 @@ namespace Berserk::Resources
         /** Number of uniform buffers to preallocate in buffer (and the expand by that value) */
         static const uint32 INITIAL_UNIFORMBUFFERS_COUNT = 20;
 
+        /** Guards storage of resources (lists are not thread-safe) */
+        std::mutex mStorageMutex;
+
         LinkedList<GLGPUBuffer>     mGPUBuffers;
         LinkedList<GLFrameBuffer>   mFrameBuffers;
         LinkedList<GLDepthBuffer>   mDepthBuffers;
         LinkedList<GLUniformBuffer> mUniformBuffers;
 
+        /** Resources lookup by name */
+        ConcurrentHashMap<CText, GLGPUBuffer*>     mGPUBuffersMap;
+        ConcurrentHashMap<CText, GLFrameBuffer*>   mFrameBuffersMap;
+        ConcurrentHashMap<CText, GLDepthBuffer*>   mDepthBuffersMap;
+        ConcurrentHashMap<CText, GLUniformBuffer*> mUniformBuffersMap;
+
+        ArrayList<Page> mPages;
+
     };
 
 } // namespace Berserk::Resources
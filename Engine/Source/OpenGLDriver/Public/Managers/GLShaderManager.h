@@ -5,15 +5,23 @@
 #ifndef BERSERK_GLSHADERMANAGER_H
 #define BERSERK_GLSHADERMANAGER_H
 
+#include <mutex>
 #include "Platform/GLShader.h"
 #include "Containers/LinkedList.h"
 #include "Managers/IShaderManager.h"
+#include "Threading/ConcurrentHashMap.h"
+#include "Strings/StaticString.h"
 
 namespace Berserk::Resources
 {
 
     /**
     * OpenGL platform shader manager implementation
+    *
+    * Lookup and loading by name are thread-safe: concurrent loads
+    * of the same program compile it once (the others wait for it)
+    *
+    * @warning Programs are created on the calling thread (must have GL context)
     */
     class ENGINE_API GLShaderManager : public IShaderManager
     {
@@ -55,14 +63,24 @@ namespace Berserk::Resources
         /** @copydoc IShaderManager::getMemoryUsage() */
         void getMemoryUsage(MemorySizer* sizer) override;
 
+    private:
+
+        /** @return Program imported from xml node in storage [or nullptr if failed to import] */
+        GLShader* importShader(const char* program, XMLNode& node);
+
     private:
 
         /** Number of shaders to preallocate in buffer (and the expand by that value) */
         static const uint32 INITIAL_SHADERS_COUNT = 20;
 
         CString mPath;
+        /** Guards storage of resources (list is not thread-safe) */
+        std::mutex mStorageMutex;
+
         LinkedList<GLShader> mShaders;
-        PoolAllocator mShadersUniformsPool;
+
+        /** Resources lookup by name */
+        ConcurrentHashMap<CText, GLShader*> mShadersMap;
 
     };
 
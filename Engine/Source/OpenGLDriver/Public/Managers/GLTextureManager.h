@@ -5,10 +5,13 @@
 #ifndef BERSERK_GLTEXTUREMANAGER_H
 #define BERSERK_GLTEXTUREMANAGER_H
 
+#include <mutex>
 #include "Platform/GLTexture.h"
 #include "Platform/GLSampler.h"
 #include "Containers/LinkedList.h"
 #include "Managers/ITextureManager.h"
+#include "Threading/ConcurrentHashMap.h"
+#include "Strings/StaticString.h"
 #include "Strings/String.h"
 
 namespace Berserk::Resources
@@ -16,6 +19,11 @@ namespace Berserk::Resources
 
     /**
      * OpenGL platform texture manager implementation
+     *
+     * Lookup and loading by name are thread-safe: concurrent loads
+     * of the same texture import it once (the others wait for it)
+     *
+     * @warning Textures are created on the calling thread (must have GL context)
      */
     class ENGINE_API GLTextureManager : public ITextureManager
     {
@@ -99,6 +107,11 @@ namespace Berserk::Resources
         /** @copydoc ITextureManager::getMemoryUsage() */
         void getMemoryUsage(MemorySizer* sizer) override;
 
+    private:
+
+        /** @return Texture imported from file in storage [or nullptr if failed to import] */
+        GLTexture* importTexture(const char* path, const char* name);
+
     private:
 
         /** Number of textures to preallocate in buffer (and the expand by that value) */
@@ -107,9 +120,16 @@ namespace Berserk::Resources
         /** Number of samplers to preallocate in buffer (and the expand by that value) */
         static const uint32 INITIAL_SAMPLERS_COUNT = 10;
 
+        /** Guards storage of resources (lists are not thread-safe) */
+        std::mutex mStorageMutex;
+
         LinkedList<GLTexture> mTextures;
         LinkedList<GLSampler> mSamplers;
 
+        /** Resources lookup by name */
+        ConcurrentHashMap<CText, GLTexture*> mTexturesMap;
+        ConcurrentHashMap<CText, GLSampler*> mSamplersMap;
+
         ITexture* mDefaultTexture;
         ITexture* mDefaultHelperTexture;
 
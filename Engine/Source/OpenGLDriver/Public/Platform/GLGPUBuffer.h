@@ -6,6 +6,7 @@
 #define BERSERK_GLGPUBUFFER_H
 
 #include "Platform/IGPUBuffer.h"
+#include "Managers/IBufferManager.h"
 #include "Strings/String.h"
 
 namespace Berserk
@@ -67,10 +68,31 @@ namespace Berserk
             /** @copydoc IGPUBuffer::getGPUMemoryUsage() */
             uint32 getGPUMemoryUsage() override;
 
+        protected:
+
+            /**
+             * Fills buffer object with data: allocates range in shared buffer
+             * of the manager or creates own buffer object (if range is not available)
+             * @return Offset of data in buffer object
+             */
+            uint64 upload(uint32 target, uint32 &object, GPUBufferRange &range,
+                          uint32 size, uint32 alignment, const void* data);
+
         protected:
 
             friend class GLBufferManager;
 
+            /** Alignment of vertex data range in shared buffer */
+            static const uint32 VERTEX_ALIGNMENT = 16;
+
+            /** Alignment of index data range in shared buffer */
+            static const uint32 INDEX_ALIGNMENT = 4;
+
+            IBufferManager* mManager;       // Manager with shared buffers [or nullptr if buffer owns its data]
+            GPUBufferRange mVertexRange;    // Range of vertex data in shared buffer [or null]
+            GPUBufferRange mIndexRange;     // Range of index data in shared buffer [or null]
+            uint32 mIndicesOffset;          // Offset of indices in element buffer object
+
             uint32 mVertexArrayObject;      // Buffer VAO handle
             uint32 mElementBufferObject;    // Buffer VBO handle for vertexes' attributes
             uint32 mVertexBufferObject;     // Buffer EBO handle for indices of vertexes
@@ -5,7 +5,7 @@
 #ifndef BERSERK_GLSHADER_H
 #define BERSERK_GLSHADER_H
 
-#include "Containers/HashMap.h"
+#include "Containers/OpenHashMap.h"
 #include "Strings/String.h"
 #include "Platform/IShader.h"
 #include "Platform/GLRenderDriver.h"
@@ -47,7 +47,7 @@ namespace Berserk
         public:
 
             /** @copydoc IShader::createProgram() */
-            void createProgram(PoolAllocator *pool) override;
+            void createProgram(IAllocator *allocator = nullptr) override;
 
             /** @copydoc IShader::link() */
             void attachShader(IRenderDriver::ShaderType type, const char *source, const char *filename) override;
@@ -136,7 +136,7 @@ namespace Berserk
             uint32 mReferenceCount;                                 // Reference count to this shader program
             uint32 mShaders[GLRenderDriver::MAX_SHADER_COUNT];      // Ids of shaders linked to the gpu program
             CString mResourceName;                                  // C-string name of resource
-            HashMap<CName, uint32> mUniformMap;                     // Mapping of uniform variables to its locations
+            OpenHashMap<CName, uint32> mUniformMap;                 // Mapping of uniform variables to its locations
 
         };
 
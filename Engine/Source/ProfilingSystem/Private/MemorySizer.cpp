@@ -3,6 +3,7 @@
 //
 
 #include "MemorySizer.h"
+#include "Memory/Allocator.h"
 #include "Profiling/ProfilingUtility.h"
 
 namespace Berserk
@@ -71,6 +72,30 @@ namespace Berserk
         }
     }
 
+    MemorySizer::ProfilingNode * MemorySizer::addAllocationStats(const char *name)
+    {
+        // Snapshot is too big for the stack of worker threads
+        auto snapshot = (AllocationStats::Snapshot*) Allocator::getSingleton().allocate(sizeof(AllocationStats::Snapshot));
+        AllocationStats::snapshot(*snapshot);
+
+        uint64 total = 0;
+        for (uint32 i = 0; i < snapshot->channelsCount; i++)
+        {
+            if (!snapshot->channels[i].isTag) total += snapshot->channels[i].liveBytes;
+        }
+
+        auto root = addObject(name, (uint32) total);
+
+        for (uint32 i = 0; i < snapshot->channelsCount; i++)
+        {
+            auto& channel = snapshot->channels[i];
+            if (!channel.isTag) addChild(root, channel.name, (uint32) channel.liveBytes);
+        }
+
+        Allocator::getSingleton().free(snapshot);
+        return root;
+    }
+
     HashMap<const char *, MemorySizer::ProfilingNode> * MemorySizer::getProfilingInfo()
     {
         return &mProfilingInfo;
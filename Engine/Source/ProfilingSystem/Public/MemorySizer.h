@@ -8,6 +8,7 @@
 #include "Misc/Types.h"
 #include "Misc/UsageDescriptors.h"
 #include "Containers/HashMap.h"
+#include "Profiling/AllocationStats.h"
 
 namespace Berserk
 {
@@ -97,6 +98,14 @@ namespace Berserk
          */
         ProfilingNode* addNext(ProfilingNode *node, const char *name, uint32 cpuMem, uint32 gpuMem = 0);
 
+        /**
+         * Add runtime allocation statistics: root node with live bytes of
+         * all the tracked allocators and one child per each allocator
+         *
+         * @param name Name of the root node
+         */
+        ProfilingNode* addAllocationStats(const char *name = "Allocations");
+
         /** @return Pointer ot internal data */
         HashMap<const char*, ProfilingNode>* getProfilingInfo();
 
@@ -23,4 +23,6 @@ namespace Berserk::Render
 
     IImageImporter* RenderBase::mImageImporter = nullptr;
 
+    RelocatableHeap* RenderBase::mResourceHeap = nullptr;
+
 } // namespace Berserk::Render
\ No newline at end of file
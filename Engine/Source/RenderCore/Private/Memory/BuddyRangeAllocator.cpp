@@ -0,0 +1,268 @@
+//
+// Created by Egor Orachyov on 26.02.2019.
+//
+
+#include "Memory/BuddyRangeAllocator.h"
+#include "Memory/Allocator.h"
+#include "Misc/Assert.h"
+#include "Misc/Include.h"
+
+namespace Berserk::Resources
+{
+
+    /** @return True if value is not zero power of 2 */
+    static bool isPowerOf2(uint32 value)
+    {
+        return (value != 0) && ((value & (value - 1)) == 0);
+    }
+
+    /** @return log2 of power of 2 value */
+    static uint32 getShift(uint32 value)
+    {
+        return 31 - (uint32) __builtin_clz(value);
+    }
+
+    BuddyRangeAllocator::BuddyRangeAllocator(uint32 size, uint32 minBlockSize, IAllocator *allocator)
+            : mSize(size),
+              mMinBlockSize(minBlockSize),
+              mUsedSize(0),
+              mAllocationsCount(0)
+    {
+        FAIL(isPowerOf2(size), "BuddyRangeAllocator: size must be power of 2 [%u]", size);
+        FAIL(isPowerOf2(minBlockSize), "BuddyRangeAllocator: min block size must be power of 2 [%u]", minBlockSize);
+        FAIL(minBlockSize <= size, "BuddyRangeAllocator: min block size %u is more than size %u", minBlockSize, size);
+
+        if (allocator) mAllocator = allocator;
+        else mAllocator = &Allocator::getSingleton();
+
+        mMinBlockShift = getShift(minBlockSize);
+        mMaxOrder = getShift(size) - mMinBlockShift;
+        mNodesCount = (2u << mMaxOrder) - 1;
+        mTree = (uint8*) mAllocator->allocate(mNodesCount);
+
+        // Initially each node is whole free block of its order
+
+        for (uint32 level = 0; level <= mMaxOrder; level++)
+        {
+            uint32 first = (1u << level) - 1;
+            uint32 count = (1u << level);
+            memset(mTree + first, mMaxOrder - level + 1, count);
+        }
+    }
+
+    BuddyRangeAllocator::~BuddyRangeAllocator()
+    {
+        if (mTree)
+        {
+            mAllocator->free(mTree);
+            mTree = nullptr;
+        }
+    }
+
+    uint32 BuddyRangeAllocator::allocate(uint32 size, uint32 alignment)
+    {
+        FAIL(isPowerOf2(alignment), "BuddyRangeAllocator: alignment must be power of 2 [%u]", alignment);
+
+        uint32 order = getOrder(size, alignment);
+        if (order > mMaxOrder || mTree[0] < order + 1) return INVALID_OFFSET;
+
+        uint32 index = 0;
+        uint32 current = mMaxOrder;
+
+        while (current != order)
+        {
+            uint32 left = 2 * index + 1;
+            uint32 right = left + 1;
+
+            // Best fit: go in the subtree with the smaller suitable block,
+            // so big free blocks are not split while small ones exist
+
+            bool leftFits = mTree[left] >= order + 1;
+            bool rightFits = mTree[right] >= order + 1;
+
+            if (leftFits && rightFits) index = (mTree[right] < mTree[left] ? right : left);
+            else index = (leftFits ? left : right);
+
+            current -= 1;
+        }
+
+        reserve(index, order);
+        return getOffset(index, order);
+    }
+
+    void BuddyRangeAllocator::free(uint32 offset)
+    {
+        uint32 order;
+        uint32 index = findNode(offset, order);
+
+        mTree[index] = (uint8)(order + 1);
+        updateParents(index, order);
+
+        mUsedSize -= (mMinBlockSize << order);
+        mAllocationsCount -= 1;
+    }
+
+    uint32 BuddyRangeAllocator::getBlockSize(uint32 offset) const
+    {
+        uint32 order;
+        findNode(offset, order);
+
+        return (mMinBlockSize << order);
+    }
+
+    bool BuddyRangeAllocator::canAllocate(uint32 size, uint32 alignment) const
+    {
+        uint32 order = getOrder(size, alignment);
+        return order <= mMaxOrder && mTree[0] >= order + 1;
+    }
+
+    bool BuddyRangeAllocator::relocate(uint32 &source, uint32 &destination)
+    {
+        // Find for each order the first allocated block with free buddy
+        // and up to two maximal free blocks (the whole free block, which
+        // is not part of bigger free one)
+
+        const uint32 NONE = 0xffffffff;
+
+        uint32 candidate = NONE;
+        uint32 candidateOrder = 0;
+        uint32 destinationIndex = NONE;
+
+        for (uint32 level = mMaxOrder; level > 0 && candidate == NONE; level--)
+        {
+            uint32 order = mMaxOrder - level;
+            uint32 first = (1u << level) - 1;
+            uint32 last = first + (1u << level);
+
+            uint32 freeBlocks[2] = { NONE, NONE };
+            uint32 allocated = NONE;
+
+            for (uint32 index = first; index < last; index++)
+            {
+                // Parent with value 0 here is allocated block itself
+                // (fully used parent could not have free child)
+
+                uint32 parent = (index - 1) / 2;
+                bool isMaximal = mTree[parent] != order + 2 && mTree[parent] != 0;
+
+                if (mTree[index] == order + 1 && isMaximal)
+                {
+                    if (freeBlocks[0] == NONE) freeBlocks[0] = index;
+                    else if (freeBlocks[1] == NONE) freeBlocks[1] = index;
+                }
+
+                // Allocated block: used node, which children are not used
+                // (children of allocated block keep their free values)
+
+                bool isAllocated = mTree[index] == 0 && (order == 0 || mTree[2 * index + 1] != 0);
+                uint32 buddy = (index % 2 == 1 ? index + 1 : index - 1);
+
+                if (isAllocated && allocated == NONE && mTree[buddy] == order + 1)
+                {
+                    allocated = index;
+                }
+            }
+
+            if (allocated != NONE && freeBlocks[1] != NONE)
+            {
+                // One of free blocks is buddy of allocated one, take another
+
+                uint32 buddy = (allocated % 2 == 1 ? allocated + 1 : allocated - 1);
+
+                candidate = allocated;
+                candidateOrder = order;
+                destinationIndex = (freeBlocks[0] != buddy ? freeBlocks[0] : freeBlocks[1]);
+            }
+        }
+
+        if (candidate == NONE) return false;
+
+        reserve(destinationIndex, candidateOrder);
+
+        source = getOffset(candidate, candidateOrder);
+        destination = getOffset(destinationIndex, candidateOrder);
+
+        return true;
+    }
+
+    void BuddyRangeAllocator::getStats(Stats &stats) const
+    {
+        stats.size = mSize;
+        stats.usedSize = mUsedSize;
+        stats.freeSize = mSize - mUsedSize;
+        stats.largestFreeBlock = getLargestFreeBlock();
+        stats.allocationsCount = mAllocationsCount;
+        stats.fragmentation = (stats.freeSize > 0 ? 1.0f - (float)stats.largestFreeBlock / (float)stats.freeSize : 0.0f);
+    }
+
+    uint32 BuddyRangeAllocator::getOrder(uint32 size, uint32 alignment) const
+    {
+        // Block of order k has size and alignment of min block size * 2^k
+
+        uint64 blockSize = mMinBlockSize;
+        if (blockSize < alignment) blockSize = alignment;
+
+        uint32 order = 0;
+        while (((uint64)mMinBlockSize << order) < blockSize || ((uint64)mMinBlockSize << order) < size) order += 1;
+
+        return order;
+    }
+
+    uint32 BuddyRangeAllocator::findNode(uint32 offset, uint32 &order) const
+    {
+        FAIL(offset < mSize && (offset & (mMinBlockSize - 1)) == 0, "BuddyRangeAllocator: invalid offset [%u]", offset);
+
+        // Walk up from the leaf: the first used node is the allocated block
+        // (nodes inside allocated block keep their free values)
+
+        uint32 index = (1u << mMaxOrder) - 1 + (offset >> mMinBlockShift);
+        order = 0;
+
+        while (mTree[index] != 0)
+        {
+            FAIL(index != 0, "BuddyRangeAllocator: range is not allocated [offset: %u]", offset);
+
+            index = (index - 1) / 2;
+            order += 1;
+        }
+
+        FAIL(getOffset(index, order) == offset, "BuddyRangeAllocator: offset is not start of block [offset: %u]", offset);
+
+        return index;
+    }
+
+    void BuddyRangeAllocator::reserve(uint32 index, uint32 order)
+    {
+        mTree[index] = 0;
+        updateParents(index, order);
+
+        mUsedSize += (mMinBlockSize << order);
+        mAllocationsCount += 1;
+    }
+
+    void BuddyRangeAllocator::updateParents(uint32 index, uint32 order)
+    {
+        while (index != 0)
+        {
+            index = (index - 1) / 2;
+            order += 1;
+
+            uint8 left = mTree[2 * index + 1];
+            uint8 right = mTree[2 * index + 2];
+
+            // Both children are whole free blocks: they merge
+
+            if (left == order && right == order) mTree[index] = (uint8)(order + 1);
+            else mTree[index] = (left > right ? left : right);
+        }
+    }
+
+    uint32 BuddyRangeAllocator::getOffset(uint32 index, uint32 order) const
+    {
+        uint32 level = mMaxOrder - order;
+        uint32 first = (1u << level) - 1;
+
+        return (index - first) << (order + mMinBlockShift);
+    }
+
+} // namespace Berserk::Resources
@@ -48,11 +48,26 @@ namespace Berserk::Render
         /** Register a primitive component to be rendered */
         virtual void registerComponent(StaticMeshComponent *component) = 0;
 
+        /** Remove light source from the rendering */
+        virtual void unregisterComponent(SpotLightComponent *component) = 0;
+
+        /** Remove light source from the rendering */
+        virtual void unregisterComponent(PointLightComponent *component) = 0;
+
+        /** Remove light source from the rendering */
+        virtual void unregisterComponent(DirectionalLightComponent *component) = 0;
+
+        /** Remove primitive component from the rendering */
+        virtual void unregisterComponent(StaticMeshComponent *component) = 0;
+
     public:
 
         /** @return Current frame number */
         uint64 getCurrentFrameNumber() { return mCurrentFrameNumber; }
 
+        /** @return Transient memory of the current frame [or nullptr] */
+        FrameAllocator* getFrameAllocator() { return mFrameAllocator; }
+
         /** @return General render system settings info [can modify] */
         RenderSettings& getSettings() { return mSettings; }
 
@@ -67,6 +82,9 @@ namespace Berserk::Render
         /** Frames counter */
         uint64 mCurrentFrameNumber = 0;
 
+        /** Per-frame arenas (frames are started and retired by render system) */
+        FrameAllocator* mFrameAllocator = nullptr;
+
         /** General settings of the render system */
         RenderSettings mSettings;
 
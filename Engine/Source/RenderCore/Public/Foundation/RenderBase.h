@@ -14,6 +14,7 @@
 #include <Importers/IImageImporter.h>
 #include <Platform/IWindow.h>
 #include <Platform/IRenderDriver.h>
+#include <Memory/RelocatableHeap.h>
 
 namespace Berserk::Render
 {
@@ -55,6 +56,9 @@ namespace Berserk::Render
         /** @return 3D Engine ImageImporter pointer */
         static IImageImporter* getIImageImporter()          { return mImageImporter; }
 
+        /** @return 3D Engine heap for CPU-side copies of resources data */
+        static RelocatableHeap* getResourceHeap()          { return mResourceHeap; }
+
     protected:
 
         friend class RenderSystem;
@@ -77,6 +81,8 @@ namespace Berserk::Render
 
         static class IImageImporter* mImageImporter;
 
+        static class RelocatableHeap* mResourceHeap;
+
     };
 
 } // namespace Berserk
@@ -12,10 +12,25 @@
 #include "Platform/IFrameBuffer.h"
 #include "Platform/IUniformBuffer.h"
 #include "MemorySizer.h"
+#include "Memory/BuddyRangeAllocator.h"
 
 namespace Berserk::Resources
 {
 
+    /**
+     * Range of one of large gpu buffers, shared by many resources
+     * (allocated via IBufferManager::allocateRange())
+     */
+    struct GPUBufferRange
+    {
+        uint32 buffer = 0;                                      // Platform handle of shared buffer
+        uint32 page = 0;                                        // Index of shared buffer in the manager
+        uint32 offset = BuddyRangeAllocator::INVALID_OFFSET;    // Offset of range in shared buffer
+        uint32 size = 0;                                        // Size of allocated block
+
+        bool isNull() const { return offset == BuddyRangeAllocator::INVALID_OFFSET; }
+    };
+
     /**
      * An interface which provides access to the buffer manager implemented in 3D Rendering System.
      * Responsible for creating and finding buffers of different type Engine system.
@@ -90,6 +105,21 @@ namespace Berserk::Resources
         /** @return Pointer to resource with incrementing reference count */
         virtual IUniformBuffer* getUniformBuffer(const char* name) = 0;
 
+        /**
+         * Allocates range in one of shared gpu buffers (new buffer is created if needed)
+         * @param size      Size of range in bytes
+         * @param alignment Power of 2 alignment of range offset
+         * @param[out] range Allocated range
+         * @return True if range is allocated
+         */
+        virtual bool allocateRange(uint32 size, uint32 alignment, GPUBufferRange& range) = 0;
+
+        /** Frees range (empty shared buffers could be released) and nullifies it */
+        virtual void freeRange(GPUBufferRange& range) = 0;
+
+        /** Writes summary occupancy of all shared gpu buffers in stats */
+        virtual void getRangeStats(BuddyRangeAllocator::Stats& stats) = 0;
+
         /** @return Memory usage on CPU (RAM) side */
         virtual uint32 getMemoryUsage() = 0;
 
@@ -0,0 +1,149 @@
+//
+// Created by Egor Orachyov on 26.02.2019.
+//
+
+#ifndef BERSERK_BUDDYRANGEALLOCATOR_H
+#define BERSERK_BUDDYRANGEALLOCATOR_H
+
+#include "Misc/Types.h"
+#include "Misc/UsageDescriptors.h"
+#include "Object/NewDelete.h"
+#include "Memory/IAllocator.h"
+
+namespace Berserk::Resources
+{
+
+    /**
+     * Buddy allocator of offset ranges in one large buffer. Manages only
+     * offsets (buffer memory is never touched), therefore could be used for
+     * sub-allocation in gpu buffers and does not require rendering context.
+     *
+     * Range of size is split in blocks of power of 2 sizes (from min block
+     * size up to whole range). Each block starts at offset, multiple of its
+     * size, so alignment of range is achieved by rounding up block size.
+     *
+     * Blocks are kept in implicit binary tree: each node stores the biggest
+     * free block in its subtree, so allocate / free take O(log n) and the
+     * biggest free block is known at once.
+     *
+     * Supports defragmentation hints: relocate() finds allocated block, which
+     * prevents merge of its free buddy, and reserves another free block of the
+     * same size. After the data is copied, old block is freed and the buddies merge.
+     */
+    class ENGINE_API BuddyRangeAllocator
+    {
+    public:
+
+        /** Returned if range could not be allocated */
+        static const uint32 INVALID_OFFSET = 0xffffffff;
+
+        /** Default min block size (granularity of allocations) */
+        static const uint32 DEFAULT_MIN_BLOCK_SIZE = 256;
+
+        /** Occupancy of the range */
+        struct Stats
+        {
+            uint32 size;                // Size of the whole range
+            uint32 usedSize;            // Size of allocated blocks
+            uint32 freeSize;            // Size of free blocks
+            uint32 largestFreeBlock;    // Size of the biggest free block
+            uint32 allocationsCount;    // Number of allocated blocks
+            float  fragmentation;       // 1 - largest free block / free size (0 if all free memory is continuous)
+        };
+
+    public:
+
+        /**
+         * Creates allocator for empty range
+         * @param size         Size of range (power of 2)
+         * @param minBlockSize Min size of allocated block (power of 2, not more than size)
+         * @param allocator    Allocator for blocks tree [or default engine allocator if nullptr]
+         */
+        explicit BuddyRangeAllocator(uint32 size,
+                                     uint32 minBlockSize = DEFAULT_MIN_BLOCK_SIZE,
+                                     IAllocator* allocator = nullptr);
+
+        ~BuddyRangeAllocator();
+
+        GEN_NEW_DELETE(BuddyRangeAllocator);
+
+        /**
+         * Allocates range of at least size bytes
+         * @param size      Size of range in bytes
+         * @param alignment Power of 2 alignment of offset
+         * @return Offset of range [or INVALID_OFFSET if there is no suitable free block]
+         */
+        uint32 allocate(uint32 size, uint32 alignment = 1);
+
+        /** Frees range, allocated at offset */
+        void free(uint32 offset);
+
+        /** @return Size of block, allocated at offset */
+        uint32 getBlockSize(uint32 offset) const;
+
+        /** @return True if range of size with alignment could be allocated now */
+        bool canAllocate(uint32 size, uint32 alignment = 1) const;
+
+        /**
+         * Defragmentation hint: finds the smallest allocated block, which has
+         * free buddy, while other free block of the same size exists, and
+         * reserves that other block. Caller copies data and frees source.
+         *
+         * @param[out] source      Offset of block to move
+         * @param[out] destination Offset of reserved block (allocated)
+         * @return True if relocation is found
+         */
+        bool relocate(uint32 &source, uint32 &destination);
+
+        /** Writes occupancy of the range in stats */
+        void getStats(Stats &stats) const;
+
+        /** @return Size of the whole range */
+        uint32 getSize() const { return mSize; }
+
+        /** @return Size of allocated blocks */
+        uint32 getUsedSize() const { return mUsedSize; }
+
+        /** @return Size of the biggest free block */
+        uint32 getLargestFreeBlock() const { return (mTree[0] ? mMinBlockSize << (mTree[0] - 1) : 0); }
+
+        /** @return Number of allocated blocks */
+        uint32 getAllocationsCount() const { return mAllocationsCount; }
+
+        /** @return Size of memory used by this allocator on CPU side */
+        uint32 getMemoryUsage() const { return sizeof(BuddyRangeAllocator) + mNodesCount; }
+
+    private:
+
+        /** @return Order of block for range of size with alignment [or max order + 1 if too big] */
+        uint32 getOrder(uint32 size, uint32 alignment) const;
+
+        /** @return Node of allocated block with offset */
+        uint32 findNode(uint32 offset, uint32 &order) const;
+
+        /** Marks node as allocated and updates its parents */
+        void reserve(uint32 index, uint32 order);
+
+        /** Recomputes the biggest free blocks of parents of node with order */
+        void updateParents(uint32 index, uint32 order);
+
+        /** @return Offset of node with order */
+        uint32 getOffset(uint32 index, uint32 order) const;
+
+    private:
+
+        IAllocator* mAllocator;     // Allocator for blocks tree
+        uint8*  mTree;              // Order + 1 of the biggest free block in subtree of each node [0 if all used]
+        uint32  mNodesCount;        // Number of nodes in the tree
+        uint32  mMaxOrder;          // Order of the root (whole range)
+        uint32  mSize;              // Size of the whole range
+        uint32  mMinBlockSize;      // Size of block of order 0
+        uint32  mMinBlockShift;     // log2 of min block size
+        uint32  mUsedSize;          // Size of allocated blocks
+        uint32  mAllocationsCount;  // Number of allocated blocks
+
+    };
+
+} // namespace Berserk::Resources
+
+#endif //BERSERK_BUDDYRANGEALLOCATOR_H
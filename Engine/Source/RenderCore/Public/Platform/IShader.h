@@ -11,7 +11,7 @@
 #include "Math/MathInclude.h"
 #include "Resource/IResource.h"
 #include "Platform/IRenderDriver.h"
-#include "Memory/PoolAllocator.h"
+#include "Memory/IAllocator.h"
 
 namespace Berserk
 {
@@ -28,8 +28,11 @@ namespace Berserk
 
             virtual ~IShader() = default;
 
-            /** Creates gpu program object */
-            virtual void createProgram(PoolAllocator *pool) = 0;
+            /**
+             * Creates gpu program object
+             * @param allocator Allocator for uniform variables table [or nullptr for default]
+             */
+            virtual void createProgram(IAllocator *allocator = nullptr) = 0;
 
             /** Attach shader from source and type to the created program */
             virtual void attachShader(IRenderDriver::ShaderType shaderType, const char *source, const char *filename) = 0;
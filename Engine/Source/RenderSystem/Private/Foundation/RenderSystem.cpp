@@ -11,6 +11,7 @@
 
 #include <Info/ImageImporter.h>
 #include <Info/VideoDriver.h>
+#include <Profiling/FrameAllocationCheck.h>
 
 #ifdef USE_OPEN_GL
 #include <Platform/GLRenderDriver.h>
@@ -28,9 +29,14 @@ namespace Berserk::Render
 
     RenderSystem::RenderSystem(const ISystemInitializer &systemInitializer)
             : IRenderSystem(systemInitializer),
-              mGenAllocator(systemInitializer.getAllocator())
+              mGenAllocator(systemInitializer.getAllocator()),
+              mSpotLightSources(SlotMap<SpotLightComponent*>::DEFAULT_INITIAL_SIZE, systemInitializer.getAllocator()),
+              mPointLightSources(SlotMap<PointLightComponent*>::DEFAULT_INITIAL_SIZE, systemInitializer.getAllocator()),
+              mDirLightSources(SlotMap<DirectionalLightComponent*>::DEFAULT_INITIAL_SIZE, systemInitializer.getAllocator()),
+              mStaticMeshes(SlotMap<StaticMeshComponent*>::DEFAULT_INITIAL_SIZE, systemInitializer.getAllocator())
     {
         auto allocator = systemInitializer.getAllocator();
+        mFrameAllocator = systemInitializer.getFrameAllocator();
 
 #ifdef USE_FREE_IMAGE
         mImageImporter = new (allocator->allocate(sizeof(Importers::FreeImageImporter))) FreeImageImporter();
@@ -49,10 +55,16 @@ namespace Berserk::Render
         mMaterialManager    = new (allocator->allocate(sizeof(MaterialManager)))   MaterialManager(mTextureManager, "../Engine/Materials");
         mPipelineScheduler  = new (allocator->allocate(sizeof(PipelineScheduler))) PipelineScheduler(allocator);
         mDebugRenderManager = new (allocator->allocate(sizeof(DebugDrawManager)))  DebugDrawManager(allocator);
+        mResourceHeap       = new (allocator->allocate(sizeof(RelocatableHeap)))   RelocatableHeap(RelocatableHeap::DEFAULT_BUFFER_SIZE, allocator);
+
+#if CHECK_FRAME_ALLOCATIONS
+        FrameAllocationCheck::enable(FrameAllocationCheck::DEFAULT_WARM_UP_FRAMES, CHECK_FRAME_ALLOCATIONS == 2);
+#endif
     }
 
     RenderSystem::~RenderSystem()
     {
+        delete (mResourceHeap);
         delete (mDebugRenderManager);
         delete (mPipelineScheduler);
         delete (mMaterialManager);
@@ -62,6 +74,7 @@ namespace Berserk::Render
         delete (mImageImporter);
         delete (mRenderDriver);
 
+        mGenAllocator->free(mResourceHeap);
         mGenAllocator->free(mDebugRenderManager);
         mGenAllocator->free(mPipelineScheduler);
         mGenAllocator->free(mMaterialManager);
@@ -79,13 +92,18 @@ namespace Berserk::Render
 
     void RenderSystem::preUpdate()
     {
-
+        // Steady-state frame must not call general heap:
+        // its allocations are recorded until the end of postUpdate
+        FrameAllocationCheck::beginFrame();
     }
 
     void RenderSystem::update()
     {
         RenderPassInfo passInfo;
 
+        // Debug requests, submitted in the previous frame, are rendered in this one
+        mDebugRenderManager->update();
+
         mPipelineScheduler->execute(passInfo);
 
         // Swap buffers after all the rendering pipeline stages
@@ -96,8 +114,20 @@ namespace Berserk::Render
 
     void RenderSystem::postUpdate()
     {
+        // Rendering is the last consumer of frame data: its
+        // arena could be reused when the ring wraps around
+        if (mFrameAllocator) mFrameAllocator->retireFrame();
+
         // Increase frame number (in the end of the updates)
         mCurrentFrameNumber += 1;
+
+        if (mFrameAllocator) mFrameAllocator->beginFrame();
+
+        // Blocks of resources data are moved only between frames,
+        // when nobody keeps pointers to them
+        mResourceHeap->compact(RESOURCE_HEAP_COMPACTION_BUDGET);
+
+        FrameAllocationCheck::endFrame();
     }
 
     void RenderSystem::destroy()
@@ -107,74 +137,66 @@ namespace Berserk::Render
 
     void RenderSystem::registerComponent(SpotLightComponent *component)
     {
-        if (component->mPrev || component->mNext)
-        {
-            FAIL(false, "An attempt to pass registered component [name: '%s']", component->getName());
-            return;
-        }
-
-        if (mSpotLightSources)
-        {
-            component->mNext = mSpotLightSources;
-            mSpotLightSources->mPrev = component;
-        }
-
-        mSpotLightSources = component;
-        mSpotLightSourcesCount += 1;
+        registerIn(mSpotLightSources, component);
     }
 
     void RenderSystem::registerComponent(PointLightComponent *component)
     {
-        if (component->mPrev || component->mNext)
-        {
-            FAIL(false, "An attempt to pass registered component [name: '%s']", component->getName());
-            return;
-        }
+        registerIn(mPointLightSources, component);
+    }
 
-        if (mPointLightSources)
-        {
-            component->mNext = mPointLightSources;
-            mPointLightSources->mPrev = component;
-        }
+    void RenderSystem::registerComponent(DirectionalLightComponent *component)
+    {
+        registerIn(mDirLightSources, component);
+    }
 
-        mPointLightSources = component;
-        mPointLightSourcesCount += 1;
+    void RenderSystem::registerComponent(StaticMeshComponent *component)
+    {
+        registerIn(mStaticMeshes, component);
     }
 
-    void RenderSystem::registerComponent(DirectionalLightComponent *component)
+    void RenderSystem::unregisterComponent(SpotLightComponent *component)
     {
-        if (component->mPrev || component->mNext)
-        {
-            FAIL(false, "An attempt to pass registered component [name: '%s']", component->getName());
-            return;
-        }
+        unregisterIn(mSpotLightSources, component);
+    }
 
-        if (mDirLightSources)
-        {
-            component->mNext = mDirLightSources;
-            mDirLightSources->mPrev = component;
-        }
+    void RenderSystem::unregisterComponent(PointLightComponent *component)
+    {
+        unregisterIn(mPointLightSources, component);
+    }
 
-        mDirLightSources = component;
-        mDirLightSourcesCount += 1;
+    void RenderSystem::unregisterComponent(DirectionalLightComponent *component)
+    {
+        unregisterIn(mDirLightSources, component);
     }
 
-    void RenderSystem::registerComponent(StaticMeshComponent *component)
+    void RenderSystem::unregisterComponent(StaticMeshComponent *component)
     {
-        if (component->mPrev || component->mNext)
+        unregisterIn(mStaticMeshes, component);
+    }
+
+    template <typename T>
+    void RenderSystem::registerIn(SlotMap<T*> &registry, T *component)
+    {
+        if (component->mRenderHandle.isValid())
         {
             FAIL(false, "An attempt to pass registered component [name: '%s']", component->getName());
             return;
         }
 
-        if (mStaticMeshes)
+        component->mRenderHandle = registry.add(component);
+    }
+
+    template <typename T>
+    void RenderSystem::unregisterIn(SlotMap<T*> &registry, T *component)
+    {
+        if (!registry.remove(component->mRenderHandle))
         {
-            component->mNext = mStaticMeshes;
-            mStaticMeshes->mPrev = component;
+            FAIL(false, "An attempt to pass not registered component [name: '%s']", component->getName());
+            return;
         }
 
-        mStaticMeshes = component;
-        mStaticMeshesCount += 1;
+        component->mRenderHandle = SlotHandle();
     }
 
 } // namespace Berserk::Render
\ No newline at end of file
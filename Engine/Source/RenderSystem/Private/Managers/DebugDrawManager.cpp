@@ -3,17 +3,14 @@
 //
 
 #include "Managers/DebugDrawManager.h"
+#include "Logging/LogMacros.h"
 
 namespace Berserk::Render
 {
 
     DebugDrawManager::DebugDrawManager(IAllocator *allocator)
-            : mQueue1(INITIAL_PRIMITIVES_MAX_COUNT, allocator),
-              mQueue2(INITIAL_PRIMITIVES_MAX_COUNT, allocator)
+            : mRequests(REQUESTS_BUFFER_SIZE, allocator)
     {
-        mCurrentRender = &mQueue1;
-        mCurrentSubmit = &mQueue2;
-
         PUSH("DebugDrawManager: initialize");
     }
 
@@ -24,54 +21,125 @@ namespace Berserk::Render
 
     void DebugDrawManager::update()
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        // Requests of the previous frame are rendered: free their memory
+        // and take everything submitted since the previous update
+        mRequests.release(mFrameEnd);
+
+        mFrameBegin = mFrameEnd;
+        mFrameEnd = mRequests.getWritePosition();
+        mIterator = mFrameBegin;
+    }
+
+    const DebugDrawManager::DrawRequest* DebugDrawManager::iterate()
+    {
+        mIterator = mFrameBegin;
+        return next();
+    }
+
+    const DebugDrawManager::DrawRequest* DebugDrawManager::next()
+    {
+        if (mIterator >= mFrameEnd) return nullptr;
+
+        uint32 size, tag;
+        return (const DrawRequest*) mRequests.read(mIterator, size, tag);
+    }
+
+    template <typename T>
+    T* DebugDrawManager::beginRequest(DrawRequestType type, const Color &color, bool depthTest, uint32 extraSize)
+    {
+        auto memory = mRequests.beginWrite((uint32) sizeof(T) + extraSize, type);
+
+        if (memory == nullptr)
+        {
+            mDroppedRequests += 1;
+            return nullptr;
+        }
+
+        auto request = new (memory) T();
+        request->mType = type;
+        request->mDepthTest = depthTest;
+        request->mColor = color;
+
+        return request;
+    }
 
-        // Swap submit and render queues
-        auto tmp = mCurrentSubmit;
-        mCurrentSubmit = mCurrentRender;
-        mCurrentRender = tmp;
+    void DebugDrawManager::endRequest()
+    {
+        mRequests.endWrite();
     }
 
     void DebugDrawManager::submit(const AABB &box, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        auto request = beginRequest<DrawRequestAABB>(eDRT_AABB, color, depthTest);
+        if (request == nullptr) return;
 
+        request->mAABB = box;
+        endRequest();
     }
 
     void DebugDrawManager::submit(const Sphere &sphere, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        auto request = beginRequest<DrawRequestSphere>(eDRT_SPHERE, color, depthTest);
+        if (request == nullptr) return;
 
+        request->mSphere = sphere;
+        endRequest();
     }
 
     void DebugDrawManager::submit(const Point &position, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        auto request = beginRequest<DrawRequestBasis>(eDRT_BASIS, color, depthTest);
+        if (request == nullptr) return;
 
+        request->mPosition = position;
+        endRequest();
     }
 
     void DebugDrawManager::submit(const Mat4x4f &transformation, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        auto request = beginRequest<DrawRequestOrientedBasis>(eDRT_ORIENTED_BASIS, color, depthTest);
+        if (request == nullptr) return;
 
+        request->mTransformation = transformation;
+        endRequest();
     }
 
     void DebugDrawManager::submit(const Point &start, const Point &end, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        auto request = beginRequest<DrawRequestLine>(eDRT_LINE, color, depthTest);
+        if (request == nullptr) return;
 
+        request->mLineStart = start;
+        request->mLineEnd = end;
+        endRequest();
     }
 
     void DebugDrawManager::submit(const Point &A, const Point &B, const Point &C, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        auto request = beginRequest<DrawRequestTriangle>(eDRT_TRIANGLE, color, depthTest);
+        if (request == nullptr) return;
 
+        request->mTriangleA = A;
+        request->mTriangleB = B;
+        request->mTriangleC = C;
+        endRequest();
     }
 
     void DebugDrawManager::submit(const Point &position, const char *text, const Color &color, bool depthTest)
     {
-        std::lock_guard<std::mutex> lock(mMutex);
+        // Text is copied in the buffer right after the request
+        uint32 length = (uint32) strnlen(text, MAX_TEXT_LENGTH - 1);
+
+        auto request = beginRequest<DrawRequestText>(eDRT_TEXT, color, depthTest, length + 1);
+        if (request == nullptr) return;
+
+        request->mPosition = position;
+
+        auto string = (char*) (request + 1);
+        memcpy(string, text, length);
+        string[length] = '\0';
 
+        endRequest();
     }
 
     const DebugDrawManager::Color DebugDrawManager::WHITE = Color(1.0f, 1.0f, 1.0f);
@@ -52,6 +52,14 @@ namespace Berserk::Resources
 #endif
 
         auto renamed = dynamic_cast<Material*>(material);
+
+        if (!mMaterialsMap.add(CText(name), renamed))
+        {
+            WARNING("MaterialManager: material already exist [name: '%s']", name);
+            return;
+        }
+
+        mMaterialsMap.removeIf(CText(renamed->getName()), [renamed](Material*& found) { return found == renamed; });
         renamed->mResourceName = name;
     }
 
@@ -63,59 +71,69 @@ namespace Berserk::Resources
     void MaterialManager::deleteMaterial(IMaterial *material)
     {
         CText name(material->getName());
-        material->release();
+        auto target = (Material*) material;
+
+        auto deleted = mMaterialsMap.removeIf(name, [target](Material*& found)
+        {
+            if (found != target) return false;
+
+            found->release();
+            return found->getReferenceCount() == 0;
+        });
 
-        if (material->getReferenceCount() == 0)
+        if (deleted)
         {
 #if PROFILE_MATERIAL_MANAGER
             PUSH("MaterialManager: delete material [name: '%s']", name.get());
 #endif
-            mMaterials.remove((Material*)material);
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mMaterials.remove(target);
         }
     }
 
     IMaterial* MaterialManager::createMaterial(const char *name)
     {
-        IMaterial* found = findMaterial(name);
+        bool created = false;
+
+        auto material = mMaterialsMap.getOrInsert(CText(name), [&]() -> Material*
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+
+            auto resource = new(mMaterials.preallocate()) Material(name, mTextureManager);
+            resource->addReference();
 
-        if (found)
+            created = true;
+            return resource;
+        });
+
+        if (!created)
         {
             WARNING("MaterialManager: material already exist [name: '%s']", name);
             return nullptr;
         }
 
-        auto material = new(mMaterials.preallocate()) Material(name, mTextureManager);
-
-        {
-            material->addReference();
 #if PROFILE_MATERIAL_MANAGER
-            PUSH("MaterialManager: create material [name: '%s'][ref: %u]", material->getName(), material->getReferenceCount());
+        PUSH("MaterialManager: create material [name: '%s'][ref: %u]", material->getName(), material->getReferenceCount());
 #endif
-        }
 
         return material;
     }
 
     IMaterial* MaterialManager::findMaterial(const char *name)
     {
-        for (auto current = mMaterials.iterate(); current != nullptr; current = mMaterials.next())
-        {
-            if (current->mResourceName == name)
-            {
-                return current;
-            }
-        }
+        Material* found = nullptr;
+        mMaterialsMap.find(CText(name), found);
 
-        return nullptr;
+        return found;
     }
 
     IMaterial* MaterialManager::getMaterial(const char *name)
     {
-        IMaterial* found = findMaterial(name);
+        Material* found = nullptr;
 
-        if (found)
+        if (mMaterialsMap.find(CText(name), found, [](Material*& material) { material->addReference(); }))
         {
-            found->addReference();
 #if PROFILE_MATERIAL_MANAGER
             PUSH("MaterialManager: find material [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -145,11 +163,10 @@ namespace Berserk::Resources
     {
         if (name != nullptr)
         {
-            auto found = findMaterial(name);
+            Material* found = nullptr;
 
-            if (found)
+            if (mMaterialsMap.find(CText(name), found, [](Material*& material) { material->addReference(); }))
             {
-                found->addReference();
 #if PROFILE_MATERIAL_MANAGER
                 PUSH("MaterialManager: find material [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
 #endif
@@ -159,32 +176,20 @@ namespace Berserk::Resources
 
         const char* matname = node.getAttribute("name").getValue();
 
+        auto material = mMaterialsMap.getOrInsert(CText(matname), [&]()
         {
-            auto found = findMaterial(matname);
-
-            if (found)
-            {
-                found->addReference();
-#if PROFILE_MATERIAL_MANAGER
-                PUSH("MaterialManager: find material [name: '%s'][ref: %u]", found->getName(), found->getReferenceCount());
-#endif
-                return found;
-            }
-        }
-
-        auto material = new(mMaterials.preallocate()) Material(matname, mTextureManager);
-        auto success = MaterialManagerHelper::import(material, node, mMaterialsPath, mTextureManager);
-
-        if (!success)
+            return importMaterial(matname, node);
+        },
+        [](Material*& found)
         {
-            WARNING("Cannot load material program from xml node [name: '%s']", matname);
+            found->addReference();
+        });
 
-            material->release();
-            mMaterials.remove(material);
+        if (material == nullptr)
+        {
             return getDefaultHelperMaterial();
         }
 
-        material->addReference();
         return material;
     }
 
@@ -214,18 +219,49 @@ namespace Berserk::Resources
 
     uint32 MaterialManager::getMemoryUsage()
     {
-        return sizeof(MaterialManager)    +
-               mMaterials.getMemoryUsage();
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
+        return sizeof(MaterialManager)          +
+               mMaterials.getMemoryUsage()      +
+               mMaterialsMap.getMemoryUsage()   ;
     }
 
     void MaterialManager::getMemoryUsage(MemorySizer *sizer)
     {
         auto root = sizer->addObject("MaterialManager", getMemoryUsage());
 
+        std::lock_guard<std::mutex> guard(mStorageMutex);
+
         for (auto current = mMaterials.iterate(); current != nullptr; current = mMaterials.next())
         {
             sizer->addChild(root, current->getName(), current->getMemoryUsage(), current->getGPUMemoryUsage());
         }
     }
 
+    Material* MaterialManager::importMaterial(const char *name, XMLNode &node)
+    {
+        Material* material;
+
+        {
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            material = new(mMaterials.preallocate()) Material(name, mTextureManager);
+        }
+
+        auto success = MaterialManagerHelper::import(material, node, mMaterialsPath, mTextureManager);
+
+        if (!success)
+        {
+            WARNING("Cannot load material program from xml node [name: '%s']", name);
+
+            material->release();
+
+            std::lock_guard<std::mutex> guard(mStorageMutex);
+            mMaterials.remove(material);
+            return nullptr;
+        }
+
+        material->addReference();
+        return material;
+    }
+
 } // namespace Berserk::Resources
\ No newline at end of file
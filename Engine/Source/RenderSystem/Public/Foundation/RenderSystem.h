@@ -7,6 +7,7 @@
 
 #include <Foundation/IRenderSystem.h>
 #include <Foundation/IPipelineScheduler.h>
+#include <Containers/SlotMap.h>
 
 namespace Berserk::Render
 {
@@ -22,6 +23,9 @@ namespace Berserk::Render
     {
     public:
 
+        /** Max number of bytes of resources data moved by compaction per frame */
+        static const uint32 RESOURCE_HEAP_COMPACTION_BUDGET = Buffers::KiB * 256;
+
         /** Default memory operations */
         GENERATE_CLASS_BODY(RenderSystem);
 
@@ -62,6 +66,28 @@ namespace Berserk::Render
         /** Register a primitive component to be rendered */
         void registerComponent(StaticMeshComponent *component) override;
 
+        /** Remove light source from the rendering */
+        void unregisterComponent(SpotLightComponent *component) override;
+
+        /** Remove light source from the rendering */
+        void unregisterComponent(PointLightComponent *component) override;
+
+        /** Remove light source from the rendering */
+        void unregisterComponent(DirectionalLightComponent *component) override;
+
+        /** Remove primitive component from the rendering */
+        void unregisterComponent(StaticMeshComponent *component) override;
+
+    protected:
+
+        /** Adds component in registry and saves its handle in the component */
+        template <typename T>
+        void registerIn(SlotMap<T*> &registry, T *component);
+
+        /** Removes component from registry and resets its handle */
+        template <typename T>
+        void unregisterIn(SlotMap<T*> &registry, T *component);
+
     protected:
 
         /** Global static region allocator */
@@ -72,31 +98,19 @@ namespace Berserk::Render
 
         ///////////////////// Light Sources info /////////////////////
 
-        /** Registered spot light sources count */
-        uint32 mSpotLightSourcesCount;
-
-        /** Registered point light sources count */
-        uint32 mPointLightSourcesCount;
+        /** Registered spot light sources (packed for iteration) */
+        SlotMap<SpotLightComponent*> mSpotLightSources;
 
-        /** Registered directional light sources count */
-        uint32 mDirLightSourcesCount;
+        /** Registered point light sources (packed for iteration) */
+        SlotMap<PointLightComponent*> mPointLightSources;
 
-        /** Registered spot light sources */
-        SpotLightComponent* mSpotLightSources = nullptr;
-
-        /** Registered point light sources */
-        PointLightComponent* mPointLightSources = nullptr;
-
-        /** Registered directional light sources */
-        DirectionalLightComponent* mDirLightSources = nullptr;
+        /** Registered directional light sources (packed for iteration) */
+        SlotMap<DirectionalLightComponent*> mDirLightSources;
 
         ///////////////////// Geometry data info /////////////////////
 
-        /** Registered static mesh components count */
-        uint32 mStaticMeshesCount;
-
-        /** Registered static mesh components */
-        StaticMeshComponent* mStaticMeshes = nullptr;
+        /** Registered static mesh components (packed for iteration) */
+        SlotMap<StaticMeshComponent*> mStaticMeshes;
 
     };
 
@@ -8,8 +8,8 @@
 #include <Math/MathInclude.h>
 #include <Memory/IAllocator.h>
 #include <Misc/UsageDescriptors.h>
-#include <Containers/ArrayList.h>
-#include <mutex>
+#include <Misc/Buffers.h>
+#include <Threading/SPSCRingBuffer.h>
 
 namespace Berserk::Render
 {
@@ -17,7 +17,9 @@ namespace Berserk::Render
     /**
      * Debug draw manager allows to submit debug primitive to the queue from anywhere
      * in the program code in CURRENT frame to be rendered in the NEXT frame.
-     * Allows to be used in multi-threaded mode (synchronization used).
+     * Requests are passed from submitting thread to render thread via wait-free
+     * ring buffer (without locks and allocations): one thread submits requests,
+     * render thread updates manager and iterates requests.
      *
      * @note Renders in the perspective projection (except text) of the active camera
      * @note Provided primitives: line, triangle, box, basis, 2D text, text, sphere.
@@ -39,10 +41,13 @@ namespace Berserk::Render
         static const Color BLUE;
 
         /**
-         * Initial queue buffers size for submitting draw tasks
-         * (Consider this number of primitives will have significant impact on performance)
+         * Size of ring buffer for requests of two frames: submitted and rendered
+         * (requests which do not fit are dropped)
          */
-        static const uint32 INITIAL_PRIMITIVES_MAX_COUNT = 100;
+        static const uint32 REQUESTS_BUFFER_SIZE = Buffers::KiB * 256;
+
+        /** Max length of submitted text (longer text is truncated) */
+        static const uint32 MAX_TEXT_LENGTH = Buffers::SIZE_256;
 
         /**
          * Types of the primitives, which can be submitted
@@ -56,54 +61,62 @@ namespace Berserk::Render
             eDRT_TRIANGLE    ,
             eDRT_SPHERE      ,
             eDRT_TEXT        ,
+            eDRT_ORIENTED_BASIS,
         };
 
-        /** Stores info about one debug draw primitive (for queue) */
+        /** Common info about one debug draw primitive (header of request in the queue) */
         struct DrawRequest
         {
             DrawRequestType mType;
             bool mDepthTest;
             Color mColor;
+        };
+
+        //! Info for basis
+        struct DrawRequestBasis : public DrawRequest
+        {
+            Point mPosition;
+        };
 
-            union
-            {
-                //! Info for basis
-                struct
-                {
-                    Point mPosition;
-                };
-
-                //! Info for oriented basis
-                struct
-                {
-                    Mat4x4f mTransformation;
-                };
-
-                //! Info for line
-                struct
-                {
-                    Point mLineStart;
-                    Point mLineEnd;
-
-                };
-
-                //! Info for triangle
-                struct
-                {
-                    Point mTriangleA;
-                    Point mTriangleB;
-                    Point mTriangleC;
-                };
-
-                //! Axis aligned bounding box
-                AABB mAABB;
-
-                //! Sphere info
-                Sphere mSphere;
-
-                //! 3D text (fixed size, should be valid for at least 2 frames)
-                char* mStringBuffer;
-            };
+        //! Info for oriented basis
+        struct DrawRequestOrientedBasis : public DrawRequest
+        {
+            Mat4x4f mTransformation;
+        };
+
+        //! Info for line
+        struct DrawRequestLine : public DrawRequest
+        {
+            Point mLineStart;
+            Point mLineEnd;
+        };
+
+        //! Info for triangle
+        struct DrawRequestTriangle : public DrawRequest
+        {
+            Point mTriangleA;
+            Point mTriangleB;
+            Point mTriangleC;
+        };
+
+        //! Axis aligned bounding box
+        struct DrawRequestAABB : public DrawRequest
+        {
+            AABB mAABB;
+        };
+
+        //! Sphere info
+        struct DrawRequestSphere : public DrawRequest
+        {
+            Sphere mSphere;
+        };
+
+        //! 3D text (null-terminated string is stored right after request)
+        struct DrawRequestText : public DrawRequest
+        {
+            Point mPosition;
+
+            const char* getText() const { return (const char*) (this + 1); }
         };
 
     public:
@@ -135,25 +148,50 @@ namespace Berserk::Render
         /** Add text to the debug draw queue [for next frame] */
         void submit(const Point& position, const char* text, const Color& color, bool depthTest = true);
 
-        /** Swaps current render and submit buffers */
+        /**
+         * Releases requests of the rendered frame and takes all the
+         * submitted requests for rendering (render thread only)
+         */
         void update();
 
+        /** @return First request to render in the current frame [or nullptr] (render thread only) */
+        const DrawRequest* iterate();
+
+        /** @return Next request to render in the current frame [or nullptr] (render thread only) */
+        const DrawRequest* next();
+
+        /** @return Number of requests, dropped because of buffer overflow */
+        uint32 getDroppedRequestsCount() const { return mDroppedRequests; }
+
+    protected:
+
+        /**
+         * Reserves request in the buffer and fills its common info
+         * @param extraSize Size of data after request
+         * @return Request to fill [or nullptr if buffer is full]
+         */
+        template <typename T>
+        T* beginRequest(DrawRequestType type, const Color& color, bool depthTest, uint32 extraSize = 0);
+
+        /** Publishes request, reserved by beginRequest */
+        void endRequest();
+
     protected:
 
-        /** For synchronization */
-        std::mutex mMutex;
+        /** Submitted and rendered requests (records tagged with request type) */
+        SPSCRingBuffer mRequests;
 
-        /** Data buffer 1 [will be swapped with 2] */
-        ArrayList<DrawRequest> mQueue1;
+        /** Position of the first request of the rendered frame */
+        uint64 mFrameBegin = 0;
 
-        /** Data buffer 2 [will be swapped with 1] */
-        ArrayList<DrawRequest> mQueue2;
+        /** Position after the last request of the rendered frame */
+        uint64 mFrameEnd = 0;
 
-        /** List which contains data to be rendered in the current frame */
-        ArrayList<DrawRequest>* mCurrentRender;
+        /** Position of the next request in iteration */
+        uint64 mIterator = 0;
 
-        /** List which allows to submit data to be rendered in the next frame */
-        ArrayList<DrawRequest>* mCurrentSubmit;
+        /** Number of dropped requests (written by submitting thread) */
+        uint32 mDroppedRequests = 0;
 
     };
 
@@ -5,9 +5,12 @@
 #ifndef BERSERK_MATERIALMANAGER_H
 #define BERSERK_MATERIALMANAGER_H
 
+#include <mutex>
 #include <Containers/LinkedList.h>
 #include <Managers/IMaterialManager.h>
 #include <Foundation/Material.h>
+#include <Threading/ConcurrentHashMap.h>
+#include <Strings/StaticString.h>
 
 namespace Berserk::Resources
 {
@@ -16,6 +19,10 @@ namespace Berserk::Resources
     #define PROFILE_MATERIAL_MANAGER 0
 #endif
 
+    /**
+     * Lookup and loading of materials by name are thread-safe: concurrent
+     * loads of the same material import it once (the others wait for it)
+     */
     class ENGINE_API MaterialManager : public IMaterialManager
     {
     public:
@@ -75,12 +82,23 @@ namespace Berserk::Resources
         /** @copydoc IMaterialManager::getMemoryUsage() */
         void getMemoryUsage(MemorySizer* sizer) override;
 
+    private:
+
+        /** @return Material imported from xml node in storage [or nullptr if failed to import] */
+        Material* importMaterial(const char* name, XMLNode& node);
+
     private:
 
         static const uint32 INITIAL_MATERIALS_COUNT = 64;
 
+        /** Guards storage of resources (list is not thread-safe) */
+        std::mutex mStorageMutex;
+
         LinkedList<Material> mMaterials;
 
+        /** Resources lookup by name */
+        ConcurrentHashMap<CText, Material*> mMaterialsMap;
+
         IMaterial* mDefaultMaterial;
         IMaterial* mDefaultHelperMaterial;
         IMaterial* mDefaultTerrainMaterial;